@@ -0,0 +1,79 @@
+/*
+// Матрица политик балансировки map<int, int>: red-black, AVL и splay на разных нагрузках.
+//		insert random  -- n вставок случайных ключей
+//		insert sorted  -- n вставок по возрастанию
+//		find uniform   -- n поисков равномерно случайных ключей
+//		find skewed    -- n поисков: 90% из горячего 1% ключей
+//		churn          -- n пар erase + insert случайных ключей
+//		scan           -- полный обход итератором
+//		./balance_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef std::allocator<ft::pair<const int, int> > alloc_type;
+typedef ft::map<int, int> rb_map;
+typedef ft::map<int, int, std::less<int>, alloc_type, ft::null_node_update, ft::avl_balance> avl_map;
+typedef ft::map<int, int, std::less<int>, alloc_type, ft::null_node_update, ft::splay_balance> splay_map;
+
+template<typename Map>
+static void run(const char* name, size_t n) {
+	std::string title(name);
+	int range = static_cast<int>(n * 2);
+	bench::Random rnd;
+	std::vector<int> keys(n);
+	for (size_t i = 0; i < n; ++i) {
+		keys[i] = rnd.next_int(range);
+	}
+	long sum = 0;
+	Map m;
+	bench::Timer t;
+	for (size_t i = 0; i < n; ++i) {
+		m[keys[i]] = static_cast<int>(i);
+	}
+	bench::report((title + " insert random").c_str(), n, n, t.elapsed_ns());
+	{
+		Map sorted;
+		t.reset();
+		for (size_t i = 0; i < n; ++i) {
+			sorted[static_cast<int>(i)] = static_cast<int>(i);
+		}
+		bench::report((title + " insert sorted").c_str(), n, n, t.elapsed_ns());
+		sum += static_cast<long>(sorted.size());
+	}
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		sum += (m.find(keys[rnd.next_int(static_cast<int>(n))]) != m.end());
+	}
+	bench::report((title + " find uniform").c_str(), n, n, t.elapsed_ns());
+	size_t hot = n / 100 + 1;
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		size_t k = (rnd.next_int(10) != 0 ? rnd.next_int(static_cast<int>(hot)) : rnd.next_int(static_cast<int>(n)));
+		sum += (m.find(keys[k]) != m.end());
+	}
+	bench::report((title + " find skewed").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		m.erase(keys[rnd.next_int(static_cast<int>(n))]);
+		m[rnd.next_int(range)] = static_cast<int>(i);
+	}
+	bench::report((title + " churn").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+		sum += it->second;
+	}
+	bench::report((title + " scan").c_str(), n, m.size(), t.elapsed_ns());
+	bench::sink = sum;
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run<rb_map>("red-black", n);
+	run<avl_map>("avl", n);
+	run<splay_map>("splay", n);
+	return 0;
+}
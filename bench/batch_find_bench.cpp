@@ -0,0 +1,53 @@
+/*
+// Пакетный поиск в map<int, int>, который намного больше кэша последнего уровня:
+// цикл find против find_batch на пачках по 64, 256 и 512 случайных ключей
+// (половина ключей отсутствует).
+//		./batch_find_bench [n]
+*/
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int> int_map;
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 4000000);
+	int_map m;
+	bench::Random rnd;
+	for (size_t i = 0; i < n; ++i) {
+		m[rnd.next_int(static_cast<int>(n * 2))] = static_cast<int>(i);
+	}
+	size_t lookups = 4000000;
+	std::vector<int> keys(lookups);
+	for (size_t i = 0; i < lookups; ++i) {
+		keys[i] = rnd.next_int(static_cast<int>(n * 2));
+	}
+	size_t batches[] = { 64, 256, 512 };
+	long sum = 0;
+	for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); ++b) {
+		size_t batch = batches[b];
+		char name[64];
+		std::vector<int_map::iterator> out(batch, m.end());
+		bench::Timer t;
+		for (size_t i = 0; i + batch <= lookups; i += batch) {
+			for (size_t j = 0; j < batch; ++j) {
+				out[j] = m.find(keys[i + j]);
+			}
+			sum += (out[batch - 1] != m.end());
+		}
+		std::sprintf(name, "batch %lu find loop", static_cast<unsigned long>(batch));
+		bench::report(name, n, lookups, t.elapsed_ns());
+		t.reset();
+		for (size_t i = 0; i + batch <= lookups; i += batch) {
+			m.find_batch(keys.begin() + i, keys.begin() + i + batch, out.begin());
+			sum += (out[batch - 1] != m.end());
+		}
+		std::sprintf(name, "batch %lu find_batch", static_cast<unsigned long>(batch));
+		bench::report(name, n, lookups, t.elapsed_ns());
+	}
+	bench::sink = sum;
+	return 0;
+}
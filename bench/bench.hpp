@@ -0,0 +1,67 @@
+/*
+// Общие утилиты для бенчмарков: таймер, псевдослучайный генератор
+// и печать результатов в едином формате.
+// Бенчмарки собираются командой make bench.
+*/
+
+#ifndef BENCH_HPP
+# define BENCH_HPP
+
+# include <sys/time.h>
+# include <cstdio>
+# include <cstdlib>
+
+namespace bench {
+
+	class Timer {
+		private:
+			double start_;
+
+			static double now() {
+				struct timeval tv;
+				gettimeofday(&tv, NULL);
+				return tv.tv_sec * 1e9 + tv.tv_usec * 1e3;
+			}
+
+		public:
+			Timer() : start_(now()) {}
+
+			void reset() { start_ = now(); }
+			double elapsed_ns() const { return now() - start_; }
+	};
+
+	// xorshift: rand() слишком медленный и даёт только 31 бит
+	class Random {
+		private:
+			unsigned long long state_;
+
+		public:
+			explicit Random(unsigned long long seed = 88172645463325252ULL) : state_(seed ? seed : 1) {}
+
+			unsigned long long next() {
+				state_ ^= state_ << 13;
+				state_ ^= state_ >> 7;
+				state_ ^= state_ << 17;
+				return state_;
+			}
+
+			int next_int(int bound) { return static_cast<int>(next() % static_cast<unsigned long long>(bound)); }
+	};
+
+	inline void report(const char* name, size_t n, size_t ops, double ns) {
+		std::printf("%-40s n=%-10lu %10.1f ns/op\n", name, static_cast<unsigned long>(n), ns / ops);
+	}
+
+	inline size_t arg_size(int argc, char** argv, size_t def) {
+		if (argc > 1) {
+			return static_cast<size_t>(std::atol(argv[1]));
+		}
+		return def;
+	}
+
+	// не даёт компилятору выбросить результат измеряемого цикла
+	static volatile long sink;
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,50 @@
+/*
+// lower_bound / upper_bound / equal_range на ft::map и std::map.
+// Время одного поиска должно расти как log(n): при увеличении n в 10 раз
+// добавляется константа, а колонка ns/log2(n) остаётся примерно постоянной.
+//		./bound_bench [max_n]
+*/
+
+#include <map>
+#include <cmath>
+#include "map.hpp"
+#include "bench.hpp"
+
+#define QUERIES 200000
+
+template<typename Map>
+void run(const char* name, size_t n) {
+	Map m;
+	for (size_t i = 0; i < n; ++i) {
+		m.insert(typename Map::value_type(static_cast<int>(i * 2), static_cast<int>(i)));
+	}
+	const Map& cm = m;
+	bench::Random rnd;
+	long sum = 0;
+	bench::Timer t;
+	for (int i = 0; i < QUERIES; ++i) {
+		int key = rnd.next_int(static_cast<int>(n * 2));
+		typename Map::const_iterator lo = cm.lower_bound(key);
+		typename Map::const_iterator hi = cm.upper_bound(key);
+		if (lo != cm.end()) {
+			sum += lo->second;
+		}
+		if (hi != cm.end()) {
+			sum += hi->second;
+		}
+		sum += (cm.equal_range(key).first == lo);
+	}
+	double ns = t.elapsed_ns();
+	bench::sink = sum;
+	std::printf("%-20s n=%-10lu %8.1f ns/query %8.2f ns/log2(n)\n", name,
+			static_cast<unsigned long>(n), ns / QUERIES, ns / QUERIES / std::log(static_cast<double>(n)) * std::log(2.0));
+}
+
+int main(int argc, char** argv) {
+	size_t max_n = bench::arg_size(argc, argv, 1000000);
+	for (size_t n = 1000; n <= max_n; n *= 10) {
+		run<ft::map<int, int> >("ft::map", n);
+		run<std::map<int, int> >("std::map", n);
+	}
+	return 0;
+}
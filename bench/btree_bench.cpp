@@ -0,0 +1,78 @@
+/*
+// map<int, int> на красно-черном дереве против btree_map<int, int> (B+-дерево, узел 256 байт).
+//		insert          -- n вставок в случайном порядке
+//		insert sorted   -- n вставок по возрастанию с подсказкой end()
+//		find            -- n поисков случайных ключей (половина -- промахи)
+//		lower_bound     -- n вызовов lower_bound со случайным ключом
+//		scan            -- полный обход итератором
+//		erase           -- удаление всех элементов по ключу в случайном порядке
+//		./btree_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "btree_map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int> rb_map;
+typedef ft::btree_map<int, int> btree_map;
+
+template<typename Map>
+static void run(const char* name, size_t n) {
+	std::string title(name);
+	int range = static_cast<int>(n * 2);
+	std::vector<int> keys(n);
+	bench::Random rnd;
+	for (size_t i = 0; i < n; ++i) {
+		keys[i] = rnd.next_int(range);
+	}
+	long sum = 0;
+	Map m;
+	bench::Timer t;
+	for (size_t i = 0; i < n; ++i) {
+		m[keys[i]] = static_cast<int>(i);
+	}
+	bench::report((title + " insert").c_str(), n, n, t.elapsed_ns());
+	{
+		Map sorted;
+		t.reset();
+		for (size_t i = 0; i < n; ++i) {
+			sorted.insert(sorted.end(), ft::make_pair(static_cast<int>(i), static_cast<int>(i)));
+		}
+		bench::report((title + " insert sorted").c_str(), n, n, t.elapsed_ns());
+		sum += static_cast<long>(sorted.size());
+	}
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		sum += (m.find(rnd.next_int(range)) != m.end());
+	}
+	bench::report((title + " find").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		typename Map::iterator it = m.lower_bound(rnd.next_int(range));
+		if (it != m.end()) {
+			sum += it->second;
+		}
+	}
+	bench::report((title + " lower_bound").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+		sum += it->second;
+	}
+	bench::report((title + " scan").c_str(), n, m.size(), t.elapsed_ns());
+	size_t size = m.size();
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		m.erase(keys[i]);
+	}
+	bench::report((title + " erase").c_str(), n, size, t.elapsed_ns());
+	bench::sink = sum;
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run<rb_map>("map", n);
+	run<btree_map>("btree_map", n);
+	return 0;
+}
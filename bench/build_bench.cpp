@@ -0,0 +1,55 @@
+/*
+// Построение map из диапазона: отсортированный вход собирается за O(n),
+// неотсортированный вставляется поэлементно. Для сравнения -- std::map
+// и ft::map, заполняемый циклом insert().
+//		./build_bench [n]
+*/
+
+#include <map>
+#include <vector>
+#include <algorithm>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef std::vector<ft::pair<int, int> >	ft_input;
+typedef std::vector<std::pair<int, int> >	std_input;
+
+template<typename Map, typename Input>
+void run_range(const char* label, const Input& in) {
+	bench::Timer t;
+	Map m(in.begin(), in.end());
+	bench::report(label, in.size(), in.size(), t.elapsed_ns());
+	bench::sink = static_cast<long>(m.size());
+}
+
+template<typename Map, typename Input>
+void run_loop(const char* label, const Input& in) {
+	bench::Timer t;
+	Map m;
+	for (typename Input::const_iterator it = in.begin(); it != in.end(); ++it) {
+		m.insert(*it);
+	}
+	bench::report(label, in.size(), in.size(), t.elapsed_ns());
+	bench::sink = static_cast<long>(m.size());
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	ft_input ft_sorted;
+	std_input std_sorted;
+	for (size_t i = 0; i < n; ++i) {
+		ft_sorted.push_back(ft::make_pair(static_cast<int>(i * 2), static_cast<int>(i)));
+		std_sorted.push_back(std::make_pair(static_cast<int>(i * 2), static_cast<int>(i)));
+	}
+	ft_input ft_shuffled(ft_sorted);
+	std_input std_shuffled(std_sorted);
+	std::random_shuffle(ft_shuffled.begin(), ft_shuffled.end());
+	std::random_shuffle(std_shuffled.begin(), std_shuffled.end());
+
+	run_range<ft::map<int, int> >("ft::map range sorted", ft_sorted);
+	run_loop<ft::map<int, int> >("ft::map insert loop sorted", ft_sorted);
+	run_range<std::map<int, int> >("std::map range sorted", std_sorted);
+	run_range<ft::map<int, int> >("ft::map range shuffled", ft_shuffled);
+	run_range<std::map<int, int> >("std::map range shuffled", std_shuffled);
+	return 0;
+}
@@ -0,0 +1,62 @@
+/*
+// Счетчики: m[key] += 1, почти всегда по уже существующему ключу.
+//		int -> long          -- m[key] += 1 по n ключам, 10 * n обращений
+//		string -> long       -- то же с ключами std::string
+//		try_emplace          -- вставка, если ключа нет, без копирования значения
+//		./counter_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "bench.hpp"
+
+static std::string make_key(int i) {
+	char buf[64];
+	std::sprintf(buf, "counter:%012d", i);
+	return std::string(buf);
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 100000);
+	size_t ops = n * 10;
+	bench::Random rnd;
+	long sum = 0;
+	{
+		ft::map<int, long> m;
+		for (size_t i = 0; i < n; ++i) {
+			m[static_cast<int>(i)] = 0;
+		}
+		bench::Timer t;
+		for (size_t i = 0; i < ops; ++i) {
+			m[rnd.next_int(static_cast<int>(n))] += 1;
+		}
+		bench::report("int -> long m[key] += 1", n, ops, t.elapsed_ns());
+		sum += m[0];
+	}
+	{
+		ft::map<std::string, long> m;
+		std::vector<std::string> keys;
+		for (size_t i = 0; i < n; ++i) {
+			keys.push_back(make_key(static_cast<int>(i)));
+			m[keys.back()] = 0;
+		}
+		bench::Timer t;
+		for (size_t i = 0; i < ops; ++i) {
+			m[keys[rnd.next_int(static_cast<int>(n))]] += 1;
+		}
+		bench::report("string -> long m[key] += 1", n, ops, t.elapsed_ns());
+		sum += m[keys[0]];
+	}
+	{
+		ft::map<int, std::string> m;
+		std::string payload(256, 'x');
+		bench::Timer t;
+		for (size_t i = 0; i < ops; ++i) {
+			sum += m.try_emplace(rnd.next_int(static_cast<int>(n)), payload).second;
+		}
+		bench::report("int -> string try_emplace", n, ops, t.elapsed_ns());
+	}
+	bench::sink = sum;
+	return 0;
+}
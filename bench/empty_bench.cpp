@@ -0,0 +1,48 @@
+/*
+// Пустые контейнеры: конструирование, копирование и разрушение без обращений к куче.
+//		vector<map>(n)      -- n копий пустого map внутри ft::vector
+//		construct/destroy   -- map и set по умолчанию в цикле
+//		swap empty          -- swap двух пустых map
+//		./empty_bench [n]
+*/
+
+#include "map.hpp"
+#include "set.hpp"
+#include "vector.hpp"
+#include "bench.hpp"
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	long sum = 0;
+	{
+		bench::Timer t;
+		ft::vector<ft::map<int, int> > maps(n);
+		sum += static_cast<long>(maps.size());
+		bench::report("vector<map>(n)", n, n, t.elapsed_ns());
+		t.reset();
+		maps.clear();
+		bench::report("vector<map> clear", n, n, t.elapsed_ns());
+	}
+	{
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			ft::map<int, int> m;
+			ft::set<int> s;
+			sum += static_cast<long>(m.size() + s.size());
+		}
+		bench::report("map + set construct/destroy", n, n, t.elapsed_ns());
+	}
+	{
+		ft::map<int, int> a;
+		ft::map<int, int> b;
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			a.swap(b);
+			ft::map<int, int> c(a);
+			sum += static_cast<long>(c.size());
+		}
+		bench::report("swap + copy empty map", n, n, t.elapsed_ns());
+	}
+	bench::sink = sum;
+	return 0;
+}
@@ -0,0 +1,73 @@
+/*
+// Удаление из ft::map и std::map:
+//		evict oldest -- erase(begin()) до опустошения (TTL-вытеснение)
+//		erase(find(key)) -- удаление по найденному итератору
+//		erase(key) -- удаление по ключу
+//		erase(first, last) -- диапазон в середине контейнера
+//		./erase_bench [n]
+*/
+
+#include <map>
+#include "map.hpp"
+#include "bench.hpp"
+
+template<typename Map>
+void fill(Map& m, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		m.insert(m.end(), typename Map::value_type(static_cast<int>(i), static_cast<int>(i)));
+	}
+}
+
+template<typename Map>
+void run(const char* name, size_t n) {
+	char label[64];
+	bench::Random rnd;
+	{
+		Map m;
+		fill(m, n);
+		bench::Timer t;
+		while (!m.empty()) {
+			m.erase(m.begin());
+		}
+		std::sprintf(label, "%s evict oldest", name);
+		bench::report(label, n, n, t.elapsed_ns());
+	}
+	{
+		Map m;
+		fill(m, n);
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			typename Map::iterator it = m.find(rnd.next_int(static_cast<int>(n)));
+			if (it != m.end()) {
+				m.erase(it);
+			}
+		}
+		std::sprintf(label, "%s erase(find(key))", name);
+		bench::report(label, n, n, t.elapsed_ns());
+	}
+	{
+		Map m;
+		fill(m, n);
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			m.erase(rnd.next_int(static_cast<int>(n)));
+		}
+		std::sprintf(label, "%s erase(key)", name);
+		bench::report(label, n, n, t.elapsed_ns());
+	}
+	{
+		Map m;
+		fill(m, n);
+		bench::Timer t;
+		m.erase(m.find(static_cast<int>(n / 4)), m.find(static_cast<int>(n / 4 * 3)));
+		std::sprintf(label, "%s erase(first, last)", name);
+		bench::report(label, n, n / 2, t.elapsed_ns());
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run<ft::map<int, int> >("ft::map", n);
+	run<std::map<int, int> >("std::map", n);
+	return 0;
+}
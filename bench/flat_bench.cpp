@@ -0,0 +1,97 @@
+/*
+// map<int, int> (красно-черное дерево), btree_map<int, int> (B+-дерево) и flat_map<int, int>
+// (отсортированный вектор).
+//		build           -- конструктор от n случайных пар (с повторами ключей)
+//		build sorted    -- конструктор от n пар по возрастанию
+//		find            -- n поисков случайных ключей (половина -- промахи)
+//		lower_bound     -- n вызовов lower_bound со случайным ключом
+//		scan            -- полный обход итератором
+//		insert batch    -- insert(first, last) пачки из n / 10 новых случайных пар
+//		insert single   -- та же пачка по одной паре (у flat_map -- только n / 100,
+//		                   каждая вставка сдвигает хвост массива)
+//		./flat_bench [n]
+*/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "btree_map.hpp"
+#include "flat_map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int> rb_map;
+typedef ft::btree_map<int, int> btree_map;
+typedef ft::flat_map<int, int> flat_map;
+typedef std::vector<ft::pair<int, int> > pairs;
+
+static pairs random_pairs(bench::Random& rnd, size_t n, int range) {
+	pairs v(n);
+	for (size_t i = 0; i < n; ++i) {
+		v[i] = ft::make_pair(rnd.next_int(range), static_cast<int>(i));
+	}
+	return v;
+}
+
+template<typename Map>
+static void run(const char* name, size_t n, size_t single) {
+	std::string title(name);
+	int range = static_cast<int>(n * 2);
+	bench::Random rnd;
+	pairs input = random_pairs(rnd, n, range);
+	long sum = 0;
+	bench::Timer t;
+	Map m(input.begin(), input.end());
+	bench::report((title + " build").c_str(), n, n, t.elapsed_ns());
+	{
+		pairs sorted(n);
+		for (size_t i = 0; i < n; ++i) {
+			sorted[i] = ft::make_pair(static_cast<int>(i), static_cast<int>(i));
+		}
+		t.reset();
+		Map s(sorted.begin(), sorted.end());
+		bench::report((title + " build sorted").c_str(), n, n, t.elapsed_ns());
+		sum += static_cast<long>(s.size());
+	}
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		sum += (m.find(rnd.next_int(range)) != m.end());
+	}
+	bench::report((title + " find").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		typename Map::iterator it = m.lower_bound(rnd.next_int(range));
+		if (it != m.end()) {
+			sum += it->second;
+		}
+	}
+	bench::report((title + " lower_bound").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+		sum += it->second;
+	}
+	bench::report((title + " scan").c_str(), n, m.size(), t.elapsed_ns());
+	pairs batch = random_pairs(rnd, n / 10, range);
+	{
+		Map copy(m);
+		t.reset();
+		copy.insert(batch.begin(), batch.end());
+		bench::report((title + " insert batch").c_str(), n, batch.size(), t.elapsed_ns());
+		sum += static_cast<long>(copy.size());
+	}
+	single = std::min(single, batch.size());
+	t.reset();
+	for (size_t i = 0; i < single; ++i) {
+		m.insert(batch[i]);
+	}
+	bench::report((title + " insert single").c_str(), n, single, t.elapsed_ns());
+	bench::sink = sum + static_cast<long>(m.size());
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run<rb_map>("map", n, n / 10);
+	run<btree_map>("btree_map", n, n / 10);
+	run<flat_map>("flat_map", n, n / 100);
+	return 0;
+}
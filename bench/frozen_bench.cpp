@@ -0,0 +1,92 @@
+/*
+// Поиск в неизменяемой таблице map<int, int> из n элементов:
+//		map                 -- исходный ft::map (красно-черное дерево)
+//		std::lower_bound    -- двоичный поиск по отсортированному std::vector<ft::pair<int, int> >
+//		frozen_map          -- снимок ft::freeze(map) в раскладке Эйтцингера
+// Операции:
+//		freeze          -- построение снимка (у map -- копия дерева, у вектора -- копирование)
+//		find            -- n поисков случайных ключей (половина -- промахи)
+//		lower_bound     -- n вызовов lower_bound со случайным ключом
+//		scan            -- полный обход по порядку ключей
+//		./frozen_bench [n]
+*/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "frozen_map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int> rb_map;
+typedef ft::frozen_map<int, int> frozen_map;
+typedef std::vector<ft::pair<int, int> > sorted_vector;
+
+struct key_less {
+	bool operator()(const ft::pair<int, int>& x, int k) const { return x.first < k; }
+};
+
+//↓↓↓ обертка с интерфейсом map над отсортированным вектором
+struct sorted_array {
+	typedef sorted_vector::const_iterator const_iterator;
+
+	sorted_vector data;
+
+	explicit sorted_array(const rb_map& m) : data(m.begin(), m.end()) {}
+
+	const_iterator lower_bound(int k) const {
+		return std::lower_bound(data.begin(), data.end(), k, key_less());
+	}
+
+	const_iterator find(int k) const {
+		const_iterator it = lower_bound(k);
+		return (it != data.end() && it->first == k) ? it : data.end();
+	}
+
+	const_iterator begin() const { return data.begin(); }
+	const_iterator end() const { return data.end(); }
+	size_t size() const { return data.size(); }
+};
+
+template<typename Table>
+static void run(const char* name, const rb_map& source, size_t n) {
+	std::string title(name);
+	int range = static_cast<int>(n * 2);
+	bench::Random rnd;
+	long sum = 0;
+	bench::Timer t;
+	const Table table(source);
+	bench::report((title + " freeze").c_str(), n, source.size(), t.elapsed_ns());
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		sum += (table.find(rnd.next_int(range)) != table.end());
+	}
+	bench::report((title + " find").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		typename Table::const_iterator it = table.lower_bound(rnd.next_int(range));
+		if (it != table.end()) {
+			sum += it->second;
+		}
+	}
+	bench::report((title + " lower_bound").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (typename Table::const_iterator it = table.begin(); it != table.end(); ++it) {
+		sum += it->second;
+	}
+	bench::report((title + " scan").c_str(), n, table.size(), t.elapsed_ns());
+	bench::sink = sum;
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	//↓↓↓ n различных четных ключей из [0, 2n): ровно половина случайных запросов -- промахи
+	rb_map source;
+	for (size_t i = 0; i < n; ++i) {
+		source.insert(source.end(), ft::make_pair(static_cast<int>(i * 2), static_cast<int>(i)));
+	}
+	run<rb_map>("map", source, n);
+	run<sorted_array>("std::lower_bound", source, n);
+	run<frozen_map>("frozen_map", source, n);
+	return 0;
+}
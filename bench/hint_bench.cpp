@@ -0,0 +1,63 @@
+/*
+// Вставка с подсказкой insert(hint, value) для ft::map и std::map:
+//		sorted  -- ключи по возрастанию, hint = end()
+//		reverse -- ключи по убыванию, hint = begin()
+//		random  -- случайные ключи, hint = end() (подсказка почти всегда неверна)
+// Для сравнения приведена вставка без подсказки.
+//		./hint_bench [n]
+*/
+
+#include <map>
+#include "map.hpp"
+#include "bench.hpp"
+
+enum Order { order_sorted, order_reverse, order_random };
+
+static int key_at(Order order, size_t i, size_t n, bench::Random& rnd) {
+	if (order == order_sorted) {
+		return static_cast<int>(i);
+	}
+	if (order == order_reverse) {
+		return static_cast<int>(n - i);
+	}
+	return rnd.next_int(static_cast<int>(n * 4));
+}
+
+template<typename Map>
+void run(const char* name, const char* order_name, Order order, bool hinted, size_t n) {
+	char label[64];
+	bench::Random rnd;
+	Map m;
+	bench::Timer t;
+	for (size_t i = 0; i < n; ++i) {
+		typename Map::value_type kv(key_at(order, i, n, rnd), static_cast<int>(i));
+		if (!hinted) {
+			m.insert(kv);
+		} else if (order == order_reverse) {
+			m.insert(m.begin(), kv);
+		} else {
+			m.insert(m.end(), kv);
+		}
+	}
+	double ns = t.elapsed_ns();
+	bench::sink = static_cast<long>(m.size());
+	std::sprintf(label, "%s %s %s", name, order_name, hinted ? "hinted" : "plain");
+	bench::report(label, n, n, ns);
+}
+
+template<typename Map>
+void run_all(const char* name, size_t n) {
+	run<Map>(name, "sorted", order_sorted, true, n);
+	run<Map>(name, "sorted", order_sorted, false, n);
+	run<Map>(name, "reverse", order_reverse, true, n);
+	run<Map>(name, "reverse", order_reverse, false, n);
+	run<Map>(name, "random", order_random, true, n);
+	run<Map>(name, "random", order_random, false, n);
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run_all<ft::map<int, int> >("ft::map", n);
+	run_all<std::map<int, int> >("std::map", n);
+	return 0;
+}
@@ -0,0 +1,60 @@
+/*
+// Хранилище узлов map<int, int>: отдельные узлы (std::allocator, pool_allocator)
+// против одного массива с 32-битными индексами (ft::indexed_node_storage).
+//		insert          -- n вставок в случайном порядке
+//		find            -- n поисков случайных ключей
+//		scan            -- полный обход итератором
+//		copy            -- копирование map из n элементов
+//		./indexed_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int> std_map;
+typedef ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > > pool_map;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::indexed_node_storage> indexed_map;
+
+template<typename Map>
+static void run(const char* name, size_t n) {
+	std::string title(name);
+	std::vector<int> keys(n);
+	bench::Random rnd;
+	for (size_t i = 0; i < n; ++i) {
+		keys[i] = rnd.next_int(static_cast<int>(n * 4));
+	}
+	long sum = 0;
+	Map m;
+	bench::Timer t;
+	for (size_t i = 0; i < n; ++i) {
+		m[keys[i]] = static_cast<int>(i);
+	}
+	bench::report((title + " insert").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		sum += (m.find(rnd.next_int(static_cast<int>(n * 4))) != m.end());
+	}
+	bench::report((title + " find").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+		sum += it->second;
+	}
+	bench::report((title + " scan").c_str(), n, m.size(), t.elapsed_ns());
+	t.reset();
+	{
+		Map copy(m);
+		sum += static_cast<long>(copy.size());
+	}
+	bench::report((title + " copy").c_str(), n, m.size(), t.elapsed_ns());
+	bench::sink = sum;
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run<std_map>("std::allocator", n);
+	run<pool_map>("pool_allocator", n);
+	run<indexed_map>("indexed", n);
+	return 0;
+}
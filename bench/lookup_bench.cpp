@@ -0,0 +1,74 @@
+/*
+// Поиск в ft::map с "тяжелыми" значениями: find/count/lower_bound
+// по ключу не должны создавать временный mapped_type.
+//		string -> string    -- ключ и значение std::string
+//		int -> Big          -- значение 1 КБ
+//		string (ft::less<>) -- поиск по const char* без временного std::string
+//		./lookup_bench [n]
+*/
+
+#include <string>
+#include <cstring>
+#include <vector>
+#include "map.hpp"
+#include "bench.hpp"
+
+struct Big {
+	char	data[1024];
+
+	Big() { std::memset(data, 0, sizeof(data)); }
+};
+
+static std::string make_key(int i) {
+	char buf[64];
+	std::sprintf(buf, "user:session:%012d", i);
+	return std::string(buf);
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 200000);
+	bench::Random rnd;
+	long sum = 0;
+	{
+		ft::map<std::string, std::string> m;
+		for (size_t i = 0; i < n; ++i) {
+			m.insert(ft::make_pair(make_key(static_cast<int>(i)), std::string("value value value value")));
+		}
+		std::vector<std::string> probes;
+		for (size_t i = 0; i < n; ++i) {
+			probes.push_back(make_key(rnd.next_int(static_cast<int>(n * 2))));
+		}
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			sum += static_cast<long>(m.count(probes[i]));
+			sum += (m.lower_bound(probes[i]) != m.end());
+		}
+		bench::report("string -> string count+lower_bound", n, n, t.elapsed_ns());
+	}
+	{
+		ft::map<int, Big> m;
+		for (size_t i = 0; i < n; ++i) {
+			m.insert(ft::make_pair(static_cast<int>(i * 2), Big()));
+		}
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			sum += (m.find(rnd.next_int(static_cast<int>(n * 2))) != m.end());
+		}
+		bench::report("int -> Big find", n, n, t.elapsed_ns());
+	}
+	{
+		ft::map<std::string, int, ft::less<> > m;
+		std::vector<std::string> probes;
+		for (size_t i = 0; i < n; ++i) {
+			m.insert(ft::make_pair(make_key(static_cast<int>(i)), static_cast<int>(i)));
+			probes.push_back(make_key(rnd.next_int(static_cast<int>(n * 2))));
+		}
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			sum += (m.find(probes[i].c_str()) != m.end());
+		}
+		bench::report("string ft::less<> find(const char*)", n, n, t.elapsed_ns());
+	}
+	bench::sink = sum;
+	return 0;
+}
@@ -0,0 +1,59 @@
+/*
+// Базовые операции ft::map<int, int> в сравнении с std::map:
+// вставка случайных ключей, поиск существующих и отсутствующих ключей,
+// полный проход итератором и удаление.
+//		./map_ops_bench [n]
+*/
+
+#include <map>
+#include "map.hpp"
+#include "bench.hpp"
+
+template<typename Map>
+void run(const char* name, size_t n) {
+	char label[64];
+	bench::Random rnd;
+	Map m;
+	long sum = 0;
+
+	bench::Timer t;
+	for (size_t i = 0; i < n; ++i) {
+		m.insert(typename Map::value_type(rnd.next_int(static_cast<int>(n * 4)), static_cast<int>(i)));
+	}
+	std::sprintf(label, "%s insert", name);
+	bench::report(label, n, n, t.elapsed_ns());
+
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		typename Map::iterator it = m.find(rnd.next_int(static_cast<int>(n * 4)));
+		if (it != m.end()) {
+			sum += it->second;
+		}
+	}
+	std::sprintf(label, "%s find", name);
+	bench::report(label, n, n, t.elapsed_ns());
+
+	t.reset();
+	for (int pass = 0; pass < 10; ++pass) {
+		for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+			sum += it->first;
+		}
+	}
+	std::sprintf(label, "%s iterate", name);
+	bench::report(label, n, m.size() * 10, t.elapsed_ns());
+
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		m.erase(rnd.next_int(static_cast<int>(n * 4)));
+	}
+	std::sprintf(label, "%s erase", name);
+	bench::report(label, n, n, t.elapsed_ns());
+	bench::sink = sum;
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run<ft::map<int, int> >("ft::map", n);
+	run<std::map<int, int> >("std::map", n);
+	return 0;
+}
@@ -0,0 +1,68 @@
+/*
+// Память на элемент map<int, int>: прирост RSS процесса после n вставок, деленный на n.
+// Каждый вариант считается в отдельном дочернем процессе, чтобы память,
+// освобожденная предыдущим вариантом, не исказила результат (Linux: /proc/self/statm).
+//		ft::map                  -- узлы через std::allocator
+//		ft::map pool_allocator   -- узлы из пула
+//		ft::map indexed          -- узлы в одном массиве, связи -- 32-битные индексы
+//		std::map                 -- libstdc++ для сравнения
+//		./memory_bench [n]
+*/
+
+#include <map>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > > pool_map;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::indexed_node_storage> indexed_map;
+
+static long resident_bytes() {
+	long pages = 0;
+	long resident = 0;
+	FILE* f = std::fopen("/proc/self/statm", "r");
+	if (f == NULL) {
+		return 0;
+	}
+	if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) {
+		resident = 0;
+	}
+	std::fclose(f);
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+template<typename Map>
+static void measure(const char* name, size_t n, size_t node_size) {
+	pid_t pid = fork();
+	if (pid != 0) {
+		int status;
+		waitpid(pid, &status, 0);
+		return ;
+	}
+	long before = resident_bytes();
+	Map* m = new Map;
+	bench::Random rnd;
+	for (size_t i = 0; i < n; ++i) {
+		(*m)[static_cast<int>(rnd.next() & 0x7fffffff)] = static_cast<int>(i);
+	}
+	long after = resident_bytes();
+	std::printf("%-40s n=%-10lu %8.1f B/entry", name, static_cast<unsigned long>(m->size()),
+			static_cast<double>(after - before) / m->size());
+	if (node_size != 0) {
+		std::printf("   (node %lu B)", static_cast<unsigned long>(node_size));
+	}
+	std::printf("\n");
+	std::fflush(stdout);
+	_exit(0);
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 2000000);
+	std::fflush(stdout);
+	measure<ft::map<int, int> >("ft::map", n, sizeof(ft::map<int, int>::tree_type::Node));
+	measure<pool_map>("ft::map pool_allocator", n, sizeof(pool_map::tree_type::Node));
+	measure<indexed_map>("ft::map indexed", n, sizeof(indexed_map::tree_type::Node));
+	measure<std::map<int, int> >("std::map", n, 0);
+	return 0;
+}
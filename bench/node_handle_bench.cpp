@@ -0,0 +1,88 @@
+/*
+// Перенос элементов между map<int, std::string>: копирование значения с erase и insert
+// против node handles (extract + insert(node)) и merge.
+//		move copy      -- insert(*it) в другой map и erase(it): новый узел и копия строки
+//		move extract   -- insert(extract(it)): узел перевешивается, память не выделяется
+//		merge          -- a.merge(b) против цикла insert + erase по всем элементам b
+//		./node_handle_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, std::string> str_map;
+
+static void fill(str_map& m, size_t n, int step, int offset) {
+	for (size_t i = 0; i < n; ++i) {
+		m[static_cast<int>(i) * step + offset] = std::string(32, static_cast<char>('a' + i % 26));
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	std::vector<int> keys(n);
+	bench::Random rnd;
+	for (size_t i = 0; i < n; ++i) {
+		keys[i] = rnd.next_int(static_cast<int>(n));
+	}
+	long sum = 0;
+	{
+		str_map from;
+		str_map to;
+		fill(from, n, 1, 0);
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			str_map::iterator it = from.find(keys[i]);
+			if (it != from.end()) {
+				to.insert(*it);
+				from.erase(it);
+			}
+		}
+		bench::report("move copy", n, n, t.elapsed_ns());
+		sum += static_cast<long>(to.size());
+	}
+	{
+		str_map from;
+		str_map to;
+		fill(from, n, 1, 0);
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			str_map::iterator it = from.find(keys[i]);
+			if (it != from.end()) {
+				to.insert(from.extract(it));
+			}
+		}
+		bench::report("move extract", n, n, t.elapsed_ns());
+		sum += static_cast<long>(to.size());
+	}
+	{
+		str_map a;
+		str_map b;
+		fill(a, n, 2, 0);
+		fill(b, n, 3, 0);
+		bench::Timer t;
+		for (str_map::iterator it = b.begin(); it != b.end(); ) {
+			if (a.insert(*it).second) {
+				b.erase(it++);
+			} else {
+				++it;
+			}
+		}
+		bench::report("merge copy", n, n, t.elapsed_ns());
+		sum += static_cast<long>(a.size());
+	}
+	{
+		str_map a;
+		str_map b;
+		fill(a, n, 2, 0);
+		fill(b, n, 3, 0);
+		bench::Timer t;
+		a.merge(b);
+		bench::report("merge", n, n, t.elapsed_ns());
+		sum += static_cast<long>(a.size());
+	}
+	bench::sink = sum;
+	return 0;
+}
@@ -0,0 +1,63 @@
+/*
+// Порядковые статистики: nth(k), rank(key) и distance(first, last) на
+// ft::map с order_statistic_node_update против обхода итератором
+// (std::advance / ft::distance) на обычной ft::map.
+//		./order_stat_bench [n]
+*/
+
+#include <iterator>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int>														plain_map;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::order_statistic_node_update>										os_map;
+
+#define QUERIES 1000
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	plain_map plain;
+	os_map os;
+	bench::Random rnd;
+	for (size_t i = 0; i < n; ++i) {
+		int key = rnd.next_int(static_cast<int>(n * 4));
+		plain.insert(ft::make_pair(key, key));
+		os.insert(ft::make_pair(key, key));
+	}
+	long sum = 0;
+
+	bench::Timer t;
+	for (int i = 0; i < QUERIES; ++i) {
+		sum += os.nth(rnd.next_int(static_cast<int>(os.size())))->first;
+	}
+	bench::report("os_map nth(k)", os.size(), QUERIES, t.elapsed_ns());
+
+	t.reset();
+	for (int i = 0; i < QUERIES; ++i) {
+		sum += static_cast<long>(os.rank(rnd.next_int(static_cast<int>(n * 4))));
+	}
+	bench::report("os_map rank(key)", os.size(), QUERIES, t.elapsed_ns());
+
+	t.reset();
+	for (int i = 0; i < QUERIES; ++i) {
+		sum += os.distance(os.begin(), os.lower_bound(rnd.next_int(static_cast<int>(n * 4))));
+	}
+	bench::report("os_map distance(begin, it)", os.size(), QUERIES, t.elapsed_ns());
+
+	t.reset();
+	for (int i = 0; i < QUERIES / 100; ++i) {
+		plain_map::iterator it = plain.begin();
+		std::advance(it, rnd.next_int(static_cast<int>(plain.size())));
+		sum += it->first;
+	}
+	bench::report("plain_map advance(begin, k)", plain.size(), QUERIES / 100, t.elapsed_ns());
+
+	t.reset();
+	for (int i = 0; i < QUERIES / 100; ++i) {
+		sum += ft::distance(plain.begin(), plain.lower_bound(rnd.next_int(static_cast<int>(n * 4))));
+	}
+	bench::report("plain_map ft::distance(begin, it)", plain.size(), QUERIES / 100, t.elapsed_ns());
+	bench::sink = sum;
+	return 0;
+}
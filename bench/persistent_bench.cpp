@@ -0,0 +1,73 @@
+/*
+// Снимки map<int, int>: глубокая копия RBTree против снимка RBTree_persistent
+// (ft::persistent_node_storage) и цена записи, пока снимки живы.
+//		copy            -- копия контейнера из n элементов
+//		insert          -- n вставок в случайном порядке, снимков нет
+//		insert + snap   -- то же, снимок после каждых 1000 вставок (держится последний)
+//		find            -- n поисков случайных ключей
+//		scan            -- полный обход итератором
+//		./persistent_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int> rb_map;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::persistent_node_storage> persistent_map;
+
+template<typename Map>
+static void run(const char* name, size_t n) {
+	std::string title(name);
+	std::vector<int> keys(n);
+	bench::Random rnd;
+	for (size_t i = 0; i < n; ++i) {
+		keys[i] = rnd.next_int(static_cast<int>(n * 4));
+	}
+	long sum = 0;
+	Map m;
+	bench::Timer t;
+	for (size_t i = 0; i < n; ++i) {
+		m[keys[i]] = static_cast<int>(i);
+	}
+	bench::report((title + " insert").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	{
+		Map copy(m);
+		sum += static_cast<long>(copy.size());
+	}
+	bench::report((title + " copy").c_str(), n, 1, t.elapsed_ns());
+	{
+		Map live;
+		Map snapshot;
+		size_t every = 1000;
+		t.reset();
+		for (size_t i = 0; i < n; ++i) {
+			live[keys[i]] = static_cast<int>(i);
+			if (i % every == 0 && i / every < 200) {
+				snapshot = live;
+			}
+		}
+		bench::report((title + " insert + snap").c_str(), n, n, t.elapsed_ns());
+		sum += static_cast<long>(snapshot.size());
+	}
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		sum += (m.find(rnd.next_int(static_cast<int>(n * 4))) != m.end());
+	}
+	bench::report((title + " find").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+		sum += it->second;
+	}
+	bench::report((title + " scan").c_str(), n, m.size(), t.elapsed_ns());
+	bench::sink = sum;
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run<rb_map>("RBTree", n);
+	run<persistent_map>("persistent", n);
+	return 0;
+}
@@ -0,0 +1,62 @@
+/*
+// ft::pool_allocator против std::allocator на узлах map<int, int>.
+//		insert          -- n вставок в случайном порядке
+//		churn           -- erase + insert случайных ключей при постоянном размере
+//		fill + clear    -- повторное заполнение и очистка
+//		destroy         -- разрушение map из n элементов
+//		./pool_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int> std_map;
+typedef ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > > pool_map;
+
+template<typename Map>
+static void run(const char* name, size_t n) {
+	std::string title(name);
+	std::vector<int> keys(n);
+	bench::Random rnd;
+	for (size_t i = 0; i < n; ++i) {
+		keys[i] = rnd.next_int(static_cast<int>(n * 4));
+	}
+	long sum = 0;
+	Map* m = new Map;
+	bench::Timer t;
+	for (size_t i = 0; i < n; ++i) {
+		(*m)[keys[i]] = static_cast<int>(i);
+	}
+	bench::report((title + " insert").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		sum += static_cast<long>(m->erase(keys[i]));
+		(*m)[rnd.next_int(static_cast<int>(n * 4))] = 1;
+	}
+	bench::report((title + " churn").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	delete m;
+	bench::report((title + " destroy").c_str(), n, n, t.elapsed_ns());
+	Map small;
+	size_t rounds = 20;
+	size_t part = n / rounds;
+	t.reset();
+	for (size_t r = 0; r < rounds; ++r) {
+		for (size_t i = 0; i < part; ++i) {
+			small[keys[i]] = 1;
+		}
+		sum += static_cast<long>(small.size());
+		small.clear();
+	}
+	bench::report((title + " fill + clear").c_str(), part, part * rounds, t.elapsed_ns());
+	bench::sink = sum;
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run<std_map>("std::allocator", n);
+	run<pool_map>("pool_allocator", n);
+	return 0;
+}
@@ -0,0 +1,41 @@
+/*
+// Обход map от rbegin() до rend() с несколькими разыменованиями на элемент
+// ("сначала новые": ключ -- время, значение читается через it->first и it->second).
+//		reverse 3 deref     -- три разыменования на шаг
+//		forward 3 deref     -- то же прямым итератором, для сравнения
+//		./reverse_bench [n]
+*/
+
+#include "map.hpp"
+#include "bench.hpp"
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	int rounds = 5;
+	bench::Random rnd;
+	ft::map<int, long> m;
+	for (size_t i = 0; i < n; ++i) {
+		m.insert(ft::make_pair(rnd.next_int(static_cast<int>(n * 4)), static_cast<long>(i)));
+	}
+	long sum = 0;
+	bench::Timer t;
+	for (int r = 0; r < rounds; ++r) {
+		for (ft::map<int, long>::const_reverse_iterator it = m.rbegin(); it != m.rend(); ++it) {
+			if (it->second > 0) {
+				sum += it->first + (*it).second;
+			}
+		}
+	}
+	bench::report("reverse 3 deref", m.size(), m.size() * rounds, t.elapsed_ns());
+	t.reset();
+	for (int r = 0; r < rounds; ++r) {
+		for (ft::map<int, long>::const_iterator it = m.begin(); it != m.end(); ++it) {
+			if (it->second > 0) {
+				sum += it->first + (*it).second;
+			}
+		}
+	}
+	bench::report("forward 3 deref", m.size(), m.size() * rounds, t.elapsed_ns());
+	bench::sink = sum;
+	return 0;
+}
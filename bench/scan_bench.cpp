@@ -0,0 +1,58 @@
+/*
+// Полный обход map: обычный итератор (подъем по parent_) против прошитого дерева
+// (ft::threaded_node_update, ++ -- одна загрузка next_). Ключи вставляются в случайном
+// порядке, поэтому соседние по обходу узлы разбросаны по памяти.
+//		forward / reverse   -- ++ от begin() и -- от end()
+//		./scan_bench [n]    -- по умолчанию 10M элементов
+*/
+
+#include <vector>
+#include <algorithm>
+#include "map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int> plain_map;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+			ft::threaded_node_update> threaded_map;
+
+template<typename Map>
+static void run(const char* name, const std::vector<int>& keys, int rounds) {
+	std::string title(name);
+	Map m;
+	for (size_t i = 0; i < keys.size(); ++i) {
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	}
+	long sum = 0;
+	bench::Timer t;
+	for (int r = 0; r < rounds; ++r) {
+		for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+			sum += it->second;
+		}
+	}
+	bench::report((title + " forward").c_str(), keys.size(), keys.size() * rounds, t.elapsed_ns());
+	t.reset();
+	for (int r = 0; r < rounds; ++r) {
+		typename Map::const_iterator it = m.end();
+		while (it != m.begin()) {
+			--it;
+			sum += it->first;
+		}
+	}
+	bench::report((title + " reverse").c_str(), keys.size(), keys.size() * rounds, t.elapsed_ns());
+	bench::sink = sum;
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 10000000);
+	std::vector<int> keys(n);
+	for (size_t i = 0; i < n; ++i) {
+		keys[i] = static_cast<int>(i);
+	}
+	bench::Random rnd;
+	for (size_t i = n; i > 1; --i) {
+		std::swap(keys[i - 1], keys[rnd.next() % i]);
+	}
+	run<plain_map>("map", keys, 3);
+	run<threaded_map>("threaded map", keys, 3);
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*
+// Алгебра множеств на set<int>: split/join-операции RBTree против
+// поэлементных insert/find/erase. a -- n случайных ключей, b -- m ключей из того же диапазона.
+//		union        -- a.set_union(b)        / insert каждого элемента b
+//		intersection -- a.set_intersection(b) / find каждого элемента b и сборка результата
+//		                (обе версии разрушают удаленные элементы a внутри замера)
+//		difference   -- a.set_difference(b)   / erase каждого элемента b
+//		split + join -- a.split(медиана) и join обратно / insert(first, last) + erase(first, last)
+//		./set_ops_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include "set.hpp"
+#include "bench.hpp"
+
+typedef ft::set<int> int_set;
+
+static void fill(int_set& s, size_t count, int range, bench::Random& rnd) {
+	while (s.size() < count) {
+		s.insert(rnd.next_int(range));
+	}
+}
+
+static void run(size_t n, size_t m) {
+	char name[64];
+	std::sprintf(name, "m=%lu ", static_cast<unsigned long>(m));
+	std::string title(name);
+	int range = static_cast<int>(n * 4);
+	bench::Random rnd;
+	int_set a;
+	int_set b;
+	fill(a, n, range, rnd);
+	fill(b, m, range, rnd);
+	long sum = 0;
+	{
+		int_set x(a);
+		int_set y(b);
+		bench::Timer t;
+		x.set_union(y);
+		bench::report((title + "union bulk").c_str(), n, m, t.elapsed_ns());
+		sum += static_cast<long>(x.size());
+	}
+	{
+		int_set x(a);
+		bench::Timer t;
+		for (int_set::const_iterator it = b.begin(); it != b.end(); ++it) {
+			x.insert(*it);
+		}
+		bench::report((title + "union insert").c_str(), n, m, t.elapsed_ns());
+		sum += static_cast<long>(x.size());
+	}
+	{
+		int_set x(a);
+		bench::Timer t;
+		x.set_intersection(b);
+		bench::report((title + "intersection bulk").c_str(), n, m, t.elapsed_ns());
+		sum += static_cast<long>(x.size());
+	}
+	{
+		int_set x(a);
+		bench::Timer t;
+		int_set result;
+		for (int_set::const_iterator it = b.begin(); it != b.end(); ++it) {
+			if (x.find(*it) != x.end()) {
+				result.insert(result.end(), *it);
+			}
+		}
+		x.swap(result);
+		result.clear();
+		bench::report((title + "intersection find").c_str(), n, m, t.elapsed_ns());
+		sum += static_cast<long>(x.size());
+	}
+	{
+		int_set x(a);
+		bench::Timer t;
+		x.set_difference(b);
+		bench::report((title + "difference bulk").c_str(), n, m, t.elapsed_ns());
+		sum += static_cast<long>(x.size());
+	}
+	{
+		int_set x(a);
+		bench::Timer t;
+		for (int_set::const_iterator it = b.begin(); it != b.end(); ++it) {
+			x.erase(*it);
+		}
+		bench::report((title + "difference erase").c_str(), n, m, t.elapsed_ns());
+		sum += static_cast<long>(x.size());
+	}
+	bench::sink = sum;
+}
+
+//↓↓↓ split и join не зависят от m: делим a по середине диапазона и склеиваем обратно
+static void run_split(size_t n) {
+	int range = static_cast<int>(n * 4);
+	bench::Random rnd;
+	int_set a;
+	fill(a, n, range, rnd);
+	int key = range / 2;
+	long sum = 0;
+	{
+		int_set x(a);
+		int_set greater;
+		bench::Timer t;
+		x.split(key, greater);
+		x.join(greater);
+		bench::report("split + join bulk", n, 1, t.elapsed_ns());
+		sum += static_cast<long>(x.size());
+	}
+	{
+		int_set x(a);
+		int_set greater;
+		bench::Timer t;
+		int_set::iterator first = x.lower_bound(key);
+		greater.insert(first, x.end());
+		x.erase(first, x.end());
+		x.insert(greater.begin(), greater.end());
+		greater.clear();
+		bench::report("split + join insert/erase", n, 1, t.elapsed_ns());
+		sum += static_cast<long>(x.size());
+	}
+	bench::sink = sum;
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	size_t sizes[] = { 1000, 100000, n };
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+		if (sizes[i] <= n) {
+			run(n, sizes[i]);
+		}
+	}
+	run_split(n);
+	return 0;
+}
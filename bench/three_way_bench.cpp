@@ -0,0 +1,73 @@
+/*
+// Спуски по дереву с трехсторонним сравнением: одно сравнение на узел.
+// Ключи-строки с длинным общим префиксом, где каждое сравнение дорогое.
+//		find / count        -- попадания и промахи пополам
+//		insert              -- вставка в дерево из n ключей, половина уже есть
+//		./three_way_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "set.hpp"
+#include "bench.hpp"
+
+static std::string make_key(int i) {
+	char buf[128];
+	std::sprintf(buf, "/var/lib/service/shard/%012d", i);
+	return std::string(buf);
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 200000);
+	bench::Random rnd;
+	long sum = 0;
+	std::vector<std::string> keys;
+	std::vector<std::string> probes;
+	for (size_t i = 0; i < n; ++i) {
+		keys.push_back(make_key(static_cast<int>(i * 2)));
+		probes.push_back(make_key(rnd.next_int(static_cast<int>(n * 2))));
+	}
+	{
+		ft::map<std::string, int> m;
+		for (size_t i = 0; i < n; ++i) {
+			m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+		}
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			sum += (m.find(probes[i]) != m.end());
+		}
+		bench::report("map<string> find", n, n, t.elapsed_ns());
+		t.reset();
+		for (size_t i = 0; i < n; ++i) {
+			sum += static_cast<long>(m.count(probes[i]));
+		}
+		bench::report("map<string> count", n, n, t.elapsed_ns());
+		t.reset();
+		for (size_t i = 0; i < n; ++i) {
+			sum += m.insert(ft::make_pair(probes[i], 0)).second;
+		}
+		bench::report("map<string> insert", n, n, t.elapsed_ns());
+	}
+	{
+		ft::set<std::string> s(keys.begin(), keys.end());
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			sum += static_cast<long>(s.count(probes[i]));
+		}
+		bench::report("set<string> count", n, n, t.elapsed_ns());
+	}
+	{
+		ft::set<int> s;
+		for (size_t i = 0; i < n; ++i) {
+			s.insert(static_cast<int>(i * 2));
+		}
+		bench::Timer t;
+		for (size_t i = 0; i < n; ++i) {
+			sum += static_cast<long>(s.count(rnd.next_int(static_cast<int>(n * 2))));
+		}
+		bench::report("set<int> count", n, n, t.elapsed_ns());
+	}
+	bench::sink = sum;
+	return 0;
+}
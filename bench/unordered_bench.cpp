@@ -0,0 +1,108 @@
+/*
+// map<int, int> на красно-черном дереве, std::tr1::unordered_map<int, int> (цепочки в корзинах;
+// std::unordered_map -- это C++11, а бенчмарки собираются с -std=c++98) и ft::unordered_map<int, int>
+// (открытая адресация, группы по 16 управляющих байт, SSE2).
+//		insert          -- n вставок случайных ключей
+//		insert reserved -- то же после reserve(n) (у map -- без reserve)
+//		find hit        -- n поисков существующих ключей
+//		find miss       -- n поисков отсутствующих ключей
+//		scan            -- полный обход итератором
+//		churn           -- n пар erase + insert нового ключа при неизменном размере
+//		erase           -- удаление всех элементов по ключу
+//		./unordered_bench [n]
+*/
+
+#include <string>
+#include <vector>
+#include <tr1/unordered_map>
+#include "map.hpp"
+#include "unordered_map.hpp"
+#include "bench.hpp"
+
+typedef ft::map<int, int> rb_map;
+typedef std::tr1::unordered_map<int, int> tr1_map;
+typedef ft::unordered_map<int, int> hash_map;
+
+template<typename Map>
+static void reserve(Map& m, size_t n) {
+	m.reserve(n);
+}
+
+template<>
+void reserve<rb_map>(rb_map&, size_t) {}
+
+template<>
+void reserve<tr1_map>(tr1_map& m, size_t n) {
+	m.rehash(static_cast<size_t>(n / m.max_load_factor()) + 1);
+}
+
+template<typename Map>
+static void insert(Map& m, int key, int value) {
+	m.insert(typename Map::value_type(key, value));
+}
+
+template<typename Map>
+static void run(const char* name, size_t n) {
+	std::string title(name);
+	//↓↓↓ четные ключи есть в контейнере, нечетные -- промахи
+	std::vector<int> keys(n);
+	bench::Random rnd;
+	for (size_t i = 0; i < n; ++i) {
+		keys[i] = static_cast<int>(rnd.next() & 0x3FFFFFFF) * 2;
+	}
+	long sum = 0;
+	Map m;
+	bench::Timer t;
+	for (size_t i = 0; i < n; ++i) {
+		insert(m, keys[i], static_cast<int>(i));
+	}
+	bench::report((title + " insert").c_str(), n, n, t.elapsed_ns());
+	{
+		Map r;
+		reserve(r, n);
+		t.reset();
+		for (size_t i = 0; i < n; ++i) {
+			insert(r, keys[i], static_cast<int>(i));
+		}
+		bench::report((title + " insert reserved").c_str(), n, n, t.elapsed_ns());
+		sum += static_cast<long>(r.size());
+	}
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		typename Map::iterator it = m.find(keys[rnd.next() % n]);
+		sum += it->second;
+	}
+	bench::report((title + " find hit").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		sum += (m.find(keys[rnd.next() % n] + 1) != m.end());
+	}
+	bench::report((title + " find miss").c_str(), n, n, t.elapsed_ns());
+	t.reset();
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+		sum += it->second;
+	}
+	bench::report((title + " scan").c_str(), n, m.size(), t.elapsed_ns());
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		m.erase(keys[i]);
+		keys[i] = static_cast<int>(rnd.next() & 0x3FFFFFFF) * 2;
+		insert(m, keys[i], static_cast<int>(i));
+	}
+	bench::report((title + " churn").c_str(), n, n, t.elapsed_ns());
+	size_t size = m.size();
+	t.reset();
+	for (size_t i = 0; i < n; ++i) {
+		m.erase(keys[i]);
+	}
+	bench::report((title + " erase").c_str(), n, size, t.elapsed_ns());
+	bench::sink = sum + static_cast<long>(m.size());
+}
+
+int main(int argc, char** argv) {
+	size_t n = bench::arg_size(argc, argv, 1000000);
+	run<rb_map>("map", n);
+	run<tr1_map>("tr1::unordered_map", n);
+	run<hash_map>("unordered_map", n);
+	return 0;
+}
@@ -0,0 +1,182 @@
+/*
+// btree_set -- set на B+-дереве (tree/btree.hpp): тот же интерфейс, что у ft::set,
+// но десятки ключей в узле размером в несколько строк кэша.
+//		ft::btree_set<K>
+//		ft::btree_set<K, std::less<K>, std::allocator<K>, 512>
+// Последний параметр -- размер узла в байтах (по умолчанию 256).
+// Ключи копируются во внутренние узлы как разделители, поэтому iterator -- константный
+// (как у std::set): изменение ключа через итератор сломало бы дерево.
+// Отличия от ft::set -- как у btree_map (btree_map.hpp).
+// Использованные материалы:
+//		https://abseil.io/docs/cpp/guides/container#b-tree-ordered-containers
+//		https://en.cppreference.com/w/cpp/container/set
+*/
+
+#ifndef BTREE_SET_HPP
+# define BTREE_SET_HPP
+
+# include <functional>
+# include <memory>
+# include "tree/btree.hpp"
+# include "utils/utils.hpp"
+
+namespace ft {
+
+	template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>,
+			std::size_t NodeBytes = 256>
+	class btree_set {
+		public:
+			typedef				Key										key_type;
+			typedef				Key										value_type;
+			typedef				Compare									key_compare;
+			typedef				Compare									value_compare;
+			typedef				Allocator								allocator_type;
+			typedef typename	Allocator::reference					reference;
+			typedef typename	Allocator::const_reference				const_reference;
+			typedef typename	Allocator::difference_type				difference_type;
+			typedef typename	Allocator::size_type					size_type;
+			typedef typename	Allocator::pointer						pointer;
+			typedef typename	Allocator::const_pointer				const_pointer;
+			typedef ft::BTree<Key, Key, ft::identity<Key>, Compare, Allocator, NodeBytes>	tree_type;
+			typedef typename	tree_type::const_iterator				iterator;
+			typedef typename	tree_type::const_iterator				const_iterator;
+			typedef typename	tree_type::const_reverse_iterator		reverse_iterator;
+			typedef typename	tree_type::const_reverse_iterator		const_reverse_iterator;
+
+		private:
+			tree_type tree_;
+
+		public:
+// construct/copy/destroy:
+			explicit btree_set(const key_compare& comp = key_compare(),
+					const allocator_type& alloc = allocator_type()) :
+				tree_(comp, alloc)
+			{}
+
+			template<typename InputIterator>
+			btree_set(InputIterator first,
+					InputIterator last,
+					const Compare& comp = Compare(),
+					const Allocator& alloc = Allocator()) :
+				tree_(comp, alloc) {
+				insert(first, last);
+			}
+
+			btree_set(const btree_set& rhs) : tree_(rhs.tree_) {}
+
+			btree_set& operator=(const btree_set& rhs) {
+				tree_ = rhs.tree_;
+				return *this;
+			}
+
+			allocator_type get_allocator() const {
+				return tree_.get_allocator();
+			}
+
+// iterators:
+			iterator begin() const { return tree_.begin(); }
+			iterator end() const { return tree_.end(); }
+			reverse_iterator rbegin() const { return tree_.rbegin(); }
+			reverse_iterator rend() const { return tree_.rend(); }
+
+// capacity:
+			bool empty() const { return tree_.empty(); }
+			size_type size() const { return tree_.size(); }
+			size_type max_size() const { return tree_.max_size(); }
+
+// modifiers:
+			ft::pair<iterator, bool> insert(const value_type& x) {
+				return tree_.insert_unique(x);
+			}
+
+			iterator insert(iterator position, const value_type& x) {
+				return tree_.insert_hint(position, x);
+			}
+
+			template<typename InputIterator>
+			void insert(InputIterator first, InputIterator last) {
+				tree_.insert_range(first, last);
+			}
+
+			iterator erase(iterator position) {
+				return tree_.erase(position);
+			}
+
+			size_type erase(const key_type& x) {
+				return tree_.erase_key(x);
+			}
+
+			iterator erase(iterator first, iterator last) {
+				return tree_.erase(first, last);
+			}
+
+			void swap(btree_set& rhs) {
+				tree_.swap(rhs.tree_);
+			}
+
+			void clear() {
+				tree_.clear();
+			}
+
+// observers:
+			key_compare key_comp() const { return tree_.key_comp(); }
+			value_compare value_comp() const { return tree_.key_comp(); }
+
+// set operations:
+			iterator find(const key_type& x) const { return tree_.find(x); }
+			size_type count(const key_type& x) const { return tree_.count(x); }
+			iterator lower_bound(const key_type& x) const { return tree_.lower_bound(x); }
+			iterator upper_bound(const key_type& x) const { return tree_.upper_bound(x); }
+			pair<iterator, iterator> equal_range(const key_type& x) const { return tree_.equal_range(x); }
+
+// heterogeneous lookup (Compare::is_transparent, e.g. ft::less<>):
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			find(const K& x) const { return tree_.find(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, size_type>::type
+			count(const K& x) const { return tree_.count(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			lower_bound(const K& x) const { return tree_.lower_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			upper_bound(const K& x) const { return tree_.upper_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, pair<iterator, iterator> >::type
+			equal_range(const K& x) const { return tree_.equal_range(x); }
+
+			friend bool operator==(const btree_set& lhs, const btree_set& rhs) {
+				return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+			}
+
+			friend bool operator!=(const btree_set& lhs, const btree_set& rhs) {
+				return !(lhs == rhs);
+			}
+
+			friend bool operator<(const btree_set& lhs, const btree_set& rhs) {
+				return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+			}
+
+			friend bool operator>(const btree_set& lhs, const btree_set& rhs) {
+				return rhs < lhs;
+			}
+
+			friend bool operator<=(const btree_set& lhs, const btree_set& rhs) {
+				return !(lhs > rhs);
+			}
+
+			friend bool operator>=(const btree_set& lhs, const btree_set& rhs) {
+				return !(lhs < rhs);
+			}
+	}; //btree_set
+
+// specialized algorithms:
+	template<typename Key, typename Compare, typename Alloc, std::size_t NodeBytes>
+	void swap(ft::btree_set<Key, Compare, Alloc, NodeBytes>& lhs, ft::btree_set<Key, Compare, Alloc, NodeBytes>& rhs) {
+		lhs.swap(rhs);
+	}
+
+} // namespace ft
+
+#endif
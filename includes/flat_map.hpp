@@ -0,0 +1,239 @@
+/*
+// flat_map -- map на отсортированном векторе (tree/flat_tree.hpp): тот же интерфейс, что у ft::map,
+// но все пары лежат подряд в одном ft::vector. Поиск -- двоичный по массиву, обход идет
+// со скоростью чтения памяти, накладных расходов на элемент нет.
+//		ft::flat_map<K, V>
+//		ft::flat_map<K, V> m(first, last);	// сортировка и удаление дубликатов за один проход
+//		m.insert(first, last);				// пачка сливается с массивом, а не вставляется по одной
+// Одиночные insert и erase сдвигают хвост массива -- O(n); контейнер для таблиц,
+// которые строятся целиком или пачками и потом в основном читаются.
+// Отличия от ft::map:
+//		- iterator -- итератор произвольного доступа по вектору; вставка и удаление
+//		  делают недействительными все итераторы и ссылки, как у вектора;
+//		- erase(iterator) возвращает итератор на следующий элемент;
+//		- есть reserve() и capacity();
+//		- нет node handles, find_batch, order statistics и split/join -- они завязаны на узлы RBTree.
+// Использованные материалы:
+//		https://www.boost.org/doc/libs/release/doc/html/container/non_standard_containers.html#container.non_standard_containers.flat_xxx
+//		https://en.cppreference.com/w/cpp/container/flat_map
+*/
+
+#ifndef FLAT_MAP_HPP
+# define FLAT_MAP_HPP
+
+# include <functional>
+# include <memory>
+# include "tree/flat_tree.hpp"
+# include "utils/utils.hpp"
+
+namespace ft {
+
+	template<typename Key, typename T, typename Compare = std::less<Key>, typename Allocator = std::allocator<ft::pair<const Key, T> > >
+	class flat_map {
+		public:
+// types:
+			typedef Key													key_type;
+			typedef T													mapped_type;
+			typedef ft::pair<const Key, T>								value_type;
+			typedef Compare												key_compare;
+			typedef	Allocator											allocator_type;
+
+			class value_compare : public std::binary_function<value_type, value_type, bool> {
+				private:
+					friend class flat_map;
+				protected:
+					Compare comp;
+					value_compare(Compare c) : comp(c) {}
+				public:
+					bool operator()(const value_type& x, const value_type& y) const {
+						return comp(x.first, y.first);
+					}
+			};
+
+			typedef typename	Allocator::reference					reference;
+			typedef typename	Allocator::const_reference				const_reference;
+			typedef typename	Allocator::difference_type				difference_type;
+			typedef typename	Allocator::size_type					size_type;
+			typedef typename	Allocator::pointer						pointer;
+			typedef typename	Allocator::const_pointer				const_pointer;
+			typedef ft::flat_tree<Key, value_type, ft::select_first<value_type>, Compare, Allocator>	tree_type;
+			typedef typename tree_type::iterator						iterator;
+			typedef typename tree_type::const_iterator					const_iterator;
+			typedef typename tree_type::reverse_iterator				reverse_iterator;
+			typedef typename tree_type::const_reverse_iterator			const_reverse_iterator;
+
+		private:
+			tree_type		tree_;
+
+			//↓↓↓ mapped_type() строится, только когда в массив вставляется новый элемент
+			struct default_mapped {
+				operator mapped_type() const { return mapped_type(); }
+			};
+
+// construct/copy/destroy:
+		public:
+			explicit flat_map(const key_compare& cmp = key_compare(), const allocator_type& alloc = allocator_type()) :
+					tree_(cmp, alloc)
+			{}
+
+			template<typename InputIterator>
+			flat_map(InputIterator first, InputIterator last,
+					const key_compare& cmp = key_compare(),
+					const allocator_type& alloc = allocator_type()) :
+								tree_(cmp, alloc) {
+				insert(first, last);
+			}
+
+			flat_map(const flat_map& rhs) : tree_(rhs.tree_) {}
+
+			flat_map& operator=(const flat_map& rhs) {
+				tree_ = rhs.tree_;
+				return *this;
+			}
+
+			~flat_map() {}
+
+			allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+// iterators:
+			iterator begin() { return tree_.begin(); }
+			const_iterator begin() const { return tree_.begin(); }
+			iterator end() { return tree_.end(); }
+			const_iterator end() const { return tree_.end(); }
+			reverse_iterator rbegin() { return tree_.rbegin(); }
+			const_reverse_iterator rbegin() const { return tree_.rbegin(); }
+			reverse_iterator rend() { return tree_.rend(); }
+			const_reverse_iterator rend() const { return tree_.rend(); }
+
+// capacity:
+			bool empty() const { return tree_.empty(); }
+			size_type size() const { return tree_.size(); }
+			size_type max_size() const { return tree_.max_size(); }
+			size_type capacity() const { return tree_.capacity(); }
+			void reserve(size_type n) { tree_.reserve(n); }
+
+// element access:
+			mapped_type& operator[](const key_type& k) {
+				return tree_.try_emplace(k, default_mapped()).first->second;
+			}
+
+			pair<iterator, bool> try_emplace(const key_type& k) {
+				return tree_.try_emplace(k, default_mapped());
+			}
+
+			pair<iterator, bool> try_emplace(const key_type& k, const mapped_type& obj) {
+				return tree_.try_emplace(k, obj);
+			}
+
+// modifiers:
+			pair<iterator, bool> insert(const value_type& x) {
+				return tree_.insert_unique(x);
+			}
+
+			iterator insert(iterator position, const value_type& x) {
+				return tree_.insert_hint(position, x);
+			}
+
+			template<typename InputIterator>
+			void insert(InputIterator first, InputIterator last) {
+				tree_.insert_range(first, last);
+			}
+
+			iterator erase(iterator position) {
+				return tree_.erase(position);
+			}
+
+			size_type erase(const key_type& x) {
+				return tree_.erase_key(x);
+			}
+
+			iterator erase(iterator first, iterator last) {
+				return tree_.erase(first, last);
+			}
+
+			void swap(flat_map& other) {
+				tree_.swap(other.tree_);
+			}
+
+			void clear() {
+				tree_.clear();
+			}
+
+// observers:
+			key_compare key_comp() const { return tree_.key_comp(); }
+			value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+
+// map operations:
+			iterator find(const key_type& x) { return tree_.find(x); }
+			const_iterator find(const key_type& x) const { return tree_.find(x); }
+			size_type count(const key_type& x) const { return tree_.count(x); }
+			iterator lower_bound(const key_type& x) { return tree_.lower_bound(x); }
+			const_iterator lower_bound(const key_type& x) const { return tree_.lower_bound(x); }
+			iterator upper_bound(const key_type& x) { return tree_.upper_bound(x); }
+			const_iterator upper_bound(const key_type& x) const { return tree_.upper_bound(x); }
+			pair<iterator, iterator> equal_range(const key_type& x) { return tree_.equal_range(x); }
+			pair<const_iterator, const_iterator> equal_range(const key_type& x) const { return tree_.equal_range(x); }
+
+// heterogeneous lookup (Compare::is_transparent, e.g. ft::less<>):
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			find(const K& x) { return tree_.find(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			find(const K& x) const { return tree_.find(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, size_type>::type
+			count(const K& x) const { return tree_.count(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			lower_bound(const K& x) { return tree_.lower_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			lower_bound(const K& x) const { return tree_.lower_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			upper_bound(const K& x) { return tree_.upper_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			upper_bound(const K& x) const { return tree_.upper_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, pair<iterator, iterator> >::type
+			equal_range(const K& x) { return tree_.equal_range(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, pair<const_iterator, const_iterator> >::type
+			equal_range(const K& x) const { return tree_.equal_range(x); }
+
+			friend bool operator==(const flat_map& lhs, const flat_map& rhs) {
+				return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+			}
+
+			friend bool operator!=(const flat_map& lhs, const flat_map& rhs) {
+				return !(lhs == rhs);
+			}
+
+			friend bool operator<(const flat_map& lhs, const flat_map& rhs) {
+				return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+			}
+
+			friend bool operator>(const flat_map& lhs, const flat_map& rhs) {
+				return rhs < lhs;
+			}
+
+			friend bool operator<=(const flat_map& lhs, const flat_map& rhs) {
+				return !(lhs > rhs);
+			}
+
+			friend bool operator>=(const flat_map& lhs, const flat_map& rhs) {
+				return !(lhs < rhs);
+			}
+	}; //flat_map
+
+// specialized algorithms:
+	template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc>
+	void swap(flat_map<t_Key, t_T, t_Compare, t_Alloc>& lhs, flat_map<t_Key, t_T, t_Compare, t_Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,173 @@
+/*
+// frozen_map -- неизменяемый снимок ft::map для таблиц, которые один раз строятся и потом
+// только читаются: все пары в одном массиве в раскладке Эйтцингера (tree/eytzinger.hpp),
+// поиск без ветвлений и с предвыборкой памяти на несколько уровней вперед.
+//		ft::map<K, V> m;  ...  заполнение
+//		ft::frozen_map<K, V> f(m);			// или ft::frozen_map<K, V> f = ft::freeze(m);
+//		f.find(k); f.lower_bound(k);		// обход begin()..end() -- по возрастанию ключей
+// Исходный map не меняется; снимок от него не зависит.
+// Отличия от ft::map:
+//		- нет вставки, удаления и operator[]; iterator -- константный, значения тоже не меняются;
+//		- обход по порядку ключей идет по неявному дереву и прыгает по массиву -- снимок
+//		  ускоряет поиск, а не перебор.
+// Использованные материалы:
+//		https://arxiv.org/abs/1509.05053
+//		https://algorithmica.org/en/eytzinger
+//		https://en.cppreference.com/w/cpp/container/map
+*/
+
+#ifndef FROZEN_MAP_HPP
+# define FROZEN_MAP_HPP
+
+# include <functional>
+# include <memory>
+# include "map.hpp"
+# include "tree/eytzinger.hpp"
+# include "utils/utils.hpp"
+
+namespace ft {
+
+	template<typename Key, typename T, typename Compare = std::less<Key>, typename Allocator = std::allocator<ft::pair<const Key, T> > >
+	class frozen_map {
+		public:
+// types:
+			typedef Key													key_type;
+			typedef T													mapped_type;
+			typedef ft::pair<const Key, T>								value_type;
+			typedef Compare												key_compare;
+			typedef	Allocator											allocator_type;
+
+			class value_compare : public std::binary_function<value_type, value_type, bool> {
+				private:
+					friend class frozen_map;
+				protected:
+					Compare comp;
+					value_compare(Compare c) : comp(c) {}
+				public:
+					bool operator()(const value_type& x, const value_type& y) const {
+						return comp(x.first, y.first);
+					}
+			};
+
+			typedef typename	Allocator::reference					reference;
+			typedef typename	Allocator::const_reference				const_reference;
+			typedef typename	Allocator::difference_type				difference_type;
+			typedef typename	Allocator::size_type					size_type;
+			typedef typename	Allocator::pointer						pointer;
+			typedef typename	Allocator::const_pointer				const_pointer;
+			typedef ft::Eytzinger<Key, value_type, ft::select_first<value_type>, Compare, Allocator>	tree_type;
+			typedef typename tree_type::const_iterator					iterator;
+			typedef typename tree_type::const_iterator					const_iterator;
+			typedef typename tree_type::const_reverse_iterator			reverse_iterator;
+			typedef typename tree_type::const_reverse_iterator			const_reverse_iterator;
+
+		private:
+			tree_type		tree_;
+
+// construct/copy/destroy:
+		public:
+			explicit frozen_map(const key_compare& cmp = key_compare(), const allocator_type& alloc = allocator_type()) :
+					tree_(cmp, alloc)
+			{}
+
+			//↓↓↓ снимок map с тем же сравнением; аллокатор и политики узлов map могут быть любыми
+			template<typename MapAllocator, typename NodeUpdate, typename Balance>
+			explicit frozen_map(const ft::map<Key, T, Compare, MapAllocator, NodeUpdate, Balance>& m,
+					const allocator_type& alloc = allocator_type()) :
+					tree_(m.begin(), m.size(), m.key_comp(), alloc)
+			{}
+
+			frozen_map(const frozen_map& rhs) : tree_(rhs.tree_) {}
+
+			frozen_map& operator=(const frozen_map& rhs) {
+				tree_ = rhs.tree_;
+				return *this;
+			}
+
+			~frozen_map() {}
+
+			allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+// iterators:
+			const_iterator begin() const { return tree_.begin(); }
+			const_iterator end() const { return tree_.end(); }
+			const_reverse_iterator rbegin() const { return tree_.rbegin(); }
+			const_reverse_iterator rend() const { return tree_.rend(); }
+
+// capacity:
+			bool empty() const { return tree_.empty(); }
+			size_type size() const { return tree_.size(); }
+			size_type max_size() const { return tree_.max_size(); }
+
+			void swap(frozen_map& other) {
+				tree_.swap(other.tree_);
+			}
+
+// observers:
+			key_compare key_comp() const { return tree_.key_comp(); }
+			value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+
+// map operations:
+			const_iterator find(const key_type& x) const { return tree_.find(x); }
+			size_type count(const key_type& x) const { return tree_.count(x); }
+			const_iterator lower_bound(const key_type& x) const { return tree_.lower_bound(x); }
+			const_iterator upper_bound(const key_type& x) const { return tree_.upper_bound(x); }
+			pair<const_iterator, const_iterator> equal_range(const key_type& x) const { return tree_.equal_range(x); }
+
+// heterogeneous lookup (Compare::is_transparent, e.g. ft::less<>):
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			find(const K& x) const { return tree_.find(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, size_type>::type
+			count(const K& x) const { return tree_.count(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			lower_bound(const K& x) const { return tree_.lower_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			upper_bound(const K& x) const { return tree_.upper_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, pair<const_iterator, const_iterator> >::type
+			equal_range(const K& x) const { return tree_.equal_range(x); }
+
+			friend bool operator==(const frozen_map& lhs, const frozen_map& rhs) {
+				return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+			}
+
+			friend bool operator!=(const frozen_map& lhs, const frozen_map& rhs) {
+				return !(lhs == rhs);
+			}
+
+			friend bool operator<(const frozen_map& lhs, const frozen_map& rhs) {
+				return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+			}
+
+			friend bool operator>(const frozen_map& lhs, const frozen_map& rhs) {
+				return rhs < lhs;
+			}
+
+			friend bool operator<=(const frozen_map& lhs, const frozen_map& rhs) {
+				return !(lhs > rhs);
+			}
+
+			friend bool operator>=(const frozen_map& lhs, const frozen_map& rhs) {
+				return !(lhs < rhs);
+			}
+	}; //frozen_map
+
+// specialized algorithms:
+	template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc>
+	void swap(frozen_map<t_Key, t_T, t_Compare, t_Alloc>& lhs, frozen_map<t_Key, t_T, t_Compare, t_Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+
+	//↓↓↓ снимок с тем же аллокатором, что у map
+	template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc, typename t_NodeUpdate, typename t_Balance>
+	frozen_map<t_Key, t_T, t_Compare, t_Alloc> freeze(const map<t_Key, t_T, t_Compare, t_Alloc, t_NodeUpdate, t_Balance>& m) {
+		return frozen_map<t_Key, t_T, t_Compare, t_Alloc>(m, m.get_allocator());
+	}
+
+} // namespace ft
+
+#endif
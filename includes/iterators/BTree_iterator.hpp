@@ -0,0 +1,101 @@
+#ifndef BTREE_ITERATOR_HPP
+# define BTREE_ITERATOR_HPP
+
+# include "../tree/btree_node.hpp"
+# include "RBTree_iterator.hpp"
+
+namespace ft {
+
+	//↓↓↓ итератор B+-дерева: лист и индекс значения в нем. Шаги идут по списку листьев,
+	// замкнутому через заголовок: end() -- (заголовок, 0), --end() -- последнее значение
+	// самого правого листа. Вставка и удаление двигают значения между листьями,
+	// поэтому итераторы, как у vector, после них недействительны.
+	template<typename T, typename Leaf>
+	class BTree_iterator {
+		public:
+			typedef T												value_type;
+			typedef T*												pointer;
+			typedef T&												reference;
+			typedef std::bidirectional_iterator_tag					iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+
+			typedef typename ft::remove_const<value_type>::type		clear_value_type;
+			typedef BTree_leaf_base*								node_ptr;
+
+		private:
+			node_ptr		node_;
+			std::size_t		index_;
+
+		public:
+			BTree_iterator() : node_(0), index_(0) {}
+
+			BTree_iterator(node_ptr node, std::size_t index) : node_(node), index_(index) {}
+
+			BTree_iterator(const BTree_iterator<clear_value_type, Leaf>& rhs) :
+					node_(rhs.node()), index_(rhs.index()) {}
+
+			BTree_iterator& operator=(const BTree_iterator<clear_value_type, Leaf>& rhs) {
+				node_ = rhs.node();
+				index_ = rhs.index();
+				return *this;
+			}
+
+			node_ptr node() const {
+				return node_;
+			}
+
+			std::size_t index() const {
+				return index_;
+			}
+
+			reference operator*() const {
+				return static_cast<Leaf*>(node_)->value(index_);
+			}
+
+			pointer operator->() const {
+				return &(operator*());
+			}
+
+			BTree_iterator& operator++() {
+				if (++index_ == node_->count_) {
+					node_ = node_->next_;
+					index_ = 0;
+				}
+				return (*this);
+			}
+
+			BTree_iterator operator++(int) {
+				BTree_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+
+			BTree_iterator& operator--() {
+				if (index_ == 0) {
+					node_ = node_->prev_;
+					index_ = node_->count_;
+				}
+				--index_;
+				return (*this);
+			}
+
+			BTree_iterator operator--(int) {
+				BTree_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+	};
+
+	template<typename T1, typename T2, typename Leaf>
+	bool operator==(const BTree_iterator<T1, Leaf>& lhs, const BTree_iterator<T2, Leaf>& rhs) {
+		return lhs.node() == rhs.node() && lhs.index() == rhs.index();
+	}
+
+	template<typename T1, typename T2, typename Leaf>
+	bool operator!=(const BTree_iterator<T1, Leaf>& lhs, const BTree_iterator<T2, Leaf>& rhs) {
+		return !(lhs == rhs);
+	}
+
+} // namespace ft
+
+#endif
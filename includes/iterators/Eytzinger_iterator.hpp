@@ -0,0 +1,147 @@
+#ifndef EYTZINGER_ITERATOR_HPP
+# define EYTZINGER_ITERATOR_HPP
+
+# include <cstddef>
+# include <iterator>
+# include "RBTree_iterator.hpp"
+
+namespace ft {
+
+	//↓↓↓ обход неявного дерева в массиве Эйтцингера (индексы 1..n, дети k -- 2k и 2k + 1,
+	// 0 -- end()) в порядке возрастания ключей: те же шаги, что у RBTree_iterator, только
+	// родитель и дети вычисляются, а не хранятся
+	inline std::size_t eytzinger_first(std::size_t n) {
+		std::size_t k = (n != 0);
+		while (2 * k <= n && k != 0) {
+			k = 2 * k;
+		}
+		return k;
+	}
+
+	inline std::size_t eytzinger_last(std::size_t n) {
+		std::size_t k = (n != 0);
+		while (2 * k + 1 <= n && k != 0) {
+			k = 2 * k + 1;
+		}
+		return k;
+	}
+
+	//↓↓↓ наименьший в правом поддереве, иначе -- подъем, пока k правый ребенок
+	inline std::size_t eytzinger_next(std::size_t k, std::size_t n) {
+		if (2 * k + 1 <= n) {
+			k = 2 * k + 1;
+			while (2 * k <= n) {
+				k = 2 * k;
+			}
+			return k;
+		}
+		while (k & 1) {
+			k >>= 1;
+		}
+		return k >> 1;
+	}
+
+	inline std::size_t eytzinger_prev(std::size_t k, std::size_t n) {
+		if (k == 0) {
+			return eytzinger_last(n);
+		}
+		if (2 * k <= n) {
+			k = 2 * k;
+			while (2 * k + 1 <= n) {
+				k = 2 * k + 1;
+			}
+			return k;
+		}
+		while (!(k & 1)) {
+			k >>= 1;
+		}
+		return k >> 1;
+	}
+
+	template<typename T>
+	class Eytzinger_iterator {
+		public:
+			typedef T												value_type;
+			typedef T*												pointer;
+			typedef T&												reference;
+			typedef std::bidirectional_iterator_tag					iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+
+			typedef typename ft::remove_const<value_type>::type		clear_value_type;
+
+		private:
+			T*				base_;
+			std::size_t		index_;
+			std::size_t		size_;
+
+		public:
+			Eytzinger_iterator() : base_(0), index_(0), size_(0) {}
+
+			Eytzinger_iterator(T* base, std::size_t index, std::size_t size) : base_(base), index_(index), size_(size) {}
+
+			Eytzinger_iterator(const Eytzinger_iterator<clear_value_type>& rhs) :
+					base_(rhs.base()), index_(rhs.index()), size_(rhs.size()) {}
+
+			Eytzinger_iterator& operator=(const Eytzinger_iterator<clear_value_type>& rhs) {
+				base_ = rhs.base();
+				index_ = rhs.index();
+				size_ = rhs.size();
+				return *this;
+			}
+
+			T* base() const {
+				return base_;
+			}
+
+			std::size_t index() const {
+				return index_;
+			}
+
+			std::size_t size() const {
+				return size_;
+			}
+
+			reference operator*() const {
+				return base_[index_];
+			}
+
+			pointer operator->() const {
+				return &(operator*());
+			}
+
+			Eytzinger_iterator& operator++() {
+				index_ = eytzinger_next(index_, size_);
+				return (*this);
+			}
+
+			Eytzinger_iterator operator++(int) {
+				Eytzinger_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+
+			Eytzinger_iterator& operator--() {
+				index_ = eytzinger_prev(index_, size_);
+				return (*this);
+			}
+
+			Eytzinger_iterator operator--(int) {
+				Eytzinger_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+	};
+
+	template<typename T1, typename T2>
+	bool operator==(const Eytzinger_iterator<T1>& lhs, const Eytzinger_iterator<T2>& rhs) {
+		return lhs.index() == rhs.index();
+	}
+
+	template<typename T1, typename T2>
+	bool operator!=(const Eytzinger_iterator<T1>& lhs, const Eytzinger_iterator<T2>& rhs) {
+		return !(lhs == rhs);
+	}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef HASH_ITERATOR_HPP
+# define HASH_ITERATOR_HPP
+
+# include <cstddef>
+# include <iterator>
+# include "RBTree_iterator.hpp"
+
+namespace ft {
+
+	//↓↓↓ итератор хеш-таблицы (tree/hash_table.hpp): управляющий байт и ячейка значения.
+	// Шаг пропускает пустые ячейки; после последнего управляющего байта таблицы стоит
+	// сторожевой байт, на нем обход останавливается -- это end(). Значения не переезжают
+	// до рехеширования, поэтому erase портит только итераторы на удаленный элемент
+	template<typename T>
+	class Hash_iterator {
+		public:
+			typedef T												value_type;
+			typedef T*												pointer;
+			typedef T&												reference;
+			typedef std::forward_iterator_tag						iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+
+			typedef typename ft::remove_const<value_type>::type		clear_value_type;
+
+			//↓↓↓ управляющий байт пустой ячейки (у занятой старший бит сброшен)
+			static const unsigned char ctrl_empty = 0x80;
+
+		private:
+			const unsigned char*	ctrl_;
+			T*						slot_;
+
+		public:
+			Hash_iterator() : ctrl_(0), slot_(0) {}
+
+			Hash_iterator(const unsigned char* ctrl, T* slot) : ctrl_(ctrl), slot_(slot) {}
+
+			Hash_iterator(const Hash_iterator<clear_value_type>& rhs) : ctrl_(rhs.ctrl()), slot_(rhs.slot()) {}
+
+			Hash_iterator& operator=(const Hash_iterator<clear_value_type>& rhs) {
+				ctrl_ = rhs.ctrl();
+				slot_ = rhs.slot();
+				return *this;
+			}
+
+			const unsigned char* ctrl() const {
+				return ctrl_;
+			}
+
+			T* slot() const {
+				return slot_;
+			}
+
+			reference operator*() const {
+				return *slot_;
+			}
+
+			pointer operator->() const {
+				return slot_;
+			}
+
+			Hash_iterator& operator++() {
+				do {
+					++ctrl_;
+					++slot_;
+				} while (*ctrl_ == ctrl_empty);
+				return (*this);
+			}
+
+			Hash_iterator operator++(int) {
+				Hash_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+	};
+
+	template<typename T1, typename T2>
+	bool operator==(const Hash_iterator<T1>& lhs, const Hash_iterator<T2>& rhs) {
+		return lhs.ctrl() == rhs.ctrl();
+	}
+
+	template<typename T1, typename T2>
+	bool operator!=(const Hash_iterator<T1>& lhs, const Hash_iterator<T2>& rhs) {
+		return !(lhs == rhs);
+	}
+
+} // namespace ft
+
+#endif
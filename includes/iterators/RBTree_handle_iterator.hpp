@@ -0,0 +1,93 @@
+#ifndef RBTREE_HANDLE_ITERATOR_HPP
+# define RBTREE_HANDLE_ITERATOR_HPP
+
+# include "RBTree_iterator.hpp"
+
+namespace ft {
+
+	//↓↓↓ итератор деревьев, узел которых -- дескриптор, а не RB_Node_base*:
+	// индекс в массиве (RBTree_indexed) или узел без родителя (RBTree_persistent).
+	// Шаги в порядке обхода делает само дерево: next_node/prev_node, замкнутые через nil.
+	// У RBTree_indexed адрес узла не хранится, поэтому итератор переживает рост массива.
+	template<typename T, typename Tree>
+	class RBTree_handle_iterator {
+		public:
+			typedef T												value_type;
+			typedef T*												pointer;
+			typedef T&												reference;
+			typedef std::bidirectional_iterator_tag					iterator_category;
+			typedef std::ptrdiff_t									difference_type;
+
+			typedef typename ft::remove_const<value_type>::type		clear_value_type;
+			typedef typename Tree::node_pointer						node_ptr;
+
+		private:
+			const Tree*	tree_;
+			node_ptr	node_;
+
+		public:
+			RBTree_handle_iterator() : tree_(0), node_(0) {}
+
+			RBTree_handle_iterator(const Tree* tree, node_ptr node) : tree_(tree), node_(node) {}
+
+			RBTree_handle_iterator(const RBTree_handle_iterator<clear_value_type, Tree>& rhs) :
+					tree_(rhs.tree()), node_(rhs.node()) {}
+
+			RBTree_handle_iterator& operator=(const RBTree_handle_iterator<clear_value_type, Tree>& rhs) {
+				tree_ = rhs.tree();
+				node_ = rhs.node();
+				return *this;
+			}
+
+			const Tree* tree() const {
+				return tree_;
+			}
+
+			node_ptr node() const {
+				return node_;
+			}
+
+			reference operator*() const {
+				return const_cast<clear_value_type&>(tree_->node_value(node_));
+			}
+
+			pointer operator->() const {
+				return &(operator*());
+			}
+
+			RBTree_handle_iterator& operator++() {
+				node_ = tree_->next_node(node_);
+				return (*this);
+			}
+
+			RBTree_handle_iterator operator++(int) {
+				RBTree_handle_iterator tmp(*this);
+				node_ = tree_->next_node(node_);
+				return (tmp);
+			}
+
+			RBTree_handle_iterator& operator--() {
+				node_ = tree_->prev_node(node_);
+				return (*this);
+			}
+
+			RBTree_handle_iterator operator--(int) {
+				RBTree_handle_iterator tmp(*this);
+				node_ = tree_->prev_node(node_);
+				return (tmp);
+			}
+	};
+
+	template<typename T1, typename T2, typename Tree>
+	bool operator==(const RBTree_handle_iterator<T1, Tree>& lhs, const RBTree_handle_iterator<T2, Tree>& rhs) {
+		return lhs.node() == rhs.node();
+	}
+
+	template<typename T1, typename T2, typename Tree>
+	bool operator!=(const RBTree_handle_iterator<T1, Tree>& lhs, const RBTree_handle_iterator<T2, Tree>& rhs) {
+		return lhs.node() != rhs.node();
+	}
+
+} // namespace ft
+
+#endif
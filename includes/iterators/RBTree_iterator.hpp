@@ -8,7 +8,61 @@ namespace ft {
 	template<typename T> struct remove_const {typedef T type; };
 	template<typename T> struct remove_const<const T> : remove_const<T>{};
 
-	template<typename T>
+	//↓↓↓ шаг по дереву в порядке обхода. Обход замкнут через nil_: next(nil_) -- первый узел,
+	// prev(nil_) -- последний, prev(первый) -- nil_, поэтому прямой и обратный итераторы
+	// пользуются одними и теми же шагами. NodeUpdate::threaded -- константа времени компиляции,
+	// лишняя ветка выбрасывается.
+	template<typename NodeUpdate>
+	struct RBTree_step {
+		typedef RB_Node_base*		node_ptr;
+
+		static node_ptr next(node_ptr node) {
+			if (NodeUpdate::threaded) {
+				return static_cast<RB_Thread_base*>(node)->next_;
+			}
+			if (node->is_nil()) {
+				return node->left_;
+			}
+			if (!node->right_->is_nil()) {
+				node = node->right_;
+				while (!node->left_->is_nil()) {
+					node = node->left_;
+				}
+				return node;
+			}
+			node_ptr tmp = node->parent();
+			while (!tmp->is_nil() && node == tmp->right_) {
+				node = tmp;
+				tmp = tmp->parent();
+			}
+			return tmp;
+		}
+
+		static node_ptr prev(node_ptr node) {
+			if (NodeUpdate::threaded) {
+				return static_cast<RB_Thread_base*>(node)->prev_;
+			}
+			if (node->is_nil()) {
+				return node->parent();
+			}
+			if (!node->left_->is_nil()) {
+				node = node->left_;
+				while (!node->right_->is_nil()) {
+					node = node->right_;
+				}
+				return node;
+			}
+			node_ptr tmp = node->parent();
+			while (!tmp->is_nil() && node == tmp->left_) {
+				node = tmp;
+				tmp = tmp->parent();
+			}
+			return tmp;
+		}
+	};
+
+	//↓↓↓ NodeUpdate -- политика узла дерева: от нее зависят тип узла и способ шага (см. rb_node.hpp)
+	template<typename T, typename NodeUpdate = ft::null_node_update>
 	class RBTree_iterator {		
 		public:
 			typedef T															value_type;
@@ -18,8 +72,8 @@ namespace ft {
 			typedef std::ptrdiff_t												difference_type;
 			
 			typedef typename ft::remove_const<value_type>::type					clear_value_type;
-			typedef RB_Node<clear_value_type>									Node;
-			typedef Node*														node_ptr;
+			typedef typename NodeUpdate::template node<clear_value_type>::type	Node;
+			typedef RB_Node_base*												node_ptr;
 
 		private:
 			node_ptr node_;
@@ -29,12 +83,12 @@ namespace ft {
 			
 			RBTree_iterator(node_ptr node): node_(static_cast<node_ptr>(node)) {}
 			
-			RBTree_iterator(const RBTree_iterator<clear_value_type>& rhs) {
+			RBTree_iterator(const RBTree_iterator<clear_value_type, NodeUpdate>& rhs) {
 				*this = rhs;
 			}
 
-			RBTree_iterator& operator=(const RBTree_iterator<clear_value_type>& rhs) {
-				node_ = rhs.node_;
+			RBTree_iterator& operator=(const RBTree_iterator<clear_value_type, NodeUpdate>& rhs) {
+				node_ = rhs.node();
 				return *this;
 			}
 
@@ -43,7 +97,7 @@ namespace ft {
 			}
 
 			reference operator*() const {
-				return *(node_->value_);
+				return static_cast<Node*>(node_)->value_;
 			}
 
 			pointer operator->() const {
@@ -51,85 +105,120 @@ namespace ft {
 			}
 
 			RBTree_iterator& operator++() {
-				next();
+				node_ = RBTree_step<NodeUpdate>::next(node_);
 				return (*this);
 			}
 
 			RBTree_iterator operator++(int) {
 				RBTree_iterator tmp(*this);
-				next();
+				node_ = RBTree_step<NodeUpdate>::next(node_);
 				return (tmp);
 			}
 
 			RBTree_iterator& operator--() {
-				prev();
+				node_ = RBTree_step<NodeUpdate>::prev(node_);
 				return (*this);
 			}
 
 			RBTree_iterator operator--(int) {
 				RBTree_iterator tmp(*this);
-				prev();
+				node_ = RBTree_step<NodeUpdate>::prev(node_);
 				return (tmp);
 			}
+	}; //RBTree_iterator
+
+	template<typename Iterator1, typename Iterator2, typename NodeUpdate>
+	bool operator==(const RBTree_iterator<Iterator1, NodeUpdate>& lhs, const RBTree_iterator<Iterator2, NodeUpdate>& rhs) {
+		return (lhs.node() == rhs.node());
+	}
+
+	template<typename Iterator1, typename Iterator2, typename NodeUpdate>
+		bool operator!=(const RBTree_iterator<Iterator1, NodeUpdate>& lhs, const RBTree_iterator<Iterator2, NodeUpdate>& rhs) {
+		return (lhs.node() != rhs.node());
+	}
+
+	//↓↓↓ обратный итератор дерева хранит узел текущего элемента, а не следующий за ним,
+	// поэтому * и -> стоят столько же, сколько у прямого итератора (ft::reverse_iterator
+	// делает --tmp на каждое разыменование). rend() -- nil_, base() -- следующий узел.
+	template<typename T, typename NodeUpdate = ft::null_node_update>
+	class RBTree_reverse_iterator {
+		public:
+			typedef T															value_type;
+			typedef T*															pointer;
+			typedef T&															reference;
+			typedef std::bidirectional_iterator_tag								iterator_category;
+			typedef std::ptrdiff_t												difference_type;
+
+			typedef typename ft::remove_const<value_type>::type					clear_value_type;
+			typedef typename NodeUpdate::template node<clear_value_type>::type	Node;
+			typedef RB_Node_base*												node_ptr;
+			typedef RBTree_iterator<T, NodeUpdate>								iterator_type;
 
 		private:
-			node_ptr maximum(node_ptr node) const {
-				while (node->right_->type != nil) {
-					node = node->right_;
-				}
-				return node;
+			node_ptr node_;
+
+		public:
+			RBTree_reverse_iterator() {}
+
+			RBTree_reverse_iterator(node_ptr node): node_(node) {}
+
+			explicit RBTree_reverse_iterator(const iterator_type& it): node_(RBTree_step<NodeUpdate>::prev(it.node())) {}
+
+			RBTree_reverse_iterator(const RBTree_reverse_iterator<clear_value_type, NodeUpdate>& rhs) {
+				*this = rhs;
 			}
 
-			node_ptr minimum(node_ptr node) const {
-				while (node->left_->type_ != nil) {
-					node = node->left_;
-				}
-				return node;
+			RBTree_reverse_iterator& operator=(const RBTree_reverse_iterator<clear_value_type, NodeUpdate>& rhs) {
+				node_ = rhs.node();
+				return *this;
 			}
 
-			void next() {
-				if (node_->type_ == nil) {
-					return ;
-				}
-				if (node_->right_->type_ != nil) {
-					node_ = minimum(node_->right_);
-					return ;
-				}
-				node_ptr tmp = node_->parent_;
-				while (tmp->type_ != nil && node_ == tmp->right_) {
-					node_ = tmp;
-					tmp = tmp->parent_;
-				}
-				node_ = tmp;
+			node_ptr node() const {
+				return node_;
 			}
 
-			void prev() {
-				if (node_->type_ == nil) {
-					node_ = node_->parent_;
-					return ;
-				}
-				if (node_->type_ != nil && node_->left_->type_ != nil) {
-					node_ = maximum(node_->left_);
-					return ;
-				}
-				node_ptr tmp = node_->parent_;
-				while (tmp->type_!= nil && node_ == tmp->left_) {
-					node_ = tmp;
-					tmp = tmp->parent_;
-				}
-				if (tmp->type_ != nil) {
-					node_ = tmp;
-				}
+			iterator_type base() const {
+				return iterator_type(RBTree_step<NodeUpdate>::next(node_));
 			}
-	}; //RBTree_iterator
 
-	template<typename Iterator1, typename Iterator2>
-	bool operator==(const RBTree_iterator<Iterator1>& lhs, const RBTree_iterator<Iterator2>& rhs) {
+			reference operator*() const {
+				return static_cast<Node*>(node_)->value_;
+			}
+
+			pointer operator->() const {
+				return &(operator*());
+			}
+
+			RBTree_reverse_iterator& operator++() {
+				node_ = RBTree_step<NodeUpdate>::prev(node_);
+				return (*this);
+			}
+
+			RBTree_reverse_iterator operator++(int) {
+				RBTree_reverse_iterator tmp(*this);
+				node_ = RBTree_step<NodeUpdate>::prev(node_);
+				return (tmp);
+			}
+
+			RBTree_reverse_iterator& operator--() {
+				node_ = RBTree_step<NodeUpdate>::next(node_);
+				return (*this);
+			}
+
+			RBTree_reverse_iterator operator--(int) {
+				RBTree_reverse_iterator tmp(*this);
+				node_ = RBTree_step<NodeUpdate>::next(node_);
+				return (tmp);
+			}
+	}; //RBTree_reverse_iterator
+
+	template<typename Iterator1, typename Iterator2, typename NodeUpdate>
+	bool operator==(const RBTree_reverse_iterator<Iterator1, NodeUpdate>& lhs, const RBTree_reverse_iterator<Iterator2, NodeUpdate>& rhs) {
 		return (lhs.node() == rhs.node());
 	}
 
-	template<typename Iterator1, typename Iterator2>
-		bool operator!=(const RBTree_iterator<Iterator1>& lhs, const RBTree_iterator<Iterator2>& rhs) {
+	template<typename Iterator1, typename Iterator2, typename NodeUpdate>
+	bool operator!=(const RBTree_reverse_iterator<Iterator1, NodeUpdate>& lhs, const RBTree_reverse_iterator<Iterator2, NodeUpdate>& rhs) {
 		return (lhs.node() != rhs.node());
 	}
 
@@ -144,7 +233,7 @@ namespace ft {
 			
 			typedef typename ft::remove_const<value_type>::type					clear_value_type;
 			typedef RB_Node<clear_value_type>									Node;
-			typedef const Node*													node_ptr;
+			typedef const RB_Node_base*											node_ptr;
 
 		private:
 			node_ptr node_;
@@ -159,7 +248,7 @@ namespace ft {
 			}
 
 			RBTree_const_iterator& operator=(const RBTree_iterator<clear_value_type>& rhs) {
-				node_ = rhs.node_();
+				node_ = rhs.node();
 				return *this;
 			}
 
@@ -168,11 +257,11 @@ namespace ft {
 			}
 
 			reference operator*() const {
-				return *(node_->value_);
+				return static_cast<const Node*>(node_)->value_;
 			}
 
 			pointer operator->() const {
-				return node_->value_;
+				return &(operator*());
 			}
 
 			RBTree_const_iterator& operator++() {
@@ -209,50 +298,50 @@ namespace ft {
 
 		private:
 			node_ptr maximum(node_ptr node) const {
-				while (node->right_->type != nil) {
+				while (!node->right_->is_nil()) {
 					node = node->right_;
 				}
 				return node;
 			}
 
 			node_ptr minimum(node_ptr node) const {
-				while (node->left_->type_ != nil) {
+				while (!node->left_->is_nil()) {
 					node = node->left_;
 				}
 				return node;
 			}
 
 			void next() {
-				if (node_->type_ == nil) {
+				if (node_->is_nil()) {
 					return ;
 				}
-				if (node_->right_->type_ != nil) {
+				if (!node_->right_->is_nil()) {
 					node_ = minimum(node_->right_);
 					return ;
 				}
-				node_ptr tmp = node_->parent_;
-				while (tmp->type_ != nil && node_ == tmp->right_) {
+				node_ptr tmp = node_->parent();
+				while (!tmp->is_nil() && node_ == tmp->right_) {
 					node_ = tmp;
-					tmp = tmp->parent_;
+					tmp = tmp->parent();
 				}
 				node_ = tmp;
 			}
 
 			void prev() {
-				if (node_->type_ == nil) {
-					node_ = node_->parent_;
+				if (node_->is_nil()) {
+					node_ = node_->parent();
 					return ;
 				}
-				if (node_->type_ != nil && node_->left_->type_ != nil) {
+				if (!node_->is_nil() && !node_->left_->is_nil()) {
 					node_ = maximum(node_->left_);
 					return ;
 				}
-				node_ptr tmp = node_->parent_;
-				while (tmp->type_!= nil && node_ == tmp->left_) {
+				node_ptr tmp = node_->parent();
+				while (!tmp->is_nil() && node_ == tmp->left_) {
 					node_ = tmp;
-					tmp = tmp->parent_;
+					tmp = tmp->parent();
 				}
-				if (tmp->type_ != nil) {
+				if (!tmp->is_nil()) {
 					node_ = tmp;
 				}
 			}
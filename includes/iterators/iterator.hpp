@@ -1,6 +1,9 @@
 #ifndef ITERATOR_HPP
 # define ITERATOR_HPP
 
+# include <cstddef>
+# include <iterator>
+
 namespace ft {
 
 	template<typename Iterator>
@@ -93,6 +93,11 @@ namespace ft {
 			}
 	};
 
+	template <typename Iterator1, typename Iterator2>
+	std::ptrdiff_t operator-(const random_access_iterator<Iterator1>& lhs, const random_access_iterator<Iterator2>& rhs) {
+		return lhs.base() - rhs.base();
+	}
+
 	template <typename Iterator1, typename Iterator2>
 	bool operator==(const random_access_iterator<Iterator1>& lhs, const random_access_iterator<Iterator2>& rhs) {
 		return lhs.base() == rhs.base();
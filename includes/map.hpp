@@ -13,14 +13,16 @@
 #ifndef MAP_HPP
 # define MAP_HPP
 
-# include "tree/rb_tree.hpp"
+# include "tree/rb_tree_indexed.hpp"
+# include "tree/rb_tree_persistent.hpp"
 # include <memory>
 # include "utils/utils.hpp"
 # include <functional>
 
 namespace ft {
 	
-	template<typename Key, typename T, typename Compare = std::less<Key>, typename Allocator = std::allocator<ft::pair<const Key, T> > >
+	template<typename Key, typename T, typename Compare = std::less<Key>, typename Allocator = std::allocator<ft::pair<const Key, T> >,
+			typename NodeUpdate = ft::null_node_update, typename Balance = ft::red_black_balance>
 	class map {
 		public:
 // types:
@@ -40,6 +42,31 @@ namespace ft {
 					bool operator()(const value_type& x, const value_type& y) const {
 						return comp(x.first, y.first);
 						}
+
+					//↓↓↓ сравнение элемента с ключом: дерево ищет по ключу без временной пары
+					template<typename K>
+					bool operator()(const value_type& x, const K& y) const {
+						return comp(x.first, y);
+					}
+
+					template<typename K>
+					bool operator()(const K& x, const value_type& y) const {
+						return comp(x, y.first);
+					}
+
+					//↓↓↓ трехстороннее сравнение по ключам для спусков дерева (utils/three_way.hpp)
+					typedef ft::three_way_compare<Compare, Key>				key_three_way;
+
+					template<typename L, typename R>
+					int three_way(const L& x, const R& y) const {
+						return key_three_way::compare(comp, key_of(x), key_of(y));
+					}
+
+				private:
+					static const Key& key_of(const value_type& x) { return x.first; }
+
+					template<typename K>
+					static const K& key_of(const K& x) { return x; }
 			};
 
 			typedef typename	Allocator::reference					reference;
@@ -48,14 +75,21 @@ namespace ft {
 			typedef typename	Allocator::size_type					size_type;
 			typedef typename	Allocator::pointer						pointer;
 			typedef typename	Allocator::const_pointer				const_pointer;
-			typedef RBTree<value_type, value_compare, allocator_type>	tree_type;
+			typedef typename ft::tree_select<value_type, value_compare, allocator_type, NodeUpdate, Balance>::type	tree_type;
 			typedef typename tree_type::iterator						iterator;
 			typedef typename tree_type::const_iterator					const_iterator;
 			typedef typename tree_type::reverse_iterator				reverse_iterator;
 			typedef typename tree_type::const_reverse_iterator			const_reverse_iterator;
+			typedef typename tree_type::node_type						node_type;
+			typedef typename tree_type::insert_return_type				insert_return_type;
 
 		private:
 			tree_type		tree_;
+
+			//↓↓↓ mapped_type() строится, только когда дерево конструирует новый элемент
+			struct default_mapped {
+				operator mapped_type() const { return mapped_type(); }
+			};
 		
 // construct/copy/destroy:
 		public:
@@ -71,9 +105,7 @@ namespace ft {
 				insert(first, last);
 			}
 
-			map(const map& rhs) : tree_(tree_type(rhs.tree_)) {
-				*this = rhs;
-			}
+			map(const map& rhs) : tree_(rhs.tree_) {}
 
 			map& operator=(const map& rhs) {
 				if (this == &rhs) {
@@ -85,6 +117,8 @@ namespace ft {
 
 			~map() {}
 
+			allocator_type get_allocator() const { return tree_.get_allocator(); }
+
 // iterators:
 			iterator begin() { return tree_.begin(); }
 			const_iterator begin() const { return tree_.begin(); }
@@ -101,8 +135,20 @@ namespace ft {
 			size_type max_size() const { return tree_.max_size(); }
 
 // element access:
+			//↓↓↓ один спуск: при попадании пара не строится и не копируется,
+			// mapped_type() конструируется только при промахе
 			mapped_type& operator[](const key_type& rhs) {
-				return (*((this->insert(ft::make_pair(rhs, mapped_type()))).first)).second; //UB?
+				return tree_.emplace_value(rhs, default_mapped()).second;
+			}
+
+			//↓↓↓ try_emplace: если ключ уже есть, ничего не конструируется и не копируется;
+			// иначе value_type(k, obj) строится прямо в новом узле
+			pair<iterator, bool> try_emplace(const key_type& k) {
+				return tree_.try_emplace(k, default_mapped());
+			}
+
+			pair<iterator, bool> try_emplace(const key_type& k, const mapped_type& obj) {
+				return tree_.try_emplace(k, obj);
 			}
 
 // modifiers:
@@ -111,27 +157,24 @@ namespace ft {
 			}
 
 			iterator insert(iterator position, const value_type& x) {
-				(void)position;
-				return tree_.insert_node(x).first;
+				return tree_.insert_node(position.node(), x).first;
 			}
 
 			template<typename InputIterator>
 			void insert(InputIterator first, InputIterator last) {
-				while (first!=last)
-					tree_.insert(*first++);
+				tree_.insert_range(first, last);
 			}
 
 			void erase(iterator position) {
-				tree_.delete_node(*position);
+				tree_.erase(position);
 			}
 
 			size_type erase(const Key& x) {
-				return tree_.delete_node(ft::make_pair(x, mapped_type()));
+				return tree_.delete_node(x);
 			}
 
 			void erase(iterator first, iterator last) {
-				while (first!=last)
-					tree_.delete_node(*first++);
+				tree_.erase(first, last);
 			}
 
 			void swap(map & other) {
@@ -142,61 +185,116 @@ namespace ft {
 				tree_.clear();
 			}
 
+//node handles (RBTree, tree/rb_node_handle.hpp): узел переходит в другой контейнер
+// без выделения памяти и копирования значения; insert забирает узел из nh
+			node_type extract(iterator position) { return tree_.extract(position); }
+			node_type extract(const key_type& x) { return tree_.extract(x); }
+			insert_return_type insert(const node_type& nh) { return tree_.insert_handle(nh); }
+			iterator insert(iterator position, const node_type& nh) { return tree_.insert_handle(position.node(), nh); }
+			void merge(map& source) { tree_.merge(source.tree_); }
+
 // observers:
-			key_compare key_comp() const { return value_comp(); }
+			key_compare key_comp() const { return value_comp().comp; }
 			value_compare value_comp() const { return tree_.value_comp(); }
 
 //map operations:
-			iterator	find(const Key& x) { return tree_.find(ft::make_pair(x, mapped_type()));}
-			const_iterator find(const key_type& x) const { return tree_.find(ft::make_pair(x, mapped_type())); }
-			size_type count(const Key& x) const { return tree_.count(ft::make_pair(x, mapped_type())); }
-			iterator lower_bound(const key_type& x) { return tree_.lower_bound(ft::make_pair(x, mapped_type())); }	
-			const_iterator lower_bound(const key_type& x) const { return tree_.lower_bound(ft::make_pair(x, mapped_type())); }	
-			iterator upper_bound(const key_type& x) { return tree_.upper_bound(ft::make_pair(x, mapped_type())); }	
-			const_iterator upper_bound(const key_type& x) const { return tree_.upper_bound(ft::make_pair(x, mapped_type())); }
-			pair<iterator, iterator> equal_range(const key_type & x) { return tree_.equal_range(ft::make_pair(x, mapped_type())); }	
-			pair<const_iterator, const_iterator> equal_range(const key_type & x) const { return tree_.equal_range(ft::make_pair(x, mapped_type())); }	
-
-
-			template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc>
-			friend bool operator==(const map<t_Key, t_T, t_Compare, t_Alloc>& lhs, const map<t_Key, t_T, t_Compare, t_Alloc>& rhs) {
+			iterator find(const key_type& x) { return tree_.find(x); }
+			const_iterator find(const key_type& x) const { return tree_.find(x); }
+			size_type count(const key_type& x) const { return tree_.count(x); }
+			iterator lower_bound(const key_type& x) { return tree_.lower_bound(x); }
+			const_iterator lower_bound(const key_type& x) const { return tree_.lower_bound(x); }
+			iterator upper_bound(const key_type& x) { return tree_.upper_bound(x); }
+			const_iterator upper_bound(const key_type& x) const { return tree_.upper_bound(x); }
+			pair<iterator, iterator> equal_range(const key_type& x) { return tree_.equal_range(x); }
+			pair<const_iterator, const_iterator> equal_range(const key_type& x) const { return tree_.equal_range(x); }
+
+//batched lookup (RBTree): для каждого ключа [first, last) в out пишется find(ключ);
+// спуски идут пачками с предвыборкой узлов, итератор ключей -- прямой
+			template<typename ForwardIterator, typename OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) {
+				return tree_.find_batch(first, last, out);
+			}
+			template<typename ForwardIterator, typename OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+				return tree_.find_batch(first, last, out);
+			}
+
+//heterogeneous lookup (Compare::is_transparent, e.g. ft::less<>):
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			find(const K& x) { return tree_.find(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			find(const K& x) const { return tree_.find(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, size_type>::type
+			count(const K& x) const { return tree_.count(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			lower_bound(const K& x) { return tree_.lower_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			lower_bound(const K& x) const { return tree_.lower_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			upper_bound(const K& x) { return tree_.upper_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			upper_bound(const K& x) const { return tree_.upper_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, pair<iterator, iterator> >::type
+			equal_range(const K& x) { return tree_.equal_range(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, pair<const_iterator, const_iterator> >::type
+			equal_range(const K& x) const { return tree_.equal_range(x); }
+
+//order statistics (NodeUpdate = ft::order_statistic_node_update):
+			iterator nth(size_type k) { return tree_.nth(k); }
+			const_iterator nth(size_type k) const { return tree_.nth(k); }
+			size_type rank(const key_type& x) const { return tree_.rank(x); }
+			difference_type distance(const_iterator first, const_iterator last) const { return tree_.distance(first, last); }
+
+//set algebra (RBTree): split переносит в greater элементы не меньше x,
+// join и set_union забирают узлы аргумента; при совпадении ключей остается элемент *this
+			void split(const key_type& x, map& greater) { tree_.split(x, greater.tree_); }
+			void join(map& greater) { tree_.join(greater.tree_); }
+			void set_union(map& other) { tree_.set_union(other.tree_); }
+			void set_intersection(const map& other) { tree_.set_intersection(other.tree_); }
+			void set_difference(const map& other) { tree_.set_difference(other.tree_); }
+
+//debugging:
+			//↓↓↓ проверка инвариантов дерева за O(n), для тестов
+			bool verify() const { return tree_.verify(); }
+
+
+			friend bool operator==(const map& lhs, const map& rhs) {
 				return lhs.tree_ == rhs.tree_;
 			}
 
-			template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc>
-			friend bool operator!=(const map<t_Key, t_T, t_Compare, t_Alloc>& lhs,
-					const map<t_Key, t_T, t_Compare, t_Alloc>& rhs) {
+			friend bool operator!=(const map& lhs, const map& rhs) {
 				return !(lhs == rhs);
 			}
 
-			template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc>
-			friend bool operator<(const map<t_Key, t_T, t_Compare, t_Alloc>& lhs,
-					const map<t_Key, t_T, t_Compare, t_Alloc>& rhs) {
+			friend bool operator<(const map& lhs, const map& rhs) {
 				return lhs.tree_ < rhs.tree_;
 			}
 			
-			template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc>
-			friend bool operator>(const map<t_Key, t_T, t_Compare, t_Alloc>& lhs,
-					const map<t_Key, t_T, t_Compare, t_Alloc>& rhs) {
+			friend bool operator>(const map& lhs, const map& rhs) {
 				return rhs < lhs;
 			}
 
-			template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc>
-			friend bool operator<=(const map<t_Key, t_T, t_Compare, t_Alloc>& lhs,
-					const map<t_Key, t_T, t_Compare, t_Alloc>& rhs) {
+			friend bool operator<=(const map& lhs, const map& rhs) {
 				return !(lhs > rhs);
 			}
 
-			template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc>
-			friend bool operator>=(const map<t_Key, t_T, t_Compare, t_Alloc>& lhs,
-					const map<t_Key, t_T, t_Compare, t_Alloc>& rhs) {
+			friend bool operator>=(const map& lhs, const map& rhs) {
 				return !(lhs < rhs);
 			}
 	}; //map
 
 // specialized algorithms:
-	template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc>
-	void swap(const map<t_Key, t_T, t_Compare, t_Alloc>& lhs, const map<t_Key, t_T, t_Compare, t_Alloc>& rhs) {
+	template<typename t_Key, typename t_T, typename t_Compare, typename t_Alloc, typename t_Update, typename t_Balance>
+	void swap(map<t_Key, t_T, t_Compare, t_Alloc, t_Update, t_Balance>& lhs, map<t_Key, t_T, t_Compare, t_Alloc, t_Update, t_Balance>& rhs) {
 		lhs.swap(rhs);
 	}
 
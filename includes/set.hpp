@@ -15,12 +15,14 @@
 # define SET_HPP
 
 # include <memory>
-# include "tree/rb_tree.hpp" 
+# include "tree/rb_tree_indexed.hpp"
+# include "tree/rb_tree_persistent.hpp"
 # include "utils/utils.hpp"
 
 namespace ft
 {
-	template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key> >
+	template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>,
+			typename NodeUpdate = ft::null_node_update, typename Balance = ft::red_black_balance>
 	class set {
 		public:
 			typedef				Key										key_type;
@@ -34,11 +36,13 @@ namespace ft
 			typedef typename 	Allocator::size_type					size_type;		
 			typedef typename 	Allocator::pointer						pointer;
 			typedef typename 	Allocator::const_pointer				const_pointer;
-			typedef RBTree<value_type, key_compare, allocator_type>		tree_type;
+			typedef typename ft::tree_select<value_type, key_compare, allocator_type, NodeUpdate, Balance>::type	tree_type;
 			typedef typename	tree_type::iterator						iterator;
 			typedef typename	tree_type::const_iterator				const_iterator;
 			typedef typename	tree_type::reverse_iterator				reverse_iterator;
 			typedef typename	tree_type::const_reverse_iterator		const_reverse_iterator;
+			typedef typename	tree_type::node_type					node_type;
+			typedef typename	tree_type::insert_return_type			insert_return_type;
 
 		private:
 			tree_type tree_;
@@ -87,22 +91,20 @@ namespace ft
 
 // modifiers:
 			ft::pair<iterator, bool> insert( const value_type& x) {
-				return tree_.insert(x);
+				return tree_.insert_node(x);
 			}
 
 			iterator insert( iterator position, const value_type& x) {
-				(void)position;
-				return tree_.insert_node(x).first;
+				return tree_.insert_node(position.node(), x).first;
 			}
 
 			template<typename InputIterator>
 			void insert(InputIterator first, InputIterator last) {
-				while (first!=last)
-					tree_.insert_node(*first++);
+				tree_.insert_range(first, last);
 			}
 
 			void erase(iterator position) {
-				tree_.delete_node(*position);
+				tree_.erase(position);
 			}
 
 			size_type erase(const Key& x) {
@@ -110,8 +112,7 @@ namespace ft
 			}
 
 			void erase(iterator first, iterator last) {
-				while (first!=last)
-					tree_.delete_node(*first++);
+				tree_.erase(first, last);
 			}
 
 			void swap(set& rhs) {
@@ -122,53 +123,117 @@ namespace ft
 				tree_.clear();
 			}	
 
+//node handles (RBTree, tree/rb_node_handle.hpp): узел переходит в другой контейнер
+// без выделения памяти и копирования значения; insert забирает узел из nh
+			node_type extract(iterator position) { return tree_.extract(position); }
+			node_type extract(const key_type& x) { return tree_.extract(x); }
+			insert_return_type insert(const node_type& nh) { return tree_.insert_handle(nh); }
+			iterator insert(iterator position, const node_type& nh) { return tree_.insert_handle(position.node(), nh); }
+			void merge(set& source) { tree_.merge(source.tree_); }
+
 // observers:
 			value_compare value_comp() const { return (tree_.value_comp()); }
 			key_compare key_comp() const { return (value_comp()); }
 
 // set operations:
 			iterator find(const key_type& x) { return tree_.find(x); }
+			const_iterator find(const key_type& x) const { return tree_.find(x); }
 			size_type count(const key_type &x) const { return tree_.count(x); }
 
 			iterator lower_bound(const key_type& x) { return tree_.lower_bound(x); }
+			const_iterator lower_bound(const key_type& x) const { return tree_.lower_bound(x); }
 			iterator upper_bound(const key_type& x) { return tree_.upper_bound(x); }
+			const_iterator upper_bound(const key_type& x) const { return tree_.upper_bound(x); }
 			pair<iterator, iterator> equal_range(const key_type & x) { return tree_.equal_range(x); }
-
-			template<typename t_Key, typename t_Compare, typename t_Alloc>
-			friend bool operator==(const set<t_Key, t_Compare, t_Alloc>& lhs, const set<t_Key, t_Compare, t_Alloc>& rhs) {
+			pair<const_iterator, const_iterator> equal_range(const key_type & x) const { return tree_.equal_range(x); }
+
+// batched lookup (RBTree): для каждого ключа [first, last) в out пишется find(ключ);
+// спуски идут пачками с предвыборкой узлов, итератор ключей -- прямой
+			template<typename ForwardIterator, typename OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) {
+				return tree_.find_batch(first, last, out);
+			}
+			template<typename ForwardIterator, typename OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+				return tree_.find_batch(first, last, out);
+			}
+
+// heterogeneous lookup (Compare::is_transparent, e.g. ft::less<>):
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			find(const K& x) { return tree_.find(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			find(const K& x) const { return tree_.find(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, size_type>::type
+			count(const K& x) const { return tree_.count(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			lower_bound(const K& x) { return tree_.lower_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			lower_bound(const K& x) const { return tree_.lower_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type
+			upper_bound(const K& x) { return tree_.upper_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type
+			upper_bound(const K& x) const { return tree_.upper_bound(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, pair<iterator, iterator> >::type
+			equal_range(const K& x) { return tree_.equal_range(x); }
+			template<typename K>
+			typename ft::enable_if_transparent<Compare, K, pair<const_iterator, const_iterator> >::type
+			equal_range(const K& x) const { return tree_.equal_range(x); }
+
+// order statistics (NodeUpdate = ft::order_statistic_node_update):
+			iterator nth(size_type k) { return tree_.nth(k); }
+			const_iterator nth(size_type k) const { return tree_.nth(k); }
+			size_type rank(const key_type& x) const { return tree_.rank(x); }
+			difference_type distance(const_iterator first, const_iterator last) const { return tree_.distance(first, last); }
+
+// set algebra (RBTree): split переносит в greater элементы не меньше x,
+// join и set_union забирают узлы аргумента; при совпадении ключей остается элемент *this
+			void split(const key_type& x, set& greater) { tree_.split(x, greater.tree_); }
+			void join(set& greater) { tree_.join(greater.tree_); }
+			void set_union(set& other) { tree_.set_union(other.tree_); }
+			void set_intersection(const set& other) { tree_.set_intersection(other.tree_); }
+			void set_difference(const set& other) { tree_.set_difference(other.tree_); }
+
+// debugging:
+			//↓↓↓ проверка инвариантов дерева за O(n), для тестов
+			bool verify() const { return tree_.verify(); }
+
+			friend bool operator==(const set& lhs, const set& rhs) {
 				return lhs.tree_ == rhs.tree_;
 			}
 
-			template<typename t_Key, typename t_Compare, typename t_Alloc>
-			friend bool operator!=(const set<t_Key, t_Compare, t_Alloc>& lhs, const set<t_Key, t_Compare, t_Alloc>& rhs) {
+			friend bool operator!=(const set& lhs, const set& rhs) {
 				return !(lhs == rhs);
 			}
 
-			template<typename t_Key, typename t_Compare, typename t_Alloc>
-			friend bool operator<(const set<t_Key, t_Compare, t_Alloc>& lhs, const set<t_Key, t_Compare, t_Alloc>& rhs) {
+			friend bool operator<(const set& lhs, const set& rhs) {
 				return lhs.tree_ < rhs.tree_;
 			}
 
-			template<typename t_Key, typename t_Compare, typename t_Alloc>
-			friend bool operator>(const set<t_Key, t_Compare, t_Alloc>& lhs, const set<t_Key, t_Compare, t_Alloc>& rhs) {
+			friend bool operator>(const set& lhs, const set& rhs) {
 				return rhs < lhs;
 			}
 
-			template<typename t_Key, typename t_Compare, typename t_Alloc>
-			friend bool operator<=(const set<t_Key, t_Compare, t_Alloc>& lhs, const set<t_Key, t_Compare, t_Alloc>& rhs) {
+			friend bool operator<=(const set& lhs, const set& rhs) {
 				return !(lhs > rhs);
 			}
 
-			template<typename t_Key, typename t_Compare, typename t_Alloc>
-			friend bool operator>=(const set<t_Key, t_Compare, t_Alloc>& lhs, const set<t_Key, t_Compare, t_Alloc>& rhs) {
+			friend bool operator>=(const set& lhs, const set& rhs) {
 				return !(lhs < rhs);
 			}
 
 	}; //namespace set
 
 // specialized algorithms:
-	template<typename Key,typename Compare, typename Alloc>
-	void swap(const ft::set<Key, Compare, Alloc>& lhs, const ft::set<Key, Compare, Alloc>& rhs) {
+	template<typename Key,typename Compare, typename Alloc, typename Update, typename Balance>
+	void swap(ft::set<Key, Compare, Alloc, Update, Balance>& lhs, ft::set<Key, Compare, Alloc, Update, Balance>& rhs) {
 		lhs.swap(rhs);
 	}
 
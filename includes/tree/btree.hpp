@@ -0,0 +1,866 @@
+/*
+// BTree -- B+-дерево: основа ft::btree_map и ft::btree_set.
+// Узел двоичного дерева -- один промах кэша на уровень, а узел B+-дерева размером
+// в несколько строк кэша (NodeBytes, по умолчанию 256 байт) хранит десятки ключей,
+// поэтому дерево в несколько раз ниже: у map<int, int> из 10^8 элементов 6 уровней вместо ~30.
+// Значения лежат только в листьях, листья связаны в список -- полный обход идет подряд по массивам.
+// Key -- тип ключа, KeyOfValue достает ключ из значения (копии ключей -- разделители во внутренних узлах).
+// Ограничения:
+//		- вставка и удаление перемещают значения внутри узла и между узлами, поэтому
+//		  недействительными становятся все итераторы, ссылки и указатели на элементы;
+//		- Value и Key не должны бросать исключений при копировании во время перестройки узлов:
+//		  без перемещений C++11 гарантию сохранности дать нельзя. Нехватка памяти при вставке
+//		  обнаруживается до изменения дерева -- все нужные узлы выделяются заранее.
+// Использованные материалы:
+//		https://en.wikipedia.org/wiki/B%2B_tree
+//		https://abseil.io/about/design/btree
+//		https://github.com/abseil/abseil-cpp/blob/master/absl/container/internal/btree.h
+*/
+
+#ifndef BTREE_HPP
+# define BTREE_HPP
+
+# include <algorithm>
+# include <cstddef>
+# include <memory>
+# include <new>
+# include "btree_node.hpp"
+# include "../iterators/BTree_iterator.hpp"
+# include "../iterators/iterator_reverse.hpp"
+# include "../utils/pair.hpp"
+# include "../utils/pool_allocator.hpp"
+# include "../utils/prefetch.hpp"
+# include "../utils/select.hpp"
+
+namespace ft {
+
+	template<typename Key, typename Value, typename KeyOfValue, typename Compare,
+			typename Allocator = std::allocator<Value>, std::size_t NodeBytes = 256>
+	class BTree {
+		public:
+			typedef Key														key_type;
+			typedef Value													value_type;
+			typedef Compare													key_compare;
+			typedef Allocator												allocator_type;
+			typedef typename allocator_type::reference						reference;
+			typedef typename allocator_type::const_reference				const_reference;
+			typedef typename allocator_type::pointer						pointer;
+			typedef typename allocator_type::const_pointer					const_pointer;
+			typedef typename allocator_type::size_type						size_type;
+			typedef std::ptrdiff_t											difference_type;
+
+			typedef BTree_params<Key, Value, NodeBytes>						params;
+			enum {
+				leaf_slots = params::leaf_slots,
+				children = params::children,
+				key_slots = params::key_slots,
+				//↓↓↓ меньше -- узел забирает значение у соседа или сливается с ним
+				min_values = leaf_slots / 2,
+				min_keys = children / 2 - 1,
+				//↓↓↓ у каждого внутреннего узла не меньше двух детей, поэтому высота не больше числа бит size_type
+				max_height = sizeof(size_type) * 8,
+				cache_line = 64
+			};
+
+			typedef BTree_leaf<Value, leaf_slots>							leaf_type;
+			typedef BTree_internal<Key, children>							internal_type;
+			typedef BTree_node_base*										node_pointer;
+			typedef BTree_leaf_base*										leaf_pointer;
+
+			typedef ft::BTree_iterator<Value, leaf_type>					iterator;
+			typedef ft::BTree_iterator<const Value, leaf_type>				const_iterator;
+			typedef ft::reverse_iterator<iterator>							reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+
+		private:
+			typedef typename allocator_type::template rebind<Key>::other			allocator_key;
+			typedef typename allocator_type::template rebind<leaf_type>::other		allocator_leaf;
+			typedef typename allocator_type::template rebind<internal_type>::other	allocator_internal;
+
+			//↓↓↓ узлы для разделений одной вставки, выделенные до изменения дерева
+			struct spare_nodes {
+				leaf_type*		leaf_;
+				internal_type*	internal_[max_height];
+				size_type		count_;
+			};
+
+			BTree_leaf_base		header_;
+			node_pointer		root_;
+			size_type			size_;
+			key_compare			comp_;
+			allocator_type		alloc_;
+			allocator_key		alloc_key_;
+			allocator_leaf		alloc_leaf_;
+			allocator_internal	alloc_internal_;
+
+		public:
+			explicit BTree(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+					header_(), root_(0), size_(0), comp_(comp), alloc_(alloc),
+					alloc_key_(alloc), alloc_leaf_(alloc), alloc_internal_(alloc) {}
+
+			BTree(const BTree& other) :
+					header_(), root_(0), size_(other.size_), comp_(other.comp_), alloc_(other.alloc_),
+					alloc_key_(other.alloc_key_), alloc_leaf_(other.alloc_leaf_), alloc_internal_(other.alloc_internal_) {
+				if (other.root_) {
+					root_ = copy_node(other.root_, 0);
+				}
+			}
+
+			BTree& operator=(const BTree& other) {
+				if (this != &other) {
+					BTree tmp(other);
+					swap(tmp);
+				}
+				return *this;
+			}
+
+			~BTree() {
+				clear();
+			}
+
+			iterator begin() { return iterator(header_.next_, 0); }
+			const_iterator begin() const { return const_iterator(header_.next_, 0); }
+			iterator end() { return iterator(&header_, 0); }
+			const_iterator end() const { return const_iterator(const_cast<leaf_pointer>(&header_), 0); }
+			reverse_iterator rbegin() { return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+			reverse_iterator rend() { return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+			bool empty() const { return size_ == 0; }
+			size_type size() const { return size_; }
+			size_type max_size() const { return alloc_.max_size(); }
+			key_compare key_comp() const { return comp_; }
+			allocator_type get_allocator() const { return alloc_; }
+
+			void clear() {
+				if (root_) {
+					destroy(root_);
+				}
+				root_ = 0;
+				size_ = 0;
+				header_.prev_ = header_.next_ = &header_;
+				ft::release_allocator(alloc_leaf_);
+				ft::release_allocator(alloc_internal_);
+			}
+
+			void swap(BTree& other) {
+				std::swap(root_, other.root_);
+				std::swap(size_, other.size_);
+				std::swap(comp_, other.comp_);
+				//↓↓↓ узлы остаются за тем аллокатором, который их выделил (важно для pool_allocator)
+				ft::swap_allocator(alloc_, other.alloc_);
+				ft::swap_allocator(alloc_key_, other.alloc_key_);
+				ft::swap_allocator(alloc_leaf_, other.alloc_leaf_);
+				ft::swap_allocator(alloc_internal_, other.alloc_internal_);
+				std::swap(header_.prev_, other.header_.prev_);
+				std::swap(header_.next_, other.header_.next_);
+				fix_header();
+				other.fix_header();
+			}
+
+// lookup:
+			template<typename K>
+			iterator find(const K& x) {
+				leaf_type* leaf;
+				size_type pos;
+				if (search(x, leaf, pos)) {
+					return iterator(leaf, pos);
+				}
+				return end();
+			}
+
+			template<typename K>
+			const_iterator find(const K& x) const {
+				leaf_type* leaf;
+				size_type pos;
+				if (search(x, leaf, pos)) {
+					return const_iterator(leaf, pos);
+				}
+				return end();
+			}
+
+			template<typename K>
+			size_type count(const K& x) const {
+				leaf_type* leaf;
+				size_type pos;
+				return search(x, leaf, pos) ? 1 : 0;
+			}
+
+			template<typename K>
+			iterator lower_bound(const K& x) {
+				return mutable_iterator(lower_position(x));
+			}
+
+			template<typename K>
+			const_iterator lower_bound(const K& x) const {
+				return lower_position(x);
+			}
+
+			template<typename K>
+			iterator upper_bound(const K& x) {
+				return mutable_iterator(upper_position(x));
+			}
+
+			template<typename K>
+			const_iterator upper_bound(const K& x) const {
+				return upper_position(x);
+			}
+
+			template<typename K>
+			ft::pair<iterator, iterator> equal_range(const K& x) {
+				iterator first = lower_bound(x);
+				iterator last = first;
+				if (last != end() && !comp_(x, key_of(*last))) {
+					++last;
+				}
+				return ft::pair<iterator, iterator>(first, last);
+			}
+
+			template<typename K>
+			ft::pair<const_iterator, const_iterator> equal_range(const K& x) const {
+				const_iterator first = lower_bound(x);
+				const_iterator last = first;
+				if (last != end() && !comp_(x, key_of(*last))) {
+					++last;
+				}
+				return ft::pair<const_iterator, const_iterator>(first, last);
+			}
+
+// modifiers:
+			ft::pair<iterator, bool> insert_unique(const value_type& val) {
+				leaf_type* leaf;
+				size_type pos;
+				if (unique_position(key_of(val), leaf, pos)) {
+					return ft::pair<iterator, bool>(iterator(leaf, pos), false);
+				}
+				return ft::pair<iterator, bool>(insert_at(leaf, pos, val), true);
+			}
+
+			//↓↓↓ если val встает прямо перед hint внутри листа или на краю дерева (возрастающий
+			// или убывающий поток), вставка идет без спуска. На границе двух листей разделитель
+			// предка может не пустить val в лист hint -- тогда обычная вставка
+			iterator insert_hint(const_iterator hint, const value_type& val) {
+				if (root_) {
+					const key_type& k = key_of(val);
+					leaf_pointer node = hint.node();
+					if (node == &header_) {
+						leaf_type* last = static_cast<leaf_type*>(header_.prev_);
+						if (comp_(key_of(last->value(last->count_ - 1)), k)) {
+							return insert_at(last, last->count_, val);
+						}
+					} else {
+						leaf_type* leaf = static_cast<leaf_type*>(node);
+						size_type pos = hint.index();
+						if (comp_(k, key_of(leaf->value(pos)))) {
+							if (pos > 0 && comp_(key_of(leaf->value(pos - 1)), k)) {
+								return insert_at(leaf, pos, val);
+							}
+							if (pos == 0 && node == header_.next_) {
+								return insert_at(leaf, 0, val);
+							}
+						}
+					}
+				}
+				return insert_unique(val).first;
+			}
+
+			//↓↓↓ map::try_emplace и operator[]: если ключ есть, ничего не конструируется
+			template<typename K, typename M>
+			ft::pair<iterator, bool> try_emplace(const K& key, const M& obj) {
+				leaf_type* leaf;
+				size_type pos;
+				if (unique_position(key, leaf, pos)) {
+					return ft::pair<iterator, bool>(iterator(leaf, pos), false);
+				}
+				return ft::pair<iterator, bool>(insert_at(leaf, pos, value_type(key, obj)), true);
+			}
+
+			template<typename InputIterator>
+			void insert_range(InputIterator first, InputIterator last) {
+				for (; first != last; ++first) {
+					insert_hint(end(), *first);
+				}
+			}
+
+			//↓↓↓ возвращает итератор на элемент, следовавший за удаленным
+			iterator erase(const_iterator position) {
+				return erase_at(as_leaf(position.node()), position.index());
+			}
+
+			//↓↓↓ удаление перестраивает листья, поэтому last заранее не запомнить: удаляется
+			// distance(first, last) элементов подряд, начиная с first
+			iterator erase(const_iterator first, const_iterator last) {
+				if (first == begin() && last == end()) {
+					clear();
+					return end();
+				}
+				size_type n = 0;
+				for (const_iterator it = first; it != last; ++it) {
+					++n;
+				}
+				iterator it = mutable_iterator(first);
+				for (; n > 0; --n) {
+					it = erase(it);
+				}
+				return it;
+			}
+
+			template<typename K>
+			size_type erase_key(const K& x) {
+				leaf_type* leaf;
+				size_type pos;
+				if (!search(x, leaf, pos)) {
+					return 0;
+				}
+				erase_at(leaf, pos);
+				return 1;
+			}
+
+		private:
+			static const key_type& key_of(const value_type& val) {
+				return KeyOfValue()(val);
+			}
+
+			static leaf_type* as_leaf(node_pointer node) {
+				return static_cast<leaf_type*>(static_cast<leaf_pointer>(node));
+			}
+
+			static internal_type* as_internal(node_pointer node) {
+				return static_cast<internal_type*>(node);
+			}
+
+			void fix_header() {
+				if (root_) {
+					header_.next_->prev_ = &header_;
+					header_.prev_->next_ = &header_;
+				} else {
+					header_.prev_ = header_.next_ = &header_;
+				}
+			}
+
+			static iterator mutable_iterator(const_iterator it) {
+				return iterator(it.node(), it.index());
+			}
+
+			//↓↓↓ позиция за концом листа -- начало следующего листа (или end())
+			static const_iterator position(leaf_pointer leaf, size_type pos) {
+				if (pos == leaf->count_) {
+					return const_iterator(leaf->next_, 0);
+				}
+				return const_iterator(leaf, pos);
+			}
+
+// search:
+			//↓↓↓ узел занимает несколько строк кэша: их загрузка запрашивается сразу,
+			// а не по одной по ходу двоичного поиска
+			static void prefetch_node(const void* node) {
+				const char* p = static_cast<const char*>(node);
+				for (size_type offset = 0; offset < NodeBytes; offset += cache_line) {
+					ft::prefetch(p + offset);
+				}
+			}
+
+			template<typename K>
+			size_type leaf_lower(const leaf_type* leaf, const K& x) const {
+				size_type first = 0;
+				size_type len = leaf->count_;
+				while (len > 0) {
+					size_type half = len / 2;
+					if (comp_(key_of(leaf->value(first + half)), x)) {
+						first += half + 1;
+						len -= half + 1;
+					} else {
+						len = half;
+					}
+				}
+				return first;
+			}
+
+			template<typename K>
+			size_type leaf_upper(const leaf_type* leaf, const K& x) const {
+				size_type first = 0;
+				size_type len = leaf->count_;
+				while (len > 0) {
+					size_type half = len / 2;
+					if (!comp_(x, key_of(leaf->value(first + half)))) {
+						first += half + 1;
+						len -= half + 1;
+					} else {
+						len = half;
+					}
+				}
+				return first;
+			}
+
+			//↓↓↓ индекс ребенка, чей диапазон [key(i - 1), key(i)) содержит x
+			template<typename K>
+			size_type child_index(const internal_type* node, const K& x) const {
+				size_type first = 0;
+				size_type len = node->count_;
+				while (len > 0) {
+					size_type half = len / 2;
+					if (!comp_(x, node->key(first + half))) {
+						first += half + 1;
+						len -= half + 1;
+					} else {
+						len = half;
+					}
+				}
+				return first;
+			}
+
+			template<typename K>
+			leaf_type* descend(const K& x) const {
+				node_pointer node = root_;
+				while (!node->leaf_) {
+					node = as_internal(node)->children_[child_index(as_internal(node), x)];
+					prefetch_node(node);
+				}
+				return as_leaf(node);
+			}
+
+			//↓↓↓ true, если x найден; pos -- место x в листе или позиция для его вставки
+			template<typename K>
+			bool search(const K& x, leaf_type*& leaf, size_type& pos) const {
+				if (!root_) {
+					return false;
+				}
+				leaf = descend(x);
+				pos = leaf_lower(leaf, x);
+				return pos < leaf->count_ && !comp_(x, key_of(leaf->value(pos)));
+			}
+
+			//↓↓↓ как search, но у пустого дерева позиция вставки -- (0, 0): корневой лист создаст insert_at
+			template<typename K>
+			bool unique_position(const K& x, leaf_type*& leaf, size_type& pos) const {
+				leaf = 0;
+				pos = 0;
+				return search(x, leaf, pos);
+			}
+
+			template<typename K>
+			const_iterator lower_position(const K& x) const {
+				if (!root_) {
+					return end();
+				}
+				leaf_type* leaf = descend(x);
+				return position(leaf, leaf_lower(leaf, x));
+			}
+
+			template<typename K>
+			const_iterator upper_position(const K& x) const {
+				if (!root_) {
+					return end();
+				}
+				leaf_type* leaf = descend(x);
+				return position(leaf, leaf_upper(leaf, x));
+			}
+
+// slots:
+			//↓↓↓ перенос n объектов в не пересекающуюся или лежащую левее область
+			template<typename T, typename Alloc>
+			static void relocate(Alloc& alloc, T* dst, T* src, size_type n) {
+				for (size_type i = 0; i < n; ++i) {
+					alloc.construct(dst + i, src[i]);
+					alloc.destroy(src + i);
+				}
+			}
+
+			//↓↓↓ то же для области правее src
+			template<typename T, typename Alloc>
+			static void relocate_backward(Alloc& alloc, T* dst, T* src, size_type n) {
+				for (size_type i = n; i > 0; --i) {
+					alloc.construct(dst + i - 1, src[i - 1]);
+					alloc.destroy(src + i - 1);
+				}
+			}
+
+			static void set_child(internal_type* node, size_type i, node_pointer child) {
+				node->children_[i] = child;
+				child->parent_ = node;
+				child->position_ = static_cast<unsigned short>(i);
+			}
+
+			//↓↓↓ сдвиг детей [from, count_] на shift позиций (-1 или 1) с обновлением position_
+			static void shift_children(internal_type* node, size_type from, int shift) {
+				size_type last = node->count_;
+				if (shift > 0) {
+					for (size_type i = last + 1; i > from; --i) {
+						set_child(node, i, node->children_[i - 1]);
+					}
+				} else {
+					for (size_type i = from; i <= last; ++i) {
+						set_child(node, i - 1, node->children_[i]);
+					}
+				}
+			}
+
+			void insert_value(leaf_type* leaf, size_type pos, const value_type& val) {
+				relocate_backward(alloc_, leaf->data() + pos + 1, leaf->data() + pos, leaf->count_ - pos);
+				alloc_.construct(leaf->data() + pos, val);
+				++leaf->count_;
+			}
+
+			void link_after(leaf_pointer prev, leaf_pointer leaf) {
+				leaf->prev_ = prev;
+				leaf->next_ = prev->next_;
+				prev->next_->prev_ = leaf;
+				prev->next_ = leaf;
+			}
+
+			static void unlink(leaf_pointer leaf) {
+				leaf->prev_->next_ = leaf->next_;
+				leaf->next_->prev_ = leaf->prev_;
+			}
+
+// insert:
+			//↓↓↓ выделяет лист и внутренние узлы для всех разделений, которые вызовет вставка
+			// в заполненный leaf: заполненные предки и, если заполнены все, -- новый корень
+			void reserve_split(leaf_type* leaf, spare_nodes& spare) {
+				size_type need = 0;
+				node_pointer node = leaf->parent_;
+				for (; node && node->count_ == key_slots; node = node->parent_) {
+					++need;
+				}
+				if (!node) {
+					++need;
+				}
+				spare.count_ = 0;
+				spare.leaf_ = alloc_leaf_.allocate(1);
+				try {
+					for (; spare.count_ < need; ++spare.count_) {
+						spare.internal_[spare.count_] = alloc_internal_.allocate(1);
+					}
+				} catch (...) {
+					release_spare(spare);
+					throw;
+				}
+			}
+
+			void release_spare(spare_nodes& spare) {
+				if (spare.leaf_) {
+					alloc_leaf_.deallocate(spare.leaf_, 1);
+				}
+				while (spare.count_ > 0) {
+					alloc_internal_.deallocate(spare.internal_[--spare.count_], 1);
+				}
+			}
+
+			static internal_type* take_internal(spare_nodes& spare) {
+				internal_type* node = spare.internal_[--spare.count_];
+				::new (static_cast<void*>(node)) internal_type();
+				return node;
+			}
+
+			//↓↓↓ точка разделения: при вставке в конец (в начало) узла левая (правая) часть
+			// остается почти полной -- возрастающая вставка заполняет листья целиком
+			static size_type split_point(size_type pos, size_type full) {
+				if (pos == full) {
+					return full - 1;
+				}
+				if (pos == 0) {
+					return 1;
+				}
+				return full / 2;
+			}
+
+			iterator insert_at(leaf_type* leaf, size_type pos, const value_type& val) {
+				if (!leaf) {
+					leaf = alloc_leaf_.allocate(1);
+					::new (static_cast<void*>(leaf)) leaf_type();
+					try {
+						alloc_.construct(leaf->data(), val);
+					} catch (...) {
+						alloc_leaf_.deallocate(leaf, 1);
+						throw;
+					}
+					leaf->count_ = 1;
+					link_after(&header_, leaf);
+					root_ = leaf;
+					++size_;
+					return iterator(leaf, 0);
+				}
+				if (leaf->count_ < leaf_slots) {
+					insert_value(leaf, pos, val);
+					++size_;
+					return iterator(leaf, pos);
+				}
+				spare_nodes spare;
+				reserve_split(leaf, spare);
+				size_type m = split_point(pos, leaf_slots);
+				leaf_type* right = spare.leaf_;
+				spare.leaf_ = 0;
+				::new (static_cast<void*>(right)) leaf_type();
+				relocate(alloc_, right->data(), leaf->data() + m, leaf_slots - m);
+				right->count_ = static_cast<unsigned short>(leaf_slots - m);
+				leaf->count_ = static_cast<unsigned short>(m);
+				link_after(leaf, right);
+				insert_child(leaf, key_of(right->value(0)), right, spare);
+				release_spare(spare);
+				leaf_type* target = leaf;
+				if (pos > m) {
+					target = right;
+					pos -= m;
+				}
+				insert_value(target, pos, val);
+				++size_;
+				return iterator(target, pos);
+			}
+
+			//↓↓↓ вставляет разделитель sep и правую половину right, отделившуюся от left
+			void insert_child(node_pointer left, const key_type& sep, node_pointer right, spare_nodes& spare) {
+				internal_type* parent = as_internal(left->parent_);
+				if (!parent) {
+					internal_type* root = take_internal(spare);
+					set_child(root, 0, left);
+					alloc_key_.construct(root->keys(), sep);
+					set_child(root, 1, right);
+					root->count_ = 1;
+					root_ = root;
+					return;
+				}
+				size_type pos = left->position_;
+				if (parent->count_ < key_slots) {
+					insert_key(parent, pos, sep, right);
+					return;
+				}
+				size_type m = split_point(pos, key_slots);
+				key_type up(parent->key(m));
+				internal_type* sibling = split_internal(parent, m, spare);
+				if (pos <= m) {
+					insert_key(parent, pos, sep, right);
+				} else {
+					insert_key(sibling, pos - m - 1, sep, right);
+				}
+				insert_child(parent, up, sibling, spare);
+			}
+
+			//↓↓↓ ключи после m и их дети уходят в новый узел, ключ m разрушается (его копию поднимает вызывающий)
+			internal_type* split_internal(internal_type* node, size_type m, spare_nodes& spare) {
+				internal_type* right = take_internal(spare);
+				size_type n = node->count_;
+				relocate(alloc_key_, right->keys(), node->keys() + m + 1, n - m - 1);
+				for (size_type i = m + 1; i <= n; ++i) {
+					set_child(right, i - m - 1, node->children_[i]);
+				}
+				alloc_key_.destroy(node->keys() + m);
+				right->count_ = static_cast<unsigned short>(n - m - 1);
+				node->count_ = static_cast<unsigned short>(m);
+				return right;
+			}
+
+			void insert_key(internal_type* node, size_type pos, const key_type& sep, node_pointer child) {
+				relocate_backward(alloc_key_, node->keys() + pos + 1, node->keys() + pos, node->count_ - pos);
+				alloc_key_.construct(node->keys() + pos, sep);
+				shift_children(node, pos + 1, 1);
+				set_child(node, pos + 1, child);
+				++node->count_;
+			}
+
+// erase:
+			iterator erase_at(leaf_type* leaf, size_type pos) {
+				alloc_.destroy(leaf->data() + pos);
+				relocate(alloc_, leaf->data() + pos, leaf->data() + pos + 1, leaf->count_ - pos - 1);
+				--leaf->count_;
+				--size_;
+				if (leaf == root_) {
+					if (leaf->count_ == 0) {
+						destroy_leaf(leaf);
+						root_ = 0;
+						return end();
+					}
+				} else if (leaf->count_ < min_values) {
+					return rebalance_leaf(leaf, pos);
+				}
+				return mutable_iterator(position(leaf, pos));
+			}
+
+			//↓↓↓ лист стал меньше min_values: берет крайнее значение у соседа, у которого
+			// есть лишние, иначе сливается с ним. pos -- позиция следующего за удаленным элемента
+			iterator rebalance_leaf(leaf_type* leaf, size_type pos) {
+				internal_type* parent = as_internal(leaf->parent_);
+				size_type k = leaf->position_;
+				leaf_type* left = (k > 0 ? as_leaf(parent->children_[k - 1]) : 0);
+				leaf_type* right = (k < parent->count_ ? as_leaf(parent->children_[k + 1]) : 0);
+				const_iterator it;
+				if (left && left->count_ > min_values) {
+					relocate_backward(alloc_, leaf->data() + 1, leaf->data(), leaf->count_);
+					relocate(alloc_, leaf->data(), left->data() + left->count_ - 1, 1);
+					--left->count_;
+					++leaf->count_;
+					parent->key(k - 1) = key_of(leaf->value(0));
+					it = position(leaf, pos + 1);
+				} else if (right && right->count_ > min_values) {
+					relocate(alloc_, leaf->data() + leaf->count_, right->data(), 1);
+					relocate(alloc_, right->data(), right->data() + 1, right->count_ - 1);
+					--right->count_;
+					++leaf->count_;
+					parent->key(k) = key_of(right->value(0));
+					it = position(leaf, pos);
+				} else {
+					if (left) {
+						pos += left->count_;
+						merge_leaves(left, leaf);
+						it = position(left, pos);
+					} else {
+						merge_leaves(leaf, right);
+						it = position(leaf, pos);
+					}
+					rebalance_internal(parent);
+				}
+				return mutable_iterator(it);
+			}
+
+			void merge_leaves(leaf_type* left, leaf_type* right) {
+				relocate(alloc_, left->data() + left->count_, right->data(), right->count_);
+				left->count_ = static_cast<unsigned short>(left->count_ + right->count_);
+				right->count_ = 0;
+				remove_child(as_internal(right->parent_), right->position_);
+				destroy_leaf(right);
+			}
+
+			//↓↓↓ убирает ребенка k > 0 и разделитель перед ним
+			void remove_child(internal_type* node, size_type k) {
+				alloc_key_.destroy(node->keys() + k - 1);
+				relocate(alloc_key_, node->keys() + k - 1, node->keys() + k, node->count_ - k);
+				shift_children(node, k + 1, -1);
+				--node->count_;
+			}
+
+			void rebalance_internal(internal_type* node) {
+				if (node == root_) {
+					if (node->count_ == 0) {
+						root_ = node->children_[0];
+						root_->parent_ = 0;
+						root_->position_ = 0;
+						destroy_internal(node);
+					}
+					return;
+				}
+				if (node->count_ >= min_keys) {
+					return;
+				}
+				internal_type* parent = as_internal(node->parent_);
+				size_type k = node->position_;
+				internal_type* left = (k > 0 ? as_internal(parent->children_[k - 1]) : 0);
+				internal_type* right = (k < parent->count_ ? as_internal(parent->children_[k + 1]) : 0);
+				if (left && left->count_ > min_keys) {
+					relocate_backward(alloc_key_, node->keys() + 1, node->keys(), node->count_);
+					alloc_key_.construct(node->keys(), parent->key(k - 1));
+					shift_children(node, 0, 1);
+					set_child(node, 0, left->children_[left->count_]);
+					parent->key(k - 1) = left->key(left->count_ - 1);
+					alloc_key_.destroy(left->keys() + left->count_ - 1);
+					--left->count_;
+					++node->count_;
+				} else if (right && right->count_ > min_keys) {
+					alloc_key_.construct(node->keys() + node->count_, parent->key(k));
+					set_child(node, node->count_ + 1, right->children_[0]);
+					++node->count_;
+					parent->key(k) = right->key(0);
+					alloc_key_.destroy(right->keys());
+					relocate(alloc_key_, right->keys(), right->keys() + 1, right->count_ - 1);
+					shift_children(right, 1, -1);
+					--right->count_;
+				} else {
+					if (left) {
+						merge_internal(left, node);
+					} else {
+						merge_internal(node, right);
+					}
+					rebalance_internal(parent);
+				}
+			}
+
+			//↓↓↓ разделитель из родителя опускается между ключами left и right
+			void merge_internal(internal_type* left, internal_type* right) {
+				internal_type* parent = as_internal(right->parent_);
+				size_type k = right->position_;
+				size_type n = left->count_;
+				alloc_key_.construct(left->keys() + n, parent->key(k - 1));
+				relocate(alloc_key_, left->keys() + n + 1, right->keys(), right->count_);
+				for (size_type i = 0; i <= right->count_; ++i) {
+					set_child(left, n + 1 + i, right->children_[i]);
+				}
+				left->count_ = static_cast<unsigned short>(n + 1 + right->count_);
+				right->count_ = 0;
+				remove_child(parent, k);
+				destroy_internal(right);
+			}
+
+// copy/destroy:
+			void destroy_leaf(leaf_type* leaf) {
+				for (size_type i = 0; i < leaf->count_; ++i) {
+					alloc_.destroy(leaf->data() + i);
+				}
+				unlink(leaf);
+				alloc_leaf_.deallocate(leaf, 1);
+			}
+
+			void destroy_internal(internal_type* node) {
+				for (size_type i = 0; i < node->count_; ++i) {
+					alloc_key_.destroy(node->keys() + i);
+				}
+				alloc_internal_.deallocate(node, 1);
+			}
+
+			void destroy(node_pointer node) {
+				if (node->leaf_) {
+					destroy_leaf(as_leaf(node));
+					return;
+				}
+				internal_type* internal = as_internal(node);
+				for (size_type i = 0; i <= internal->count_; ++i) {
+					destroy(internal->children_[i]);
+				}
+				destroy_internal(internal);
+			}
+
+			//↓↓↓ листья копируются слева направо и сразу встают в конец списка.
+			// При исключении уже скопированная часть узла разрушается здесь же
+			node_pointer copy_node(const BTree_node_base* src, internal_type* parent) {
+				if (src->leaf_) {
+					const leaf_type* from = static_cast<const leaf_type*>(static_cast<const BTree_leaf_base*>(src));
+					leaf_type* leaf = alloc_leaf_.allocate(1);
+					::new (static_cast<void*>(leaf)) leaf_type();
+					link_after(header_.prev_, leaf);
+					try {
+						for (; leaf->count_ < from->count_; ++leaf->count_) {
+							alloc_.construct(leaf->data() + leaf->count_, from->value(leaf->count_));
+						}
+					} catch (...) {
+						destroy_leaf(leaf);
+						throw;
+					}
+					leaf->parent_ = parent;
+					leaf->position_ = src->position_;
+					return leaf;
+				}
+				const internal_type* from = static_cast<const internal_type*>(src);
+				internal_type* node = alloc_internal_.allocate(1);
+				::new (static_cast<void*>(node)) internal_type();
+				size_type copied = 0;
+				try {
+					node->children_[0] = copy_node(from->children_[0], node);
+					for (copied = 1; node->count_ < from->count_; ++copied) {
+						alloc_key_.construct(node->keys() + node->count_, from->key(node->count_));
+						++node->count_;
+						node->children_[copied] = copy_node(from->children_[copied], node);
+					}
+				} catch (...) {
+					for (size_type i = 0; i < copied; ++i) {
+						destroy(node->children_[i]);
+					}
+					destroy_internal(node);
+					throw;
+				}
+				node->parent_ = parent;
+				node->position_ = src->position_;
+				return node;
+			}
+	};
+
+} // namespace ft
+
+#endif
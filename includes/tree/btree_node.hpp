@@ -0,0 +1,92 @@
+/*
+// Узлы B+-дерева (tree/btree.hpp). Значения лежат только в листьях, внутренние узлы
+// хранят копии ключей-разделителей и указатели на детей. Листья связаны в кольцевой
+// двусвязный список через заголовок дерева, поэтому шаг итератора не поднимается по дереву.
+// Размер узла задается в байтах (NodeBytes): число слотов выводится из sizeof(Value)
+// и sizeof(Key), но не меньше 4 -- иначе разделение узла вырождается.
+// Использованные материалы:
+//		https://en.wikipedia.org/wiki/B%2B_tree
+//		https://abseil.io/about/design/btree
+*/
+
+#ifndef BTREE_NODE_HPP
+# define BTREE_NODE_HPP
+
+# include <cstddef>
+
+namespace ft {
+
+	//↓↓↓ общая часть листа и внутреннего узла. position_ -- индекс узла среди детей родителя,
+	// count_ -- число значений листа или ключей внутреннего узла (детей на один больше)
+	struct BTree_node_base {
+		BTree_node_base*	parent_;
+		unsigned short		position_;
+		unsigned short		count_;
+		bool				leaf_;
+
+		explicit BTree_node_base(bool leaf) : parent_(0), position_(0), count_(0), leaf_(leaf) {}
+	};
+
+	//↓↓↓ звено списка листьев. Заголовок дерева -- такое же звено без значений (count_ == 0):
+	// он же end(), next_ -- самый левый лист, prev_ -- самый правый
+	struct BTree_leaf_base : public BTree_node_base {
+		BTree_leaf_base*	prev_;
+		BTree_leaf_base*	next_;
+
+		BTree_leaf_base() : BTree_node_base(true), prev_(this), next_(this) {}
+	};
+
+	//↓↓↓ сырая память под N объектов T: слоты конструирует и разрушает дерево по одному,
+	// выравнивание как у operator new (см. pool_allocator)
+	template<typename T, std::size_t N>
+	struct BTree_slots {
+		union {
+			char			bytes_[sizeof(T) * N];
+			long double		align_;
+		};
+
+		T* data() { return reinterpret_cast<T*>(bytes_); }
+		const T* data() const { return reinterpret_cast<const T*>(bytes_); }
+	};
+
+	template<typename Value, std::size_t Slots>
+	struct BTree_leaf : public BTree_leaf_base {
+		BTree_slots<Value, Slots>	values_;
+
+		Value* data() { return values_.data(); }
+		Value& value(std::size_t i) { return values_.data()[i]; }
+		const Value& value(std::size_t i) const { return values_.data()[i]; }
+	};
+
+	//↓↓↓ ребенок i содержит ключи из [key(i - 1), key(i)). Разделитель -- граница, а не элемент:
+	// после удаления ключа из листа его копия в предках остается и не мешает спуску
+	template<typename Key, std::size_t Children>
+	struct BTree_internal : public BTree_node_base {
+		BTree_node_base*				children_[Children];
+		BTree_slots<Key, Children - 1>	keys_;
+
+		BTree_internal() : BTree_node_base(false) {}
+
+		Key* keys() { return keys_.data(); }
+		Key& key(std::size_t i) { return keys_.data()[i]; }
+		const Key& key(std::size_t i) const { return keys_.data()[i]; }
+	};
+
+	//↓↓↓ вместимость узлов размером NodeBytes: у листа -- значения за заголовком,
+	// у внутреннего узла -- пары (ключ, ребенок) плюс один ребенок
+	template<typename Key, typename Value, std::size_t NodeBytes>
+	struct BTree_params {
+		enum {
+			leaf_room = (NodeBytes > sizeof(BTree_leaf_base) ? NodeBytes - sizeof(BTree_leaf_base) : 0),
+			leaf_fit = leaf_room / sizeof(Value),
+			leaf_slots = (leaf_fit < 4 ? 4 : (leaf_fit > 1024 ? 1024 : leaf_fit)),
+			internal_room = (NodeBytes > sizeof(BTree_node_base) ? NodeBytes - sizeof(BTree_node_base) : 0),
+			internal_fit = (internal_room + sizeof(Key)) / (sizeof(Key) + sizeof(void*)),
+			children = (internal_fit < 4 ? 4 : (internal_fit > 1024 ? 1024 : internal_fit)),
+			key_slots = children - 1
+		};
+	};
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,240 @@
+/*
+// Eytzinger -- неизменяемое двоичное дерево поиска в массиве в порядке обхода в ширину
+// (раскладка Эйтцингера): основа ft::frozen_map. Корень -- в ячейке 1, дети ячейки k -- 2k и 2k + 1.
+// Строится один раз из отсортированного контейнера и больше не меняется.
+// Зачем это при уже отсортированном массиве (std::lower_bound):
+//		- первые уровни дерева лежат рядом в начале массива и всегда в кэше, а у двоичного
+//		  поиска по отсортированному массиву горячие точки разбросаны по всему массиву;
+//		- спуск -- k = 2k + (ключ меньше x): без ветвлений, без промахов предсказателя;
+//		- потомки k на L уровней ниже -- 2^L подряд идущих ячеек начиная с 2^L * k, поэтому
+//		  строку кэша для шага через L уровней можно запросить заранее (prefetch), и задержки
+//		  памяти нескольких уровней перекрываются.
+// Обход по порядку ключей -- по неявному дереву (iterators/Eytzinger_iterator.hpp), он прыгает
+// по массиву; это раскладка для поиска, а не для обхода.
+// Использованные материалы:
+//		https://arxiv.org/abs/1509.05053
+//		https://algorithmica.org/en/eytzinger
+*/
+
+#ifndef EYTZINGER_HPP
+# define EYTZINGER_HPP
+
+# include <algorithm>
+# include <cstddef>
+# include <memory>
+# include "../iterators/Eytzinger_iterator.hpp"
+# include "../iterators/iterator_reverse.hpp"
+# include "../utils/pair.hpp"
+# include "../utils/pool_allocator.hpp"
+# include "../utils/prefetch.hpp"
+# include "../utils/select.hpp"
+
+namespace ft {
+
+	//↓↓↓ наибольшая степень двойки, не превосходящая N (для N == 0 -- 1)
+	template<std::size_t N>
+	struct Eytzinger_pow2 {
+		enum { value = 2 * Eytzinger_pow2<N / 2>::value };
+	};
+
+	template<>
+	struct Eytzinger_pow2<1> {
+		enum { value = 1 };
+	};
+
+	template<>
+	struct Eytzinger_pow2<0> {
+		enum { value = 1 };
+	};
+
+	template<typename Key, typename Value, typename KeyOfValue, typename Compare,
+			typename Allocator = std::allocator<Value> >
+	class Eytzinger {
+		public:
+			typedef Key														key_type;
+			typedef Value													value_type;
+			typedef Compare													key_compare;
+			typedef Allocator												allocator_type;
+			typedef typename allocator_type::size_type						size_type;
+			typedef std::ptrdiff_t											difference_type;
+			typedef ft::Eytzinger_iterator<const Value>						const_iterator;
+			typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+
+			enum {
+				cache_line = 64,
+				//↓↓↓ сколько ячеек одного уровня помещается в строку кэша: на столько
+				// вперед (в ячейках k * prefetch_stride) запрашивается память при спуске
+				prefetch_stride = Eytzinger_pow2<cache_line / sizeof(Value)>::value
+			};
+
+		private:
+			//↓↓↓ ячейки 1..size_; ячейка 0 выделена, но не конструируется, чтобы индексы
+			// совпадали с номерами вершин
+			value_type*		data_;
+			size_type		size_;
+			key_compare		comp_;
+			allocator_type	alloc_;
+
+		public:
+			explicit Eytzinger(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+					data_(0), size_(0), comp_(comp), alloc_(alloc) {}
+
+			//↓↓↓ [first, first + n) -- n значений с возрастающими уникальными ключами
+			// (обход ft::map). Ячейки заполняются в порядке ключей, то есть по неявному дереву
+			template<typename InputIterator>
+			Eytzinger(InputIterator first, size_type n, const key_compare& comp, const allocator_type& alloc) :
+					data_(0), size_(0), comp_(comp), alloc_(alloc) {
+				build(first, n);
+			}
+
+			Eytzinger(const Eytzinger& other) :
+					data_(0), size_(0), comp_(other.comp_), alloc_(other.alloc_) {
+				build(other.begin(), other.size_);
+			}
+
+			Eytzinger& operator=(const Eytzinger& other) {
+				if (this != &other) {
+					Eytzinger tmp(other);
+					swap(tmp);
+				}
+				return *this;
+			}
+
+			~Eytzinger() {
+				destroy(size_);
+			}
+
+			const_iterator begin() const { return make_iterator(eytzinger_first(size_)); }
+			const_iterator end() const { return make_iterator(0); }
+			const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+			const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+			bool empty() const { return size_ == 0; }
+			size_type size() const { return size_; }
+			size_type max_size() const { return alloc_.max_size() - 1; }
+			key_compare key_comp() const { return comp_; }
+			allocator_type get_allocator() const { return alloc_; }
+
+			void swap(Eytzinger& other) {
+				std::swap(data_, other.data_);
+				std::swap(size_, other.size_);
+				std::swap(comp_, other.comp_);
+				//↓↓↓ массив остается за тем аллокатором, который его выделил (важно для pool_allocator)
+				ft::swap_allocator(alloc_, other.alloc_);
+			}
+
+// lookup:
+			template<typename K>
+			const_iterator find(const K& x) const {
+				size_type k = lower_index(x);
+				return make_iterator(found(k, x) ? k : 0);
+			}
+
+			template<typename K>
+			size_type count(const K& x) const {
+				return found(lower_index(x), x) ? 1 : 0;
+			}
+
+			template<typename K>
+			const_iterator lower_bound(const K& x) const { return make_iterator(lower_index(x)); }
+
+			template<typename K>
+			const_iterator upper_bound(const K& x) const { return make_iterator(upper_index(x)); }
+
+			template<typename K>
+			ft::pair<const_iterator, const_iterator> equal_range(const K& x) const {
+				size_type k = lower_index(x);
+				const_iterator it = make_iterator(k);
+				if (found(k, x)) {
+					const_iterator next = it;
+					return ft::pair<const_iterator, const_iterator>(it, ++next);
+				}
+				return ft::pair<const_iterator, const_iterator>(it, it);
+			}
+
+		private:
+			static const key_type& key_of(const value_type& val) {
+				return KeyOfValue()(val);
+			}
+
+			const_iterator make_iterator(size_type k) const {
+				return const_iterator(data_, k, size_);
+			}
+
+			template<typename K>
+			bool found(size_type k, const K& x) const {
+				return k != 0 && !comp_(x, key_of(data_[k]));
+			}
+
+			//↓↓↓ k -- номер вершины на спуске; после выхода за лист биты k -- путь
+			// (1 -- вправо). Ответ -- последняя вершина, где шли влево: убрать хвост
+			// из единиц и еще один бит. 0 -- влево не шли ни разу, ответ end()
+			static size_type last_left_turn(size_type k) {
+				size_type inverted = ~k;
+# if defined(__GNUC__)
+				return k >> (__builtin_ctzl(static_cast<unsigned long>(inverted)) + 1);
+# else
+				while (!(inverted & 1)) {
+					inverted >>= 1;
+					k >>= 1;
+				}
+				return k >> 1;
+# endif
+			}
+
+			template<typename K>
+			size_type lower_index(const K& x) const {
+				size_type k = 1;
+				while (k <= size_) {
+					ft::prefetch(data_ + std::min<size_type>(k * prefetch_stride, size_));
+					k = 2 * k + comp_(key_of(data_[k]), x);
+				}
+				return last_left_turn(k);
+			}
+
+			template<typename K>
+			size_type upper_index(const K& x) const {
+				size_type k = 1;
+				while (k <= size_) {
+					ft::prefetch(data_ + std::min<size_type>(k * prefetch_stride, size_));
+					k = 2 * k + !comp_(x, key_of(data_[k]));
+				}
+				return last_left_turn(k);
+			}
+
+			template<typename InputIterator>
+			void build(InputIterator first, size_type n) {
+				if (n == 0) {
+					return;
+				}
+				data_ = alloc_.allocate(n + 1);
+				size_ = n;
+				size_type built = 0;
+				try {
+					for (size_type k = eytzinger_first(n); k != 0; k = eytzinger_next(k, n), ++first) {
+						alloc_.construct(data_ + k, *first);
+						++built;
+					}
+				} catch (...) {
+					destroy(built);
+					throw;
+				}
+			}
+
+			//↓↓↓ разрушает первые count значений в порядке ключей и освобождает массив
+			void destroy(size_type count) {
+				if (data_ == 0) {
+					return;
+				}
+				for (size_type k = eytzinger_first(size_); count != 0; k = eytzinger_next(k, size_), --count) {
+					alloc_.destroy(data_ + k);
+				}
+				alloc_.deallocate(data_, size_ + 1);
+				data_ = 0;
+				size_ = 0;
+			}
+	};
+
+} // namespace ft
+
+#endif
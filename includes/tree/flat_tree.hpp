@@ -0,0 +1,361 @@
+/*
+// flat_tree -- отсортированный по ключу массив уникальных значений в ft::vector:
+// основа ft::flat_map и ft::flat_set. Вместо узлов дерева -- один непрерывный блок:
+// ни байта на указатели и цвет, поиск -- двоичный по массиву, обход -- подряд по памяти.
+// Одиночная вставка и удаление сдвигают хвост массива (O(n)), поэтому контейнер рассчитан
+// на таблицы, которые строятся один раз или пачками, а потом читаются:
+//		- insert(first, last) копирует пачку в буфер, сортирует ее (устойчиво, при равных
+//		  ключах остается первый) и за один проход сливает с массивом, отбрасывая дубликаты;
+//		- пачка, целиком лежащая правее последнего ключа (построение из пустого контейнера,
+//		  возрастающий поток), дописывается в конец без копирования массива.
+// Значения переносятся конструированием копии и разрушением оригинала, без присваивания,
+// поэтому сортируются и ft::pair<const Key, T>. Исключения из конструктора копирования
+// во время сортировки и сдвигов не поддерживаются (как у tree/btree.hpp).
+// Использованные материалы:
+//		https://www.boost.org/doc/libs/release/doc/html/container/non_standard_containers.html#container.non_standard_containers.flat_xxx
+//		https://en.cppreference.com/w/cpp/container/flat_map
+//		https://arxiv.org/abs/1509.05053
+*/
+
+#ifndef FLAT_TREE_HPP
+# define FLAT_TREE_HPP
+
+# include <algorithm>
+# include <cstddef>
+# include <memory>
+# include "../vector.hpp"
+# include "../utils/pair.hpp"
+# include "../utils/select.hpp"
+
+namespace ft {
+
+	template<typename Key, typename Value, typename KeyOfValue, typename Compare, typename Allocator = std::allocator<Value> >
+	class flat_tree {
+		public:
+			typedef Key													key_type;
+			typedef Value												value_type;
+			typedef Compare												key_compare;
+			typedef Allocator											allocator_type;
+			typedef ft::vector<Value, Allocator>						container_type;
+			typedef typename container_type::size_type					size_type;
+			typedef typename container_type::difference_type			difference_type;
+			typedef typename container_type::iterator					iterator;
+			typedef typename container_type::const_iterator				const_iterator;
+			typedef typename container_type::reverse_iterator			reverse_iterator;
+			typedef typename container_type::const_reverse_iterator		const_reverse_iterator;
+
+		private:
+			//↓↓↓ сортировка пачки: вставками внутри серий run_length, дальше -- слияния серий
+			enum { run_length = 16 };
+
+			container_type	data_;
+			key_compare		comp_;
+
+		public:
+			explicit flat_tree(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) :
+					data_(alloc), comp_(comp) {}
+
+			flat_tree(const flat_tree& other) : data_(other.data_), comp_(other.comp_) {}
+
+			flat_tree& operator=(const flat_tree& other) {
+				data_ = other.data_;
+				comp_ = other.comp_;
+				return *this;
+			}
+
+			iterator begin() { return data_.begin(); }
+			const_iterator begin() const { return data_.begin(); }
+			iterator end() { return data_.end(); }
+			const_iterator end() const { return data_.end(); }
+			reverse_iterator rbegin() { return data_.rbegin(); }
+			const_reverse_iterator rbegin() const { return data_.rbegin(); }
+			reverse_iterator rend() { return data_.rend(); }
+			const_reverse_iterator rend() const { return data_.rend(); }
+
+			bool empty() const { return data_.empty(); }
+			size_type size() const { return data_.size(); }
+			size_type max_size() const { return data_.max_size(); }
+			size_type capacity() const { return data_.capacity(); }
+			void reserve(size_type n) { data_.reserve(n); }
+			key_compare key_comp() const { return comp_; }
+			allocator_type get_allocator() const { return data_.get_allocator(); }
+
+			void clear() {
+				data_.clear();
+			}
+
+			void swap(flat_tree& other) {
+				data_.swap(other.data_);
+				std::swap(comp_, other.comp_);
+			}
+
+// lookup:
+			template<typename K>
+			iterator find(const K& x) {
+				size_type pos = lower_index(x);
+				return (found(pos, x) ? begin() + pos : end());
+			}
+
+			template<typename K>
+			const_iterator find(const K& x) const {
+				size_type pos = lower_index(x);
+				return (found(pos, x) ? begin() + pos : end());
+			}
+
+			template<typename K>
+			size_type count(const K& x) const {
+				return found(lower_index(x), x) ? 1 : 0;
+			}
+
+			template<typename K>
+			iterator lower_bound(const K& x) { return begin() + lower_index(x); }
+			template<typename K>
+			const_iterator lower_bound(const K& x) const { return begin() + lower_index(x); }
+			template<typename K>
+			iterator upper_bound(const K& x) { return begin() + upper_index(x); }
+			template<typename K>
+			const_iterator upper_bound(const K& x) const { return begin() + upper_index(x); }
+
+			template<typename K>
+			ft::pair<iterator, iterator> equal_range(const K& x) {
+				size_type pos = lower_index(x);
+				return ft::pair<iterator, iterator>(begin() + pos, begin() + pos + found(pos, x));
+			}
+
+			template<typename K>
+			ft::pair<const_iterator, const_iterator> equal_range(const K& x) const {
+				size_type pos = lower_index(x);
+				return ft::pair<const_iterator, const_iterator>(begin() + pos, begin() + pos + found(pos, x));
+			}
+
+// modifiers:
+			ft::pair<iterator, bool> insert_unique(const value_type& val) {
+				size_type pos = lower_index(key_of(val));
+				if (found(pos, key_of(val))) {
+					return ft::pair<iterator, bool>(begin() + pos, false);
+				}
+				return ft::pair<iterator, bool>(data_.insert(begin() + pos, val), true);
+			}
+
+			//↓↓↓ верная подсказка (val встает прямо перед hint) избавляет от двоичного поиска,
+			// сдвиг хвоста остается
+			iterator insert_hint(const_iterator hint, const value_type& val) {
+				size_type pos = static_cast<size_type>(hint - begin());
+				const key_type& k = key_of(val);
+				if ((pos == 0 || comp_(key_of(data_[pos - 1]), k)) && (pos == size() || comp_(k, key_of(data_[pos])))) {
+					return data_.insert(begin() + pos, val);
+				}
+				return insert_unique(val).first;
+			}
+
+			//↓↓↓ map::try_emplace и operator[]: если ключ есть, ничего не конструируется
+			template<typename K, typename M>
+			ft::pair<iterator, bool> try_emplace(const K& key, const M& obj) {
+				size_type pos = lower_index(key);
+				if (found(pos, key)) {
+					return ft::pair<iterator, bool>(begin() + pos, false);
+				}
+				return ft::pair<iterator, bool>(data_.insert(begin() + pos, value_type(key, obj)), true);
+			}
+
+			//↓↓↓ пачка: буфер, устойчивая сортировка и одно слияние вместо сдвига на каждый элемент
+			template<typename InputIterator>
+			void insert_range(InputIterator first, InputIterator last) {
+				container_type batch(data_.get_allocator());
+				for (; first != last; ++first) {
+					batch.push_back(*first);
+				}
+				if (batch.size() == 1) {
+					insert_unique(batch[0]);
+				} else if (!batch.empty()) {
+					sort_values(batch);
+					merge_unique(batch);
+				}
+			}
+
+			iterator erase(const_iterator position) {
+				return data_.erase(begin() + (position - begin()));
+			}
+
+			iterator erase(const_iterator first, const_iterator last) {
+				return data_.erase(begin() + (first - begin()), begin() + (last - begin()));
+			}
+
+			template<typename K>
+			size_type erase_key(const K& x) {
+				size_type pos = lower_index(x);
+				if (!found(pos, x)) {
+					return 0;
+				}
+				data_.erase(begin() + pos);
+				return 1;
+			}
+
+		private:
+			static const key_type& key_of(const value_type& val) {
+				return KeyOfValue()(val);
+			}
+
+			template<typename K>
+			bool found(size_type pos, const K& x) const {
+				return pos < size() && !comp_(x, key_of(data_[pos]));
+			}
+
+			//↓↓↓ двоичный поиск без ветвлений по результату сравнения: интервал всегда
+			// делится пополам, выбор половины -- условное присваивание (cmov), а не переход,
+			// поэтому на случайных ключах нет промахов предсказателя
+			template<typename K>
+			size_type lower_index(const K& x) const {
+				size_type n = size();
+				if (n == 0) {
+					return 0;
+				}
+				const value_type* base = &data_[0];
+				while (n > 1) {
+					size_type half = n / 2;
+					base = (comp_(key_of(base[half]), x) ? base + half : base);
+					n -= half;
+				}
+				return static_cast<size_type>(base - &data_[0]) + comp_(key_of(*base), x);
+			}
+
+			template<typename K>
+			size_type upper_index(const K& x) const {
+				size_type n = size();
+				if (n == 0) {
+					return 0;
+				}
+				const value_type* base = &data_[0];
+				while (n > 1) {
+					size_type half = n / 2;
+					base = (!comp_(x, key_of(base[half])) ? base + half : base);
+					n -= half;
+				}
+				return static_cast<size_type>(base - &data_[0]) + !comp_(x, key_of(*base));
+			}
+
+			//↓↓↓ устойчивая сортировка на месте без присваивания. Уже упорядоченная пачка
+			// (частый случай при загрузке) распознается за один проход и не трогается
+			void sort_values(container_type& batch) {
+				size_type n = batch.size();
+				value_type* data = &batch[0];
+				size_type i = 1;
+				while (i < n && !comp_(key_of(data[i]), key_of(data[i - 1]))) {
+					++i;
+				}
+				if (i == n) {
+					return;
+				}
+				allocator_type alloc = batch.get_allocator();
+				for (size_type start = 0; start < n; start += run_length) {
+					insertion_sort(alloc, data + start, std::min<size_type>(run_length, n - start));
+				}
+				if (n <= run_length) {
+					return;
+				}
+				value_type* scratch = alloc.allocate(n);
+				value_type* src = data;
+				value_type* dst = scratch;
+				for (size_type width = run_length; width < n; width *= 2) {
+					for (size_type lo = 0; lo < n; lo += 2 * width) {
+						size_type mid = std::min(lo + width, n);
+						size_type hi = std::min(lo + 2 * width, n);
+						merge_runs(alloc, src + lo, src + mid, src + hi, dst + lo);
+					}
+					std::swap(src, dst);
+				}
+				if (src != data) {
+					relocate(alloc, src, src + n, data);
+				}
+				alloc.deallocate(scratch, n);
+			}
+
+			void insertion_sort(allocator_type& alloc, value_type* first, size_type n) {
+				for (size_type i = 1; i < n; ++i) {
+					if (!comp_(key_of(first[i]), key_of(first[i - 1]))) {
+						continue;
+					}
+					value_type tmp(first[i]);
+					alloc.destroy(first + i);
+					size_type j = i;
+					do {
+						alloc.construct(first + j, first[j - 1]);
+						alloc.destroy(first + j - 1);
+						--j;
+					} while (j > 0 && comp_(key_of(tmp), key_of(first[j - 1])));
+					alloc.construct(first + j, tmp);
+				}
+			}
+
+			//↓↓↓ при равных ключах первым идет элемент левой серии -- сортировка устойчива
+			void merge_runs(allocator_type& alloc, value_type* a, value_type* mid, value_type* last, value_type* out) {
+				value_type* b = mid;
+				while (a != mid && b != last) {
+					value_type*& from = (comp_(key_of(*b), key_of(*a)) ? b : a);
+					alloc.construct(out++, *from);
+					alloc.destroy(from++);
+				}
+				out = relocate(alloc, a, mid, out);
+				relocate(alloc, b, last, out);
+			}
+
+			static value_type* relocate(allocator_type& alloc, value_type* first, value_type* last, value_type* out) {
+				for (; first != last; ++first, ++out) {
+					alloc.construct(out, *first);
+					alloc.destroy(first);
+				}
+				return out;
+			}
+
+			//↓↓↓ слияние отсортированной пачки с массивом: из равных ключей пачки берется первый,
+			// ключ, который уже есть в массиве, не заменяется (как у insert)
+			void merge_unique(const container_type& batch) {
+				size_type n = size();
+				size_type m = batch.size();
+				if (n == 0 || comp_(key_of(data_[n - 1]), key_of(batch[0]))) {
+					data_.reserve(n + m);
+					append_unique(batch, 0);
+					return;
+				}
+				container_type out(data_.get_allocator());
+				out.reserve(n + m);
+				size_type i = 0;
+				size_type j = 0;
+				while (j < m) {
+					if (i < n && !comp_(key_of(batch[j]), key_of(data_[i]))) {
+						if (!comp_(key_of(data_[i]), key_of(batch[j]))) {
+							++j;
+						} else {
+							out.push_back(data_[i++]);
+						}
+					} else {
+						out.push_back(batch[j]);
+						j = skip_equal(batch, j);
+					}
+				}
+				for (; i < n; ++i) {
+					out.push_back(data_[i]);
+				}
+				data_.swap(out);
+			}
+
+			void append_unique(const container_type& batch, size_type j) {
+				while (j < batch.size()) {
+					data_.push_back(batch[j]);
+					j = skip_equal(batch, j);
+				}
+			}
+
+			//↓↓↓ индекс первого элемента после batch[j] с большим ключом
+			size_type skip_equal(const container_type& batch, size_type j) const {
+				size_type next = j + 1;
+				while (next < batch.size() && !comp_(key_of(batch[j]), key_of(batch[next]))) {
+					++next;
+				}
+				return next;
+			}
+	};
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,525 @@
+/*
+// HashTable -- хеш-таблица с открытой адресацией: основа ft::unordered_map и ft::unordered_set.
+// Ячейки разбиты на группы по 16. На каждую ячейку -- управляющий байт: 0x80 -- пусто,
+// иначе 7 старших бит перемешанного хеша (тег). Поиск загружает 16 управляющих байт группы
+// одной инструкцией SSE2 и сравнивает с тегом сразу все, ключи сравниваются только у совпавших
+// тегов (ложное совпадение -- 1/128 на ячейку). Без SSE2 -- тот же алгоритм циклом по байтам.
+// Группы перебираются по треугольным числам (g, g+1, g+3, g+6, ...) -- при числе групп,
+// равном степени двойки, так обходятся все группы.
+// Удаление без надгробий: у каждой группы есть счетчик элементов, которые прошли через нее
+// дальше по своей последовательности, потому что группа была заполнена. Поиск останавливается
+// на первой группе без совпадения, у которой счетчик 0, удаление уменьшает счетчики на пути
+// элемента и просто освобождает ячейку -- таблица не засоряется после erase/insert.
+// Счетчик насыщается на 255 и тогда больше не уменьшается (поиск лишь идет дальше нужного).
+// Таблица растет вдвое при заполнении больше 7/8.
+// Ограничения:
+//		- вставка с рехешированием делает недействительными все итераторы и ссылки,
+//		  удаление -- только на удаленный элемент;
+//		- Hash -- любой функтор size_t(const Key&): хеш перемешивается умножением,
+//		  поэтому годится и тождественный хеш целых (ft::hash, utils/hash.hpp).
+// Использованные материалы:
+//		https://abseil.io/about/design/swisstables
+//		https://engineering.fb.com/2019/04/25/developer-tools/f14/
+//		https://github.com/abseil/abseil-cpp/blob/master/absl/container/internal/raw_hash_set.h
+*/
+
+#ifndef HASH_TABLE_HPP
+# define HASH_TABLE_HPP
+
+# include <algorithm>
+# include <cstddef>
+# include <cstring>
+# include <functional>
+# include <memory>
+# include "../iterators/Hash_iterator.hpp"
+# include "../utils/pair.hpp"
+# include "../utils/pool_allocator.hpp"
+# include "../utils/select.hpp"
+
+# if defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+
+namespace ft {
+
+	//↓↓↓ 16 управляющих байт одной группы: маски ячеек с данным тегом и пустых ячеек (бит i -- ячейка i)
+	class Hash_group {
+		private:
+# if defined(__SSE2__)
+			__m128i			ctrl_;
+# else
+			const unsigned char*	ctrl_;
+# endif
+
+		public:
+			enum { size = 16 };
+
+# if defined(__SSE2__)
+			explicit Hash_group(const unsigned char* ctrl) :
+					ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+			unsigned match(unsigned char tag) const {
+				return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(static_cast<char>(tag)))));
+			}
+
+			//↓↓↓ у пустой ячейки (0x80) старший бит установлен, у занятой -- нет
+			unsigned match_empty() const {
+				return static_cast<unsigned>(_mm_movemask_epi8(ctrl_));
+			}
+# else
+			explicit Hash_group(const unsigned char* ctrl) : ctrl_(ctrl) {}
+
+			unsigned match(unsigned char tag) const {
+				unsigned bits = 0;
+				for (int i = 0; i < size; ++i) {
+					bits |= static_cast<unsigned>(ctrl_[i] == tag) << i;
+				}
+				return bits;
+			}
+
+			unsigned match_empty() const {
+				unsigned bits = 0;
+				for (int i = 0; i < size; ++i) {
+					bits |= static_cast<unsigned>(ctrl_[i] >> 7) << i;
+				}
+				return bits;
+			}
+# endif
+
+			static unsigned lowest(unsigned bits) {
+# if defined(__GNUC__)
+				return static_cast<unsigned>(__builtin_ctz(bits));
+# else
+				unsigned i = 0;
+				for (; !(bits & 1); bits >>= 1) {
+					++i;
+				}
+				return i;
+# endif
+			}
+	};
+
+	//↓↓↓ управляющий байт пустой таблицы: begin() == end() без выделения памяти
+	template<typename T>
+	struct Hash_sentinel {
+		static const unsigned char ctrl;
+	};
+
+	template<typename T>
+	const unsigned char Hash_sentinel<T>::ctrl = 0xFF;
+
+	template<typename Key, typename Value, typename KeyOfValue, typename Hash, typename KeyEqual,
+			typename Allocator = std::allocator<Value> >
+	class HashTable {
+		public:
+			typedef Key													key_type;
+			typedef Value												value_type;
+			typedef Hash												hasher;
+			typedef KeyEqual											key_equal;
+			typedef Allocator											allocator_type;
+			typedef typename allocator_type::size_type					size_type;
+			typedef std::ptrdiff_t										difference_type;
+			typedef ft::Hash_iterator<Value>							iterator;
+			typedef ft::Hash_iterator<const Value>						const_iterator;
+
+			enum {
+				group_size = Hash_group::size,
+				max_overflow = 255
+			};
+
+		private:
+			typedef typename allocator_type::template rebind<unsigned char>::other	allocator_byte;
+
+			static const unsigned char	ctrl_empty = 0x80;
+			static const unsigned char	ctrl_sentinel = 0xFF;
+
+			unsigned char*		ctrl_;
+			unsigned char*		overflow_;
+			value_type*			slots_;
+			size_type			capacity_;
+			size_type			size_;
+			hasher				hash_;
+			key_equal			eq_;
+			allocator_type		alloc_;
+
+		public:
+			HashTable(const hasher& hash, const key_equal& eq, const allocator_type& alloc) :
+					ctrl_(0), overflow_(0), slots_(0), capacity_(0), size_(0), hash_(hash), eq_(eq), alloc_(alloc) {}
+
+			HashTable(const HashTable& other) :
+					ctrl_(0), overflow_(0), slots_(0), capacity_(0), size_(0),
+					hash_(other.hash_), eq_(other.eq_), alloc_(other.alloc_) {
+				if (other.size_ == 0) {
+					return;
+				}
+				allocate(capacity_for(other.size_));
+				try {
+					for (const_iterator it = other.begin(); it != other.end(); ++it) {
+						insert_distinct(*it);
+					}
+				} catch (...) {
+					destroy_all();
+					throw;
+				}
+			}
+
+			HashTable& operator=(const HashTable& other) {
+				if (this != &other) {
+					HashTable tmp(other);
+					swap(tmp);
+				}
+				return *this;
+			}
+
+			~HashTable() {
+				destroy_all();
+			}
+
+			iterator begin() { return make_iterator(first_index()); }
+			const_iterator begin() const { return make_iterator(first_index()); }
+			iterator end() { return make_iterator(capacity_); }
+			const_iterator end() const { return make_iterator(capacity_); }
+
+			bool empty() const { return size_ == 0; }
+			size_type size() const { return size_; }
+			size_type max_size() const { return alloc_.max_size(); }
+			size_type bucket_count() const { return capacity_; }
+			float load_factor() const { return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f; }
+			float max_load_factor() const { return 0.875f; }
+			hasher hash_function() const { return hash_; }
+			key_equal key_eq() const { return eq_; }
+			allocator_type get_allocator() const { return alloc_; }
+
+			void clear() {
+				if (size_ != 0) {
+					destroy_values();
+					reset_ctrl();
+				}
+				ft::release_allocator(alloc_);
+			}
+
+			void swap(HashTable& other) {
+				std::swap(ctrl_, other.ctrl_);
+				std::swap(overflow_, other.overflow_);
+				std::swap(slots_, other.slots_);
+				std::swap(capacity_, other.capacity_);
+				std::swap(size_, other.size_);
+				std::swap(hash_, other.hash_);
+				std::swap(eq_, other.eq_);
+				//↓↓↓ массивы остаются за тем аллокатором, который их выделил (важно для pool_allocator).
+				// Через swap идут и рехеширование, и присваивание
+				ft::swap_allocator(alloc_, other.alloc_);
+			}
+
+			//↓↓↓ место под n элементов без рехеширования
+			void reserve(size_type n) {
+				if (n > max_load(capacity_)) {
+					rehash_to(capacity_for(n));
+				}
+			}
+
+			//↓↓↓ как std::unordered_map::rehash: не меньше n ячеек и не меньше нужного для size()
+			void rehash(size_type n) {
+				if (n == 0 && size_ == 0) {
+					destroy_all();
+					return;
+				}
+				size_type capacity = capacity_for(size_);
+				while (capacity < n) {
+					capacity *= 2;
+				}
+				if (capacity != capacity_) {
+					rehash_to(capacity);
+				}
+			}
+
+// lookup:
+			iterator find(const key_type& key) { return make_iterator(find_index(key)); }
+			const_iterator find(const key_type& key) const { return make_iterator(find_index(key)); }
+			size_type count(const key_type& key) const { return find_index(key) != capacity_; }
+
+			ft::pair<iterator, iterator> equal_range(const key_type& key) {
+				iterator it = find(key);
+				iterator last = it;
+				return ft::pair<iterator, iterator>(it, it == end() ? last : ++last);
+			}
+
+			ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+				const_iterator it = find(key);
+				const_iterator last = it;
+				return ft::pair<const_iterator, const_iterator>(it, it == end() ? last : ++last);
+			}
+
+// modifiers:
+			ft::pair<iterator, bool> insert_unique(const value_type& val) {
+				return insert_new(key_of(val), val);
+			}
+
+			//↓↓↓ map::try_emplace и operator[]: если ключ есть, ничего не конструируется,
+			// иначе value_type(key, obj) строится прямо в ячейке. obj может быть значением элемента
+			// этой же таблицы (m.try_emplace(k, m[other])) -- тогда перед rehash с него снимается
+			// копия. Ключ элемента таблицы всегда найден и до вставки не доходит
+			template<typename M>
+			ft::pair<iterator, bool> try_emplace(const key_type& key, const M& obj) {
+				size_type i = find_index(key);
+				if (i != capacity_) {
+					return ft::pair<iterator, bool>(make_iterator(i), false);
+				}
+				if (size_ + 1 > max_load(capacity_)) {
+					if (in_table(&obj)) {
+						value_type val(key, obj);
+						rehash_to(grown_capacity());
+						return ft::pair<iterator, bool>(make_iterator(insert_distinct(val)), true);
+					}
+					rehash_to(grown_capacity());
+				}
+				std::size_t h = mix(key);
+				i = find_slot(h);
+				::new (static_cast<void*>(slots_ + i)) value_type(ft::pair_ref<key_type, M>(key, obj));
+				occupy(i, h);
+				return ft::pair<iterator, bool>(make_iterator(i), true);
+			}
+
+			template<typename InputIterator>
+			void insert_range(InputIterator first, InputIterator last) {
+				for (; first != last; ++first) {
+					insert_unique(*first);
+				}
+			}
+
+			//↓↓↓ остальные элементы не двигаются: следующий -- просто следующая занятая ячейка
+			iterator erase(const_iterator position) {
+				size_type i = static_cast<size_type>(position.slot() - slots_);
+				erase_index(i);
+				iterator next = make_iterator(i);
+				return ++next;
+			}
+
+			iterator erase(const_iterator first, const_iterator last) {
+				while (first != last) {
+					first = erase(first);
+				}
+				return make_iterator(static_cast<size_type>(last.slot() - slots_));
+			}
+
+			size_type erase_key(const key_type& key) {
+				size_type i = find_index(key);
+				if (i == capacity_) {
+					return 0;
+				}
+				erase_index(i);
+				return 1;
+			}
+
+		private:
+			static const key_type& key_of(const value_type& val) {
+				return KeyOfValue()(val);
+			}
+
+			static size_type max_load(size_type capacity) {
+				return capacity - capacity / 8;
+			}
+
+			static size_type capacity_for(size_type n) {
+				size_type capacity = group_size;
+				while (max_load(capacity) < n) {
+					capacity *= 2;
+				}
+				return capacity;
+			}
+
+			size_type group_mask() const {
+				return capacity_ / group_size - 1;
+			}
+
+			//↓↓↓ хешер пользователя может быть слабым (у ft::hash<int> -- тождество): умножение
+			// на нечетную константу поднимает энтропию в старшие биты, свертка возвращает ее в младшие.
+			// Младшие биты -- номер группы, 7 старших -- тег
+			std::size_t mix(const key_type& key) const {
+				std::size_t h = hash_(key) * static_cast<std::size_t>(0x9E3779B97F4A7C15ULL);
+				return h ^ (h >> (sizeof(std::size_t) * 4));
+			}
+
+			static unsigned char tag_of(std::size_t h) {
+				return static_cast<unsigned char>(h >> (sizeof(std::size_t) * 8 - 7));
+			}
+
+			size_type next_group(size_type g, size_type& step) const {
+				return (g + ++step) & group_mask();
+			}
+
+			iterator make_iterator(size_type i) {
+				return capacity_ ? iterator(ctrl_ + i, slots_ + i) : iterator(&Hash_sentinel<void>::ctrl, 0);
+			}
+
+			const_iterator make_iterator(size_type i) const {
+				return capacity_ ? const_iterator(ctrl_ + i, slots_ + i) : const_iterator(&Hash_sentinel<void>::ctrl, 0);
+			}
+
+			//↓↓↓ первая занятая ячейка, по 16 управляющих байт за шаг
+			size_type first_index() const {
+				for (size_type i = 0; i < capacity_ && size_ != 0; i += group_size) {
+					unsigned full = ~Hash_group(ctrl_ + i).match_empty() & 0xFFFF;
+					if (full != 0) {
+						return i + Hash_group::lowest(full);
+					}
+				}
+				return capacity_;
+			}
+
+			size_type find_index(const key_type& key) const {
+				if (size_ == 0) {
+					return capacity_;
+				}
+				std::size_t h = mix(key);
+				unsigned char tag = tag_of(h);
+				size_type g = h & group_mask();
+				for (size_type step = 0; ; g = next_group(g, step)) {
+					size_type base = g * group_size;
+					for (unsigned bits = Hash_group(ctrl_ + base).match(tag); bits != 0; bits &= bits - 1) {
+						size_type i = base + Hash_group::lowest(bits);
+						if (eq_(key, key_of(slots_[i]))) {
+							return i;
+						}
+					}
+					if (overflow_[g] == 0 || step == group_mask()) {
+						return capacity_;
+					}
+				}
+			}
+
+			//↓↓↓ первая свободная ячейка на пути ключа с хешем h; при заполнении
+			// не больше 7/8 свободная ячейка всегда есть
+			size_type find_slot(std::size_t h) const {
+				size_type g = h & group_mask();
+				for (size_type step = 0; ; g = next_group(g, step)) {
+					unsigned bits = Hash_group(ctrl_ + g * group_size).match_empty();
+					if (bits != 0) {
+						return g * group_size + Hash_group::lowest(bits);
+					}
+				}
+			}
+
+			ft::pair<iterator, bool> insert_new(const key_type& key, const value_type& val) {
+				size_type i = find_index(key);
+				if (i != capacity_) {
+					return ft::pair<iterator, bool>(make_iterator(i), false);
+				}
+				if (size_ + 1 > max_load(capacity_)) {
+					rehash_to(grown_capacity());
+				}
+				return ft::pair<iterator, bool>(make_iterator(insert_distinct(val)), true);
+			}
+
+			size_type grown_capacity() const {
+				return capacity_ ? capacity_ * 2 : capacity_for(1);
+			}
+
+			//↓↓↓ лежит ли объект в массиве ячеек (std::less дает порядок и для несвязанных указателей)
+			bool in_table(const void* p) const {
+				std::less<const void*> less;
+				return capacity_ != 0 && !less(p, static_cast<const void*>(slots_))
+					&& less(p, static_cast<const void*>(slots_ + capacity_));
+			}
+
+			//↓↓↓ вставка ключа, которого точно нет, в таблицу, где есть место
+			size_type insert_distinct(const value_type& val) {
+				std::size_t h = mix(key_of(val));
+				size_type i = find_slot(h);
+				alloc_.construct(slots_ + i, val);
+				occupy(i, h);
+				return i;
+			}
+
+			//↓↓↓ значение уже построено в ячейке i. Ячейка и счетчики меняются после
+			// конструирования -- исключение ничего не портит
+			void occupy(size_type i, std::size_t h) {
+				size_type target = i / group_size;
+				size_type g = h & group_mask();
+				for (size_type step = 0; g != target; g = next_group(g, step)) {
+					if (overflow_[g] != max_overflow) {
+						++overflow_[g];
+					}
+				}
+				ctrl_[i] = tag_of(h);
+				++size_;
+			}
+
+			void erase_index(size_type i) {
+				std::size_t h = mix(key_of(slots_[i]));
+				size_type target = i / group_size;
+				size_type g = h & group_mask();
+				for (size_type step = 0; g != target; g = next_group(g, step)) {
+					if (overflow_[g] != max_overflow) {
+						--overflow_[g];
+					}
+				}
+				alloc_.destroy(slots_ + i);
+				ctrl_[i] = ctrl_empty;
+				--size_;
+			}
+
+			//↓↓↓ управляющие байты, сторожевой байт и счетчики групп -- один блок
+			void allocate(size_type capacity) {
+				allocator_byte alloc_byte(alloc_);
+				size_type groups = capacity / group_size;
+				slots_ = alloc_.allocate(capacity);
+				try {
+					ctrl_ = alloc_byte.allocate(capacity + 1 + groups);
+				} catch (...) {
+					alloc_.deallocate(slots_, capacity);
+					slots_ = 0;
+					throw;
+				}
+				overflow_ = ctrl_ + capacity + 1;
+				capacity_ = capacity;
+				reset_ctrl();
+			}
+
+			void reset_ctrl() {
+				std::memset(ctrl_, ctrl_empty, capacity_);
+				ctrl_[capacity_] = ctrl_sentinel;
+				std::memset(overflow_, 0, capacity_ / group_size);
+				size_ = 0;
+			}
+
+			void destroy_values() {
+				for (size_type i = 0; i < capacity_; ++i) {
+					if (ctrl_[i] != ctrl_empty) {
+						alloc_.destroy(slots_ + i);
+					}
+				}
+			}
+
+			void destroy_all() {
+				if (capacity_ == 0) {
+					return;
+				}
+				destroy_values();
+				allocator_byte(alloc_).deallocate(ctrl_, capacity_ + 1 + capacity_ / group_size);
+				alloc_.deallocate(slots_, capacity_);
+				ctrl_ = 0;
+				overflow_ = 0;
+				slots_ = 0;
+				capacity_ = 0;
+				size_ = 0;
+				ft::release_allocator(alloc_);
+			}
+
+			//↓↓↓ значения копируются в новую таблицу, старая освобождается только после
+			// успешного копирования всех -- исключение оставляет таблицу как была
+			void rehash_to(size_type capacity) {
+				HashTable tmp(hash_, eq_, alloc_);
+				tmp.allocate(capacity);
+				for (size_type i = 0; i < capacity_; ++i) {
+					if (ctrl_[i] != ctrl_empty) {
+						tmp.insert_distinct(slots_[i]);
+					}
+				}
+				swap(tmp);
+			}
+	};
+
+} // namespace ft
+
+#endif
@@ -1,41 +1,270 @@
 #ifndef RB_NODE_HPP
 # define RB_NODE_HPP
 
+# include <cstddef>
+
 namespace ft {
 
-	typedef enum { black, red, nil} NodeColor;
+	typedef enum { black, red } NodeColor;
 
-	template<typename Value>
-	class RB_Node {
+	//↓↓↓ только связи и цвет: из таких узлов состоит каркас дерева, в том числе nil_.
+	// Цвет хранится в младшем бите указателя на родителя (узлы выровнены минимум на 4),
+	// поэтому каркас -- три слова. Отдельного цвета nil нет: nil_ -- черный узел,
+	// который узнается по петле right_ == this (у настоящего узла такой петли быть не может).
+	// AVL-балансировка занимает оба младших бита: в них показатель баланса + 1.
+	class RB_Node_base {
 		public:
-			typedef RB_Node*	node_pointer;
+			typedef RB_Node_base*	node_pointer;
 
-			node_pointer		parent_;
 			node_pointer		left_;
 			node_pointer		right_;
-			NodeColor			type_;
-			Value*				value_;
 
-			RB_Node(node_pointer parent, node_pointer left, node_pointer right, NodeColor type = black, Value *value = NULL) :
-					parent_(parent), left_(left), right_(right), type_(type), value_(value) { }
-			
-			RB_Node(const RB_Node &rhs) {
+		private:
+			static const std::size_t	tag_mask = 3;
+
+			std::size_t			parent_color_;
+
+		public:
+			RB_Node_base(node_pointer parent, node_pointer left, node_pointer right, NodeColor color = black) :
+					left_(left), right_(right),
+					parent_color_(reinterpret_cast<std::size_t>(parent) | static_cast<std::size_t>(color)) { }
+
+			RB_Node_base(const RB_Node_base &rhs) {
 				*this = rhs;
 			}
 
-			RB_Node& operator=(const RB_Node& rhs) {
+			RB_Node_base& operator=(const RB_Node_base& rhs) {
 				if (this == &rhs) {
 					return *this;
 				}
-				parent_ = rhs.parent_;
 				left_ = rhs.left_;
 				right_ = rhs.right_;
-				type_ = rhs.type_;
-				value_ = rhs.value_;
+				parent_color_ = rhs.parent_color_;
 				return *this;
 			}
-			
-			~RB_Node() {}
+
+			~RB_Node_base() {}
+
+			node_pointer parent() const {
+				return reinterpret_cast<node_pointer>(parent_color_ & ~tag_mask);
+			}
+
+			void set_parent(node_pointer parent) {
+				parent_color_ = reinterpret_cast<std::size_t>(parent) | (parent_color_ & tag_mask);
+			}
+
+			NodeColor color() const {
+				return static_cast<NodeColor>(parent_color_ & 1);
+			}
+
+			void set_color(NodeColor color) {
+				parent_color_ = (parent_color_ & ~static_cast<std::size_t>(1)) | static_cast<std::size_t>(color);
+			}
+
+			//↓↓↓ высота правого поддерева минус высота левого: -1, 0 или 1 (avl_balance)
+			int balance() const {
+				return static_cast<int>(parent_color_ & tag_mask) - 1;
+			}
+
+			void set_balance(int balance) {
+				parent_color_ = (parent_color_ & ~tag_mask) | static_cast<std::size_t>(balance + 1);
+			}
+
+			//↓↓↓ цвет или показатель баланса целиком: узел, встающий на место удаленного, забирает его метку
+			std::size_t tag() const {
+				return parent_color_ & tag_mask;
+			}
+
+			void set_tag(std::size_t tag) {
+				parent_color_ = (parent_color_ & ~tag_mask) | tag;
+			}
+
+			bool is_nil() const {
+				return right_ == this;
+			}
+	};
+
+	//↓↓↓ значение хранится прямо в узле: одно выделение памяти на элемент.
+	// Узел никогда не конструируется целиком -- дерево выделяет память под RB_Node,
+	// конструирует value_ через аллокатор значений и выставляет связи вручную.
+	template<typename Value>
+	class RB_Node : public RB_Node_base {
+		public:
+			Value				value_;
+
+		private:
+			RB_Node();
+			RB_Node(const RB_Node &rhs);
+			RB_Node& operator=(const RB_Node& rhs);
+	};
+
+	//↓↓↓ узел с размером поддерева: count_ = count(left) + count(right) + 1
+	template<typename Value>
+	class RB_Node_counted : public RB_Node<Value> {
+		public:
+			std::size_t			count_;
+
+		private:
+			RB_Node_counted();
+			RB_Node_counted(const RB_Node_counted &rhs);
+			RB_Node_counted& operator=(const RB_Node_counted& rhs);
+	};
+
+	//↓↓↓ каркас прошитого дерева: узлы и nil_ связаны в кольцевой список в порядке обхода.
+	// nil_->next_ -- первый узел, nil_->prev_ -- последний; в пустом дереве nil_ указывает сам на себя
+	class RB_Thread_base : public RB_Node_base {
+		public:
+			node_pointer		next_;
+			node_pointer		prev_;
+
+			RB_Thread_base(node_pointer parent, node_pointer left, node_pointer right, NodeColor type = black) :
+					RB_Node_base(parent, left, right, type), next_(0), prev_(0) { }
+	};
+
+	template<typename Value>
+	class RB_Node_threaded : public RB_Thread_base {
+		public:
+			Value				value_;
+
+		private:
+			RB_Node_threaded();
+			RB_Node_threaded(const RB_Node_threaded &rhs);
+			RB_Node_threaded& operator=(const RB_Node_threaded& rhs);
+	};
+
+	//↓↓↓ узел RBTree_indexed: связи -- 32-битные индексы в общем массиве узлов, 0 -- nil.
+	// Цвет -- младший бит parent_color_, поэтому индекс родителя не больше 2^31 - 1.
+	// Как и RB_Node, целиком не конструируется: дерево пишет связи и конструирует value_ само.
+	template<typename Value>
+	class RB_Node_indexed {
+		public:
+			typedef unsigned int	index_type;
+
+			index_type			left_;
+			index_type			right_;
+			index_type			parent_color_;
+			Value				value_;
+
+		private:
+			RB_Node_indexed();
+			RB_Node_indexed(const RB_Node_indexed &rhs);
+			RB_Node_indexed& operator=(const RB_Node_indexed& rhs);
+	};
+
+	//↓↓↓ узел RBTree_persistent: без родителя, потому что поддерево может входить
+	// в несколько версий дерева сразу. Младший бит refs_color_ -- цвет, остальные --
+	// число ссылок на узел (из родителей и корней версий). Узел с одной ссылкой
+	// принадлежит одной версии и меняется на месте, общий -- сначала копируется.
+	template<typename Value>
+	class RB_Node_persistent {
+		public:
+			typedef RB_Node_persistent*	node_pointer;
+
+			node_pointer		left_;
+			node_pointer		right_;
+
+		private:
+			std::size_t			refs_color_;
+
+		public:
+			Value				value_;
+
+			void init(NodeColor color) {
+				left_ = right_ = 0;
+				refs_color_ = 2 | static_cast<std::size_t>(color);
+			}
+
+			std::size_t refs() const { return refs_color_ >> 1; }
+			void acquire() { refs_color_ += 2; }
+
+			//↓↓↓ возвращает оставшееся число ссылок
+			std::size_t release() {
+				refs_color_ -= 2;
+				return refs_color_ >> 1;
+			}
+
+			NodeColor color() const {
+				return static_cast<NodeColor>(refs_color_ & 1);
+			}
+
+			void set_color(NodeColor color) {
+				refs_color_ = (refs_color_ & ~static_cast<std::size_t>(1)) | static_cast<std::size_t>(color);
+			}
+
+			void flip_color() {
+				refs_color_ ^= 1;
+			}
+
+		private:
+			RB_Node_persistent();
+			RB_Node_persistent(const RB_Node_persistent &rhs);
+			RB_Node_persistent& operator=(const RB_Node_persistent& rhs);
+	};
+
+	//↓↓↓ политики узла (последний параметр шаблона RBTree, map и set).
+	// node<Value>::type -- тип выделяемого узла, header -- тип nil_,
+	// order_statistic -- поддерживать ли размеры поддеревьев, threaded -- прошивку.
+	struct null_node_update {
+		template<typename Value> struct node { typedef RB_Node<Value> type; };
+		typedef RB_Node_base	header;
+		static const bool order_statistic = false;
+		static const bool threaded = false;
+	};
+
+	//↓↓↓ nth(k), rank(key) и distance(first, last) за O(log n) ценой
+	// лишнего поля в каждом узле и подъема до корня при вставке и удалении
+	struct order_statistic_node_update {
+		template<typename Value> struct node { typedef RB_Node_counted<Value> type; };
+		typedef RB_Node_base	header;
+		static const bool order_statistic = true;
+		static const bool threaded = false;
+	};
+
+	//↓↓↓ ++ и -- итератора -- одна загрузка next_/prev_ вместо подъема по parent_,
+	// ценой двух указателей в каждом узле. Повороты порядок обхода не меняют,
+	// поэтому прошивку правят только вставка и удаление узла.
+	struct threaded_node_update {
+		template<typename Value> struct node { typedef RB_Node_threaded<Value> type; };
+		typedef RB_Thread_base	header;
+		static const bool order_statistic = false;
+		static const bool threaded = true;
+	};
+
+	//↓↓↓ не политика узла, а другое хранилище: map и set строятся на RBTree_indexed
+	// (tree/rb_tree_indexed.hpp) -- узлы в одном массиве, связи -- 32-битные индексы
+	struct indexed_node_storage {
+		template<typename Value> struct node { typedef RB_Node_indexed<Value> type; };
+		static const bool order_statistic = false;
+		static const bool threaded = false;
+	};
+
+	//↓↓↓ map и set строятся на RBTree_persistent (tree/rb_tree_persistent.hpp):
+	// копия контейнера -- снимок за O(1), запись копирует только общие узлы своего пути
+	struct persistent_node_storage {
+		template<typename Value> struct node { typedef RB_Node_persistent<Value> type; };
+		static const bool order_statistic = false;
+		static const bool threaded = false;
+	};
+
+	//↓↓↓ политики балансировки RBTree (параметр Balance у map и set, после NodeUpdate).
+	// Узел и итераторы у всех одни и те же, меняются только вставка и удаление.
+	// red_black -- есть ли split/join за O(log n) (см. RBTree::split); у остальных
+	// алгебра множеств поэлементная.
+	struct red_black_balance {
+		static const bool red_black = true;
+	};
+
+	//↓↓↓ высоты поддеревьев отличаются не больше чем на 1: дерево ниже красно-черного
+	// (1.44 log n против 2 log n), поиск быстрее, вставка и удаление чаще вращают
+	struct avl_balance {
+		static const bool red_black = false;
+	};
+
+	//↓↓↓ самонастраивающееся дерево: найденный (неконстантным find), вставленный
+	// или запрошенный operator[] элемент поднимается в корень. Частые ключи оказываются
+	// у корня, оценка O(log n) -- амортизированная; константный поиск дерево не меняет
+	struct splay_balance {
+		static const bool red_black = false;
 	};
 
 } //namespace ft
@@ -0,0 +1,137 @@
+/*
+// RBTree_node_handle -- извлеченный из RBTree узел вместе со значением (node handle из C++17).
+// extract отцепляет узел от дерева, insert(node) подвешивает его к другому дереву того же типа:
+// память не выделяется и не освобождается, значение не копируется (см. ограничения).
+//		ft::map<K, V>::node_type nh = a.extract(key);
+//		b.insert(nh);
+// В C++98 нет перемещения, поэтому копия handle забирает узел, а источник становится
+// пустым (как у std::auto_ptr). Пустой handle ничего не делает, непустой при разрушении
+// удаляет свой узел.
+// Ограничения:
+//		- узел переходит без копирования, только если аллокатор handle равен аллокатору
+//		  контейнера (std::allocator, ft::pool_allocator с тем же пулом). Иначе insert(node)
+//		  копирует значение в новый узел, а узел handle освобождает его собственный аллокатор
+//		  -- так же merge переносит элементы между контейнерами с разными пулами;
+//		- handle есть только у RBTree: у RBTree_indexed узлы лежат в общем массиве,
+//		  у RBTree_persistent -- общие у нескольких версий дерева.
+// Использованные материалы:
+//		https://en.cppreference.com/w/cpp/container/node_handle
+//		https://eel.is/c++draft/container.node
+*/
+
+#ifndef RB_NODE_HANDLE_HPP
+# define RB_NODE_HANDLE_HPP
+
+# include <algorithm>
+# include "../iterators/RBTree_iterator.hpp"
+# include "../utils/pair.hpp"
+
+namespace ft {
+
+	template<typename Value, typename Compare, typename Allocator, typename NodeUpdate, typename Balance>
+	class RBTree;
+
+	//↓↓↓ key() и mapped() для map (value_type -- ft::pair<const Key, T>); у set ключ -- само значение
+	template<typename Value>
+	struct node_handle_traits {
+		typedef Value							key_type;
+		typedef Value							mapped_type;
+
+		static key_type& key(Value& value) { return value; }
+		static mapped_type& mapped(Value& value) { return value; }
+	};
+
+	template<typename Key, typename T>
+	struct node_handle_traits<ft::pair<const Key, T> > {
+		typedef Key								key_type;
+		typedef T								mapped_type;
+
+		//↓↓↓ узел вне дерева, поэтому ключ можно менять до вставки (как в std::map::node_type)
+		static key_type& key(ft::pair<const Key, T>& value) { return const_cast<key_type&>(value.first); }
+		static mapped_type& mapped(ft::pair<const Key, T>& value) { return value.second; }
+	};
+
+	template<typename Node, typename Value, typename Allocator>
+	class RBTree_node_handle {
+		public:
+			typedef Value												value_type;
+			typedef Allocator											allocator_type;
+			typedef typename node_handle_traits<Value>::key_type		key_type;
+			typedef typename node_handle_traits<Value>::mapped_type		mapped_type;
+
+		private:
+			typedef typename allocator_type::template rebind<Node>::other	allocator_node;
+
+			template<typename, typename, typename, typename, typename> friend class RBTree;
+
+			mutable Node*		node_;
+			allocator_type		alloc_;
+
+			RBTree_node_handle(Node* node, const allocator_type& alloc) : node_(node), alloc_(alloc) {}
+
+			Node* release() const {
+				Node* node = node_;
+				node_ = 0;
+				return node;
+			}
+
+			void reset() {
+				if (node_) {
+					allocator_node alloc_node(alloc_);
+					alloc_.destroy(&node_->value_);
+					alloc_node.deallocate(node_, 1);
+					node_ = 0;
+				}
+			}
+
+		public:
+			RBTree_node_handle() : node_(0), alloc_() {}
+
+			RBTree_node_handle(const RBTree_node_handle& rhs) : node_(rhs.release()), alloc_(rhs.alloc_) {}
+
+			RBTree_node_handle& operator=(const RBTree_node_handle& rhs) {
+				if (this != &rhs) {
+					reset();
+					alloc_ = rhs.alloc_;
+					node_ = rhs.release();
+				}
+				return *this;
+			}
+
+			~RBTree_node_handle() {
+				reset();
+			}
+
+			bool empty() const { return node_ == 0; }
+			allocator_type get_allocator() const { return alloc_; }
+
+			value_type& value() const { return node_->value_; }
+			key_type& key() const { return node_handle_traits<Value>::key(node_->value_); }
+			mapped_type& mapped() const { return node_handle_traits<Value>::mapped(node_->value_); }
+
+			void swap(RBTree_node_handle& rhs) {
+				std::swap(node_, rhs.node_);
+				std::swap(alloc_, rhs.alloc_);
+			}
+	};
+
+	template<typename Node, typename Value, typename Allocator>
+	void swap(RBTree_node_handle<Node, Value, Allocator>& lhs, RBTree_node_handle<Node, Value, Allocator>& rhs) {
+		lhs.swap(rhs);
+	}
+
+	//↓↓↓ результат insert(node): если ключ уже занят, узел возвращается в node, а position -- на занявший элемент
+	template<typename Iterator, typename NodeType>
+	struct RBTree_insert_return {
+		Iterator		position;
+		bool			inserted;
+		NodeType		node;
+	};
+
+	//↓↓↓ node_type и insert_return_type деревьев без извлечения узлов (RBTree_indexed, RBTree_persistent):
+	// объявления map и set остаются корректными, а вызов extract/insert(node)/merge не компилируется
+	struct RBTree_no_node_handle {};
+
+} //namespace ft
+
+#endif
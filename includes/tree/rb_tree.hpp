@@ -1,18 +1,22 @@
 #ifndef RB_TREE_HPP
 # define RB_TREE_HPP
 
+# include <cstddef>
 # include <memory>
+# include <new>
 # include "../iterators/RBTree_iterator.hpp"
-# include "../iterators/iterator_reverse.hpp"
 # include "../utils/utils.hpp"
 # include "rb_node.hpp"
+# include "rb_node_handle.hpp"
+# include "../utils/pool_allocator.hpp"
 
 //http://algolist.ru/ds/rbtree.php
 //https://github.com/gcc-mirror/gcc/blob/master/libstdc%2B%2B-v3/src/c%2B%2B98/tree.cc
 //https://android.googlesource.com/platform/ndk/+/5de42e6621b3d0131472c3f8838b7f0ccf3e8963/sources/cxx-stl/llvm-libc++/libcxx/include/__tree
 
 namespace ft {
-	template<typename Value, typename Compare = std::less<Value>, typename Allocator = std::allocator<Value> >
+	template<typename Value, typename Compare = std::less<Value>, typename Allocator = std::allocator<Value>,
+			typename NodeUpdate = ft::null_node_update, typename Balance = ft::red_black_balance>
 	class RBTree {
 		public:
 			typedef Value													value_type;
@@ -23,27 +27,47 @@ namespace ft {
 			typedef typename allocator_type::pointer 						pointer;
 			typedef typename allocator_type::const_pointer					const_pointer;
 			typedef typename allocator_type::size_type						size_type;
+			typedef std::ptrdiff_t											difference_type;
 
-			typedef RB_Node<Value>											Node;
-			typedef Node*													node_pointer;
+			typedef RB_Node_base											Node_base;
+			typedef Node_base*												node_pointer;
+			typedef typename NodeUpdate::template node<Value>::type			Node;
+			typedef Node*													link_type;
+			typedef typename NodeUpdate::header								Header;
+			typedef ft::integral_constant<bool, NodeUpdate::order_statistic>	order_statistic;
+			typedef ft::integral_constant<bool, NodeUpdate::threaded>			threaded;
+			typedef Balance														balance;
+			typedef ft::integral_constant<bool, Balance::red_black>			red_black;
+			typedef ft::three_way_compare<Compare, Value>						three_way;
+			typedef ft::integral_constant<bool, three_way::native>				native_three_way;
 			
 			//↓↓↓ необходимо для корректного выделения памяти
 			typedef typename allocator_type::template rebind<Node>::other 	allocator_node; 
+			typedef typename allocator_type::template rebind<Header>::other		allocator_base;
 
-			typedef ft::RBTree_iterator<Value>								iterator;
-			typedef ft::RBTree_iterator<const Value>						const_iterator;
-			typedef ft::reverse_iterator<iterator>							reverse_iterator;
-			typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+			typedef ft::RBTree_iterator<Value, NodeUpdate>					iterator;
+			typedef ft::RBTree_iterator<const Value, NodeUpdate>			const_iterator;
+			typedef ft::RBTree_reverse_iterator<Value, NodeUpdate>			reverse_iterator;
+			typedef ft::RBTree_reverse_iterator<const Value, NodeUpdate>	const_reverse_iterator;
+			typedef ft::RBTree_node_handle<Node, Value, Allocator>			node_type;
+			typedef ft::RBTree_insert_return<iterator, node_type>			insert_return_type;
 
 		private:
 			allocator_node  alloc_node_;
+			allocator_base  alloc_base_;
 			allocator_type  alloc_val_;
+			//↓↓↓ nil_ -- общий лист и end(): nil_->left_ хранит самый левый узел,
+			// родитель nil_ -- самый правый, поэтому begin()/end()/--end() выполняются за O(1)
 			node_pointer	nil_;
 			node_pointer 	root_;
 			value_compare 	comp_;
 			size_t 			size_;
 
 		private:
+			node_pointer& leftmost() const { return nil_->left_; }
+			node_pointer rightmost() const { return nil_->parent(); }
+			void set_rightmost(node_pointer node) { nil_->set_parent(node); }
+
 			node_pointer tree_minimum(node_pointer node) const {
 				while (node != nil_ && node->left_ != nil_) {
 					node = node->left_;
@@ -58,39 +82,251 @@ namespace ft {
 				return node;
 			}
 
-			void destroy(node_pointer node) {
-				if (node != nil_) {
-					destroy(node->right_);
-					destroy(node->left_);
-					alloc_val_.destroy(node->value_);
-					alloc_val_.deallocate(node->value_, 1);
+			static reference value(node_pointer node) {
+				return static_cast<link_type>(node)->value_;
+			}
+
+			node_pointer create_node(const value_type& val) {
+				link_type node = alloc_node_.allocate(1);
+				try {
+					alloc_val_.construct(&node->value_, val);
+				} catch (...) {
 					alloc_node_.deallocate(node, 1);
+					throw;
+				}
+				return node;
+			}
+
+			template<typename K, typename M>
+			node_pointer create_node(const K& key, const M& obj) {
+				link_type node = alloc_node_.allocate(1);
+				try {
+					::new (static_cast<void*>(&node->value_)) value_type(ft::pair_ref<K, M>(key, obj));
+				} catch (...) {
+					alloc_node_.deallocate(node, 1);
+					throw;
+				}
+				return node;
+			}
+
+			void destroy_node(node_pointer node) {
+				link_type link = static_cast<link_type>(node);
+				alloc_val_.destroy(&link->value_);
+				alloc_node_.deallocate(link, 1);
+			}
+
+			node_pointer create_nil() {
+				Header* node = alloc_base_.allocate(1);
+				alloc_base_.construct(node, Header(node, node, node, black));
+				thread_reset(node, threaded());
+				return node;
+			}
+
+			void destroy_nil(node_pointer node) {
+				Header* header = static_cast<Header*>(node);
+				alloc_base_.destroy(header);
+				alloc_base_.deallocate(header, 1);
+			}
+
+			//↓↓↓ общий nil_ всех пустых деревьев этого типа: пустое дерево не выделяет память.
+			// Он только читается -- собственный nil_ выделяется при первой вставке (own_header).
+			struct empty_header_type : public Header {
+				empty_header_type() : Header(0, 0, 0, black) {
+					this->set_parent(this);
+					this->left_ = this->right_ = this;
+					thread_reset(this, threaded());
+				}
+			};
+
+			static node_pointer empty_header() {
+				static empty_header_type header;
+				return &header;
+			}
+
+			bool shared_header() const {
+				return nil_ == empty_header();
+			}
+
+			//↓↓↓ вызывается перед тем, как дерево начнет писать в nil_; возвращает nil_
+			node_pointer own_header() {
+				if (size_ == 0 && shared_header()) {
+					nil_ = root_ = create_nil();
+				}
+				return nil_;
+			}
+
+			void drop_header() {
+				if (!shared_header()) {
+					destroy_nil(nil_);
+					nil_ = root_ = empty_header();
+				}
+			}
+
+			//↓↓↓ прошивка -- только для threaded_node_update
+			static node_pointer& next_link(node_pointer node) { return static_cast<RB_Thread_base*>(node)->next_; }
+			static node_pointer& prev_link(node_pointer node) { return static_cast<RB_Thread_base*>(node)->prev_; }
+
+			static void thread_link(node_pointer prev, node_pointer next) {
+				next_link(prev) = next;
+				prev_link(next) = prev;
+			}
+
+			static void thread_reset(node_pointer header, ft::true_type) {
+				next_link(header) = prev_link(header) = header;
+			}
+
+			static void thread_reset(node_pointer, ft::false_type) {}
+
+			//↓↓↓ новый лист встает в список рядом с родителем: левый сын -- перед ним, правый -- после
+			void thread_insert(node_pointer node, node_pointer parent, bool insert_left, ft::true_type) {
+				node_pointer prev = insert_left ? prev_link(parent) : parent;
+				node_pointer next = next_link(prev);
+				thread_link(prev, node);
+				thread_link(node, next);
+			}
+
+			void thread_insert(node_pointer, node_pointer, bool, ft::false_type) {}
+
+			void thread_erase(node_pointer node, ft::true_type) {
+				thread_link(prev_link(node), next_link(node));
+			}
+
+			void thread_erase(node_pointer, ft::false_type) {}
+
+			//↓↓↓ прошивает уже собранное дерево обходом по ссылкам каркаса (после копирования).
+			// Без рекурсии: у splay_balance дерево может выродиться в длинную цепочку
+			void thread_all(ft::true_type) {
+				node_pointer prev = nil_;
+				for (node_pointer node = leftmost(); node != nil_; node = RBTree_step<ft::null_node_update>::next(node)) {
+					thread_link(prev, node);
+					prev = node;
+				}
+				thread_link(prev, nil_);
+			}
+
+			void thread_all(ft::false_type) {}
+
+			//↓↓↓ цепочка для build_from_chain уже идет в порядке обхода через right_
+			void thread_chain(node_pointer head, ft::true_type) {
+				node_pointer prev = nil_;
+				for (; head != nil_; head = head->right_) {
+					thread_link(prev, head);
+					prev = head;
+				}
+				thread_link(prev, nil_);
+			}
+
+			void thread_chain(node_pointer, ft::false_type) {}
+
+			size_type subtree_count(node_pointer node) const {
+				return (node == nil_ ? 0 : static_cast<link_type>(node)->count_);
+			}
+
+			void update_count(node_pointer node, ft::true_type) {
+				static_cast<link_type>(node)->count_ = subtree_count(node->left_) + subtree_count(node->right_) + 1;
+			}
+
+			void update_count(node_pointer, ft::false_type) {}
+
+			//↓↓↓ пересчитывает размеры от node до корня
+			void update_path(node_pointer node, ft::true_type) {
+				for (; node != nil_; node = node->parent()) {
+					update_count(node, ft::true_type());
+				}
+			}
+
+			void update_path(node_pointer, ft::false_type) {}
+
+			//↓↓↓ проверки для verify(): размер поддерева, соседи по прошивке
+			bool verify_count(node_pointer node, ft::true_type) const {
+				return static_cast<link_type>(node)->count_ == subtree_count(node->left_) + subtree_count(node->right_) + 1;
+			}
+
+			bool verify_count(node_pointer, ft::false_type) const { return true; }
+
+			static bool verify_thread(node_pointer prev, node_pointer node, ft::true_type) {
+				return next_link(prev) == node && prev_link(node) == prev;
+			}
+
+			static bool verify_thread(node_pointer, node_pointer, ft::false_type) { return true; }
+
+			//↓↓↓ черная высота поддерева или -1: красный узел с красным сыном, разные высоты
+			int verify_balance(node_pointer node, ft::red_black_balance) const {
+				if (node == nil_) {
+					return 0;
+				}
+				if (node->color() == red && (node->left_->color() == red || node->right_->color() == red)) {
+					return -1;
+				}
+				int left = verify_balance(node->left_, balance());
+				int right = verify_balance(node->right_, balance());
+				if (left < 0 || left != right) {
+					return -1;
+				}
+				return left + (node->color() == black);
+			}
+
+			//↓↓↓ высота поддерева или -1: показатель баланса не равен разности высот или больше 1
+			int verify_balance(node_pointer node, ft::avl_balance) const {
+				if (node == nil_) {
+					return 0;
+				}
+				int left = verify_balance(node->left_, balance());
+				int right = verify_balance(node->right_, balance());
+				if (left < 0 || right < 0 || node->balance() != right - left) {
+					return -1;
+				}
+				return (left > right ? left : right) + 1;
+			}
+
+			//↓↓↓ у splay-дерева формы нет, высота может быть линейной -- без рекурсии
+			int verify_balance(node_pointer, ft::splay_balance) const { return 0; }
+
+			//↓↓↓ без рекурсии: левый сын поворотом поднимается наверх, узел без левого сына удаляется
+			void destroy(node_pointer node) {
+				while (node != nil_) {
+					node_pointer left = node->left_;
+					if (left != nil_) {
+						node->left_ = left->right_;
+						left->right_ = node;
+						node = left;
+					} else {
+						node_pointer right = node->right_;
+						destroy_node(node);
+						node = right;
+					}
 				}
 			}
 
 		public:
 		 	RBTree() : 
 					alloc_node_(allocator_node()),
+					alloc_base_(allocator_base()),
 					alloc_val_(allocator_type()),
-					nil_(alloc_node_.allocate(1)),
+					nil_(empty_header()),
 					root_(nil_),
 					comp_(value_compare()),
 					size_(0) {
-				alloc_node_.construct(nil_, Node(nil_, nil_, nil_, nil));
 			}
 
 			RBTree(const Compare &cmp, const allocator_type& alloc = allocator_type()):
-					alloc_node_(allocator_node()),
+					alloc_node_(alloc),
+					alloc_base_(alloc),
 					alloc_val_(alloc),
-					nil_(alloc_node_.allocate(1)),
+					nil_(empty_header()),
 					root_(nil_),
 					comp_(cmp),
 					size_(0) {
-				alloc_node_.construct(nil_, Node(nil_, nil_, nil_, nil));
 			}
 
-			RBTree(const RBTree& rhs) : nil_(alloc_node_.allocate(1)), root_(nil_), comp_(rhs.comp_) {
-				alloc_node_.construct(nil_, Node(nil_,nil_,nil_, nil));
+			RBTree(const RBTree& rhs) :
+					alloc_node_(rhs.alloc_node_),
+					alloc_base_(rhs.alloc_base_),
+					alloc_val_(rhs.alloc_val_),
+					nil_(empty_header()),
+					root_(nil_),
+					comp_(rhs.comp_),
+					size_(0) {
 				*this = rhs;
 			}
 
@@ -99,18 +335,21 @@ namespace ft {
 					return *this;
 				}
 				destroy(root_);
-				alloc_node_.destroy(nil_);
-				alloc_node_.deallocate(nil_, 1);
+				root_ = nil_;
+				size_ = 0;
+				drop_header();
 				alloc_node_ = rhs.alloc_node_;
+				alloc_base_ = rhs.alloc_base_;
 				alloc_val_ = rhs.alloc_val_;
 				comp_ = rhs.comp_;
-				nil_ = alloc_node_.allocate(1);
-				alloc_node_.construct(nil_, *(rhs.nil_));
-				root_ = nil_;
 				if (rhs.size_ > 0) {
+					own_header();
 					root_ = copy_node(rhs.root_);
-					root_->parent_ = nil_;
+					root_->set_parent(nil_);
 					copy_all(root_, rhs.root_);
+					leftmost() = tree_minimum(root_);
+					set_rightmost(tree_maximum(root_));
+					thread_all(threaded());
 				}
 				size_ = rhs.size_;
 				return *this;
@@ -118,48 +357,83 @@ namespace ft {
 
 			~RBTree(){
 				destroy(root_);
-				alloc_node_.deallocate(nil_, 1);
+				if (!shared_header()) {
+					destroy_nil(nil_);
+				}
 			}
 
 			bool empty() const { return size_ == 0; }
 			size_type size() const { return size_; }
-			size_type max_size() const { return alloc_val_.max_size(); }
+			size_type max_size() const { return alloc_node_.max_size(); }
 
-			node_pointer copy_node(node_pointer other) {
-				node_pointer new_node = alloc_node_.allocate(1);
-				alloc_node_.construct(new_node, Node(other->parent_, other->left_, other->right_, other->type_));
-				if (other->value_) {
-					new_node->value_ = alloc_val_.allocate(1);
-					alloc_val_.construct(new_node->value_, *(other->value_));
+			//↓↓↓ инварианты (для тестов), O(n): связи с родителями, порядок ключей, крайние
+			// узлы в nil_, size_, размеры поддеревьев и прошивка (если есть), цвета и черная
+			// высота у red_black_balance, показатели баланса у avl_balance
+			bool verify() const {
+				if (!nil_->is_nil() || leftmost() != tree_minimum(root_) || rightmost() != tree_maximum(root_)
+						|| (root_ != nil_ && root_->parent() != nil_)) {
+					return false;
+				}
+				if (red_black::value && (nil_->color() != black || root_->color() != black)) {
+					return false;
+				}
+				size_type count = 0;
+				node_pointer prev = nil_;
+				for (node_pointer node = leftmost(); node != nil_; node = RBTree_step<ft::null_node_update>::next(node)) {
+					if ((node->left_ != nil_ && node->left_->parent() != node)
+							|| (node->right_ != nil_ && node->right_->parent() != node)
+							|| (prev != nil_ && !comp_(value(prev), value(node)))
+							|| !verify_count(node, order_statistic()) || !verify_thread(prev, node, threaded())) {
+						return false;
+					}
+					prev = node;
+					++count;
 				}
+				return count == size_ && verify_thread(prev, nil_, threaded()) && verify_balance(root_, balance()) >= 0;
+			}
+
+			node_pointer copy_node(node_pointer other) {
+				node_pointer new_node = create_node(value(other));
+				new_node->set_parent(nil_);
+				new_node->left_ = new_node->right_ = nil_;
+				new_node->set_tag(other->tag());
 				return new_node;
 			}
 
+			//↓↓↓ копирует поддеревья other под node обходом в глубину по ссылкам на родителя,
+			// без рекурсии (дерево splay_balance может быть цепочкой)
 			void copy_all(node_pointer node, node_pointer other) {
-				if (other->left_->type_ == nil) {
-					node->left_ = nil_;
-				} else {
-					node->left_ = copy_node(other->left_);
-					node->left_->parent_ = node;
-					copy_all(node->left_, other->left_);
-				}
-				if (other->right_->type_ == nil) {
-					node->right_ = nil_;
-				} else {
-					node->right_ = copy_node(other->right_);
-					node->right_->parent_ = node;
-					copy_all(node->right_, other->right_);
+				node_pointer top = node;
+				for (;;) {
+					if (!other->left_->is_nil() && node->left_ == nil_) {
+						node->left_ = copy_node(other->left_);
+						node->left_->set_parent(node);
+						node = node->left_;
+						other = other->left_;
+					} else if (!other->right_->is_nil() && node->right_ == nil_) {
+						node->right_ = copy_node(other->right_);
+						node->right_->set_parent(node);
+						node = node->right_;
+						other = other->right_;
+					} else {
+						update_count(node, order_statistic());
+						if (node == top) {
+							return ;
+						}
+						node = node->parent();
+						other = other->parent();
+					}
 				}
 			}
 
-			iterator end() { return iterator(tree_maximum(root_)->right_); }
-			const_iterator end() const { return const_iterator(tree_maximum(root_)->right_); }
-			iterator begin() { return iterator(tree_minimum(root_)); }
-			const_iterator begin() const { return const_iterator(tree_minimum(root_)); }
-			reverse_iterator rbegin() { return reverse_iterator(end()); }
-			const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
-			reverse_iterator rend() { return reverse_iterator(begin()) ;}
-			const_reverse_iterator rend() const { return const_reverse_iterator(begin()) ;}
+			iterator end() { return iterator(nil_); }
+			const_iterator end() const { return const_iterator(nil_); }
+			iterator begin() { return iterator(leftmost()); }
+			const_iterator begin() const { return const_iterator(leftmost()); }
+			reverse_iterator rbegin() { return reverse_iterator(rightmost()); }
+			const_reverse_iterator rbegin() const { return const_reverse_iterator(rightmost()); }
+			reverse_iterator rend() { return reverse_iterator(nil_); }
+			const_reverse_iterator rend() const { return const_reverse_iterator(nil_); }
 
 			void swap(RBTree &rhs) {
 				node_pointer tmpnil_ = nil_;
@@ -176,339 +450,1535 @@ namespace ft {
 				rhs.root_ = tmproot_;
 				rhs.comp_ = tmp_cmp;
 				rhs.size_ = tmp_sz;
+
+				//↓↓↓ узлы остаются за тем аллокатором, который их выделил (важно для pool_allocator)
+				ft::swap_allocator(alloc_node_, rhs.alloc_node_);
+				ft::swap_allocator(alloc_base_, rhs.alloc_base_);
+				ft::swap_allocator(alloc_val_, rhs.alloc_val_);
 			}
 
 			void left_rotate(node_pointer node) {
 				node_pointer y = node->right_;
 				node->right_ = y->left_;
 				if (y->left_ != nil_) {
-					y->left_->parent_ = node;
+					y->left_->set_parent(node);
 				}
 				if (y != nil_) {
-					y->parent_ = node->parent_;
+					y->set_parent(node->parent());
 				}
-				if (node->parent_ != nil_) {
-					if (node == node->parent_->left_) {
-						node->parent_->left_ = y;
+				if (node->parent() != nil_) {
+					if (node == node->parent()->left_) {
+						node->parent()->left_ = y;
 					} else {
-						node->parent_->right_ = y;
+						node->parent()->right_ = y;
 					}
 				} else {
 					root_ = y;
 				}
 				y->left_ = node;
 				if (node != nil_) {
-					node->parent_ = y;
+					node->set_parent(y);
 				}
+				update_count(node, order_statistic());
+				update_count(y, order_statistic());
 			}
 
 			void right_rotate(node_pointer node) {
 				node_pointer y  = node->left_;
 				node->left_ = y->right_;
 				if (y->right_ != nil_) {
-					y->right_->parent_ = node;
+					y->right_->set_parent(node);
 				}
 				if (y != nil_) {
-					y->parent_ = node->parent_;
+					y->set_parent(node->parent());
 				}
-				if (node->parent_ != nil_) {
-					if (node == node->parent_->right_) {
-						node->parent_->right_ = y;
+				if (node->parent() != nil_) {
+					if (node == node->parent()->right_) {
+						node->parent()->right_ = y;
 					} else {
-						node->parent_->left_ = y;
+						node->parent()->left_ = y;
 					}
 				} else {
 					root_ = y;
 				}
 				y->right_ = node;
 				if (node != nil_) {
-					node->parent_ = y;
+					node->set_parent(y);
 				}
+				update_count(node, order_statistic());
+				update_count(y, order_statistic());
 			}
 
 			ft::pair<node_pointer, bool> insert_node(const value_type& val) {
+				node_pointer pos;
+				bool insert_left;
+				if (unique_position(val, pos, insert_left)) {
+					touch(pos, balance());
+					return ft::pair<node_pointer, bool>(pos, false);
+				}
+				return ft::pair<node_pointer, bool>(link_node(pos, insert_left, val), true);
+			}
+
+			//↓↓↓ спуск с одним сравнением на уровень. Если ключ уже есть -- возвращает true и узел в pos,
+			// иначе false, а pos и insert_left описывают свободную позицию для link_node/emplace_node.
+			template<typename K>
+			bool unique_position(const K& key, node_pointer& pos, bool& insert_left) const {
+				return unique_position(key, pos, insert_left, native_three_way());
+			}
+
+			template<typename K>
+			bool unique_position(const K& key, node_pointer& pos, bool& insert_left, ft::true_type) const {
 				node_pointer curr = root_;
-				node_pointer parent = nil_;
-				node_pointer insert_elem;
+				pos = nil_;
+				insert_left = true;
+				while (curr != nil_) {
+					int cmp = three_way::compare(comp_, key, value(curr));
+					if (cmp == 0) {
+						pos = curr;
+						return true;
+					}
+					pos = curr;
+					insert_left = (cmp < 0);
+					curr = insert_left ? curr->left_ : curr->right_;
+				}
+				return false;
+			}
 
+			//↓↓↓ только less: равенство проверяется одним сравнением в конце спуска,
+			// с ближайшим меньшим узлом
+			template<typename K>
+			bool unique_position(const K& key, node_pointer& pos, bool& insert_left, ft::false_type) const {
+				node_pointer curr = root_;
+				pos = nil_;
+				insert_left = true;
 				while (curr != nil_) {
-					parent = curr;
-					if (comp_(val, *(parent->value_))) {
-						curr = curr->left_;
-					} else if (comp_(*(parent->value_),val)) {
-						curr = curr->right_;
-					} else {
-						return ft::pair<node_pointer, bool>(curr, false);
+					pos = curr;
+					insert_left = comp_(key, value(curr));
+					curr = insert_left ? curr->left_ : curr->right_;
+				}
+				node_pointer prev = pos;
+				if (insert_left) {
+					if (pos == leftmost()) {
+						return false;
 					}
+					prev = (--iterator(pos)).node();
 				}
-				pointer new_val = alloc_val_.allocate(1);
-				alloc_val_.construct(new_val, val);
-				insert_elem = alloc_node_.allocate(1);
-				alloc_node_.construct(insert_elem, Node(parent, nil_, nil_, red, new_val));
+				if (comp_(value(prev), key)) {
+					return false;
+				}
+				pos = prev;
+				return true;
+			}
+
+			//↓↓↓ вставка с подсказкой: если val ложится сразу перед hint (или сразу после него),
+			// узел подвешивается без спуска от корня -- амортизированно O(1).
+			// Неверная подсказка стоит пары сравнений и обычного спуска за O(log n).
+			ft::pair<node_pointer, bool> insert_node(node_pointer hint, const value_type& val) {
+				node_pointer pos;
+				bool insert_left;
+				if (hint_position(hint, val, pos, insert_left)) {
+					return ft::pair<node_pointer, bool>(pos, false);
+				}
+				return ft::pair<node_pointer, bool>(link_node(pos, insert_left, val), true);
+			}
+
+			//↓↓↓ то же, что unique_position, но сначала проверяются соседи hint
+			bool hint_position(node_pointer hint, const value_type& val, node_pointer& pos, bool& insert_left) const {
+				if (hint == nil_) {
+					if (size_ > 0 && comp_(value(rightmost()), val)) {
+						pos = rightmost();
+						insert_left = false;
+						return false;
+					}
+					return unique_position(val, pos, insert_left);
+				}
+				if (comp_(val, value(hint))) {
+					if (hint == leftmost()) {
+						pos = hint;
+						insert_left = true;
+						return false;
+					}
+					node_pointer before = (--iterator(hint)).node();
+					if (comp_(value(before), val)) {
+						if (before->right_ == nil_) {
+							pos = before;
+							insert_left = false;
+						} else {
+							pos = hint;
+							insert_left = true;
+						}
+						return false;
+					}
+					return unique_position(val, pos, insert_left);
+				}
+				if (comp_(value(hint), val)) {
+					if (hint == rightmost()) {
+						pos = hint;
+						insert_left = false;
+						return false;
+					}
+					node_pointer after = (++iterator(hint)).node();
+					if (comp_(val, value(after))) {
+						if (hint->right_ == nil_) {
+							pos = hint;
+							insert_left = false;
+						} else {
+							pos = after;
+							insert_left = true;
+						}
+						return false;
+					}
+					return unique_position(val, pos, insert_left);
+				}
+				pos = hint;
+				return true;
+			}
+
+			//↓↓↓ вставка диапазона. В пустое дерево возрастающий префикс диапазона собирается
+			// в цепочку (через right_) и подвешивается идеально сбалансированным деревом за O(n),
+			// без поворотов. Остаток диапазона, если он есть, вставляется поэлементно с подсказкой end().
+			template<typename InputIterator>
+			void insert_range(InputIterator first, InputIterator last) {
+				if (size_ == 0 && first != last) {
+					own_header();
+					node_pointer head = nil_;
+					node_pointer tail = nil_;
+					size_type n = 0;
+					try {
+						for (; first != last; ++first) {
+							const value_type& val = *first;
+							if (tail != nil_ && !comp_(value(tail), val)) {
+								break;
+							}
+							node_pointer node = create_node(val);
+							node->right_ = nil_;
+							if (tail == nil_) {
+								head = node;
+							} else {
+								tail->right_ = node;
+							}
+							tail = node;
+							++n;
+						}
+					} catch (...) {
+						while (head != nil_) {
+							node_pointer next = head->right_;
+							destroy_node(head);
+							head = next;
+						}
+						throw;
+					}
+					if (n > 0) {
+						build_from_chain(head, tail, n);
+					}
+				}
+				for (; first != last; ++first) {
+					insert_node(nil_, *first);
+				}
+			}
+
+			void build_from_chain(node_pointer head, node_pointer tail, size_type n) {
+				size_type red_depth = 0;
+				while ((static_cast<size_type>(2) << red_depth) <= n + 1) {
+					++red_depth;
+				}
+				leftmost() = head;
+				set_rightmost(tail);
+				thread_chain(head, threaded());
+				root_ = build_subtree(head, n, 0, red_depth);
+				root_->set_parent(nil_);
+				size_ = n;
+			}
+
+			//↓↓↓ строит поддерево из n узлов цепочки list в порядке in-order. Все уровни, кроме
+			// последнего, заполнены полностью и черные; узлы неполного последнего уровня красные
+			// (для avl_balance -- показатели баланса по высотам поддеревьев).
+			node_pointer build_subtree(node_pointer& list, size_type n, size_type depth, size_type red_depth) {
+				if (n == 0) {
+					return nil_;
+				}
+				size_type left_n = (n - 1) / 2;
+				node_pointer left = build_subtree(list, left_n, depth + 1, red_depth);
+				node_pointer node = list;
+				list = list->right_;
+				node->left_ = left;
+				if (left != nil_) {
+					left->set_parent(node);
+				}
+				node->right_ = build_subtree(list, n - 1 - left_n, depth + 1, red_depth);
+				if (node->right_ != nil_) {
+					node->right_->set_parent(node);
+				}
+				build_tag(node, depth == red_depth, left_n, n - 1 - left_n, balance());
+				update_count(node, order_statistic());
+				return node;
+			}
+
+			//↓↓↓ подвешивает новый узел к свободной позиции parent и балансирует дерево
+			node_pointer link_node(node_pointer parent, bool insert_left, const value_type& val) {
+				if (parent == nil_) {
+					parent = own_header();
+				}
+				return attach_node(parent, insert_left, create_node(val));
+			}
+
+			//↓↓↓ то же, но значение (для map -- пара key, obj) конструируется прямо в узле
+			template<typename K, typename M>
+			node_pointer emplace_node(node_pointer parent, bool insert_left, const K& key, const M& obj) {
+				if (parent == nil_) {
+					parent = own_header();
+				}
+				return attach_node(parent, insert_left, create_node(key, obj));
+			}
+
+			//↓↓↓ один спуск: если ключ уже есть -- ничего не конструируется,
+			// иначе value_type(key, obj) строится прямо в новом узле (map::try_emplace, operator[])
+			template<typename K, typename M>
+			ft::pair<iterator, bool> try_emplace(const K& key, const M& obj) {
+				node_pointer pos;
+				bool insert_left;
+				if (unique_position(key, pos, insert_left)) {
+					touch(pos, balance());
+					return ft::pair<iterator, bool>(iterator(pos), false);
+				}
+				return ft::pair<iterator, bool>(iterator(emplace_node(pos, insert_left, key, obj)), true);
+			}
+
+			//↓↓↓ map::operator[]
+			template<typename K, typename M>
+			value_type& emplace_value(const K& key, const M& obj) {
+				return *try_emplace(key, obj).first;
+			}
+
+			node_pointer attach_node(node_pointer parent, bool insert_left, node_pointer insert_elem) {
+				insert_elem->set_parent(parent);
+				insert_elem->left_ = insert_elem->right_ = nil_;
+				init_tag(insert_elem, balance());
 
 				if (parent != nil_) {
-					if (comp_(val, *(parent->value_))) {
+					if (insert_left) {
 						parent->left_ = insert_elem;
+						if (parent == leftmost()) {
+							leftmost() = insert_elem;
+						}
 					} else {
 						parent->right_ = insert_elem;
+						if (parent == rightmost()) {
+							set_rightmost(insert_elem);
+						}
 					}
 				} else {
 					root_ = insert_elem;
-					nil_->parent_ = insert_elem;
+					leftmost() = insert_elem;
+					set_rightmost(insert_elem);
 				}
 
-				nil_->parent_ = tree_maximum(root_);
-				insert_fixup(insert_elem);
+				thread_insert(insert_elem, parent, insert_left, threaded());
+				update_path(insert_elem, order_statistic());
+				insert_balance(insert_elem, balance());
 				++size_;
-				return ft::pair<node_pointer, bool>(insert_elem, true);
+				return insert_elem;
 			}
 
 			void insert_fixup(node_pointer node) {
-				while (node != root_ && node->parent_->type_ == red) {
-					if (node->parent_ == node->parent_->parent_->left_) {
-						node_pointer y = node->parent_->parent_->right_;
-						if (y->type_ == red) {
-							node->parent_->type_ = black;
-							y->type_ = black;
-							node->parent_->parent_->type_ = red;
-							node = node->parent_->parent_;
+				insert_rebalance(node);
+				root_->set_color(black);
+			}
+
+			//↓↓↓ устраняет красного сына у красного отца; корень может остаться красным
+			void insert_rebalance(node_pointer node) {
+				while (node != root_ && node->parent()->color() == red) {
+					if (node->parent() == node->parent()->parent()->left_) {
+						node_pointer y = node->parent()->parent()->right_;
+						if (y->color() == red) {
+							node->parent()->set_color(black);
+							y->set_color(black);
+							node->parent()->parent()->set_color(red);
+							node = node->parent()->parent();
 						} else {
-							if (node == node->parent_->right_) {
-								node = node->parent_;
+							if (node == node->parent()->right_) {
+								node = node->parent();
 								left_rotate(node);
 							}
-							node->parent_->type_ = black;
-							node->parent_->parent_->type_ = red;
-							right_rotate(node->parent_->parent_);
+							node->parent()->set_color(black);
+							node->parent()->parent()->set_color(red);
+							right_rotate(node->parent()->parent());
 						}
 					} else {
-						node_pointer y = node->parent_->parent_->left_;
-						if (y->type_ == red) {
-							node->parent_->type_ = black;
-							y->type_ = black;
-							node->parent_->parent_->type_ = red;
-							node = node->parent_->parent_;
+						node_pointer y = node->parent()->parent()->left_;
+						if (y->color() == red) {
+							node->parent()->set_color(black);
+							y->set_color(black);
+							node->parent()->parent()->set_color(red);
+							node = node->parent()->parent();
 						} else {
-							if (node == node->parent_->left_) {
-								node = node->parent_;
+							if (node == node->parent()->left_) {
+								node = node->parent();
 								right_rotate(node);
 							}
-							node->parent_->type_ = black;
-							node->parent_->parent_->type_ = red;
-							left_rotate(node->parent_->parent_);
+							node->parent()->set_color(black);
+							node->parent()->parent()->set_color(red);
+							left_rotate(node->parent()->parent());
 						}
 					}
 				}
-				root_->type_ = black;
 			}
 
-			bool delete_node(const value_type& value) {
-				node_pointer pos = search(value, root_);
+			template<typename K>
+			bool delete_node(const K& key) {
+				node_pointer pos = search(key, root_);
 				if (pos == nil_) {
 					return false;
 				}
-				node_pointer node, y;
-				if (pos->left_ == nil_ || pos->right_ == nil_) {		
-					y = pos;
-				} else {
-					y = pos->right_;
-					while (y->left_ != nil_) {
-						y = y->left_;
-					}
+				erase_node(pos);
+				return true;
+			}
+
+			//↓↓↓ удаление по итератору: узел уже известен, сравнения не нужны
+			void erase(iterator position) {
+				erase_node(position.node());
+			}
+
+			//↓↓↓ O(k + log n); весь диапазон -- просто clear()
+			void erase(iterator first, iterator last) {
+				if (first == begin() && last == end()) {
+					clear();
+					return;
 				}
-				if (y->left_ != nil_) {
+				while (first != last) {
+					erase_node((first++).node());
+				}
+			}
+
+			//↓↓↓ значения не перемещаются между узлами: если у pos два потомка, на его место
+			// перевешивается следующий за ним узел y. Итераторы на остальные элементы остаются валидными.
+			void erase_node(node_pointer pos) {
+				unlink_node(pos);
+				destroy_node(pos);
+			}
+
+			//↓↓↓ вынимает узел из дерева, не разрушая его (erase_node, extract, merge)
+			void unlink_node(node_pointer pos) {
+				node_pointer y = pos;
+				node_pointer node;
+				node_pointer node_parent;
+				bool left_side = false;
+				thread_erase(pos, threaded());
+				if (pos == leftmost()) {
+					leftmost() = (pos->right_ != nil_ ? tree_minimum(pos->right_) : pos->parent());
+				}
+				if (pos == rightmost()) {
+					set_rightmost(pos->left_ != nil_ ? tree_maximum(pos->left_) : pos->parent());
+				}
+				if (y->left_ == nil_) {
+					node = y->right_;
+				} else if (y->right_ == nil_) {
 					node = y->left_;
 				} else {
+					y = tree_minimum(y->right_);
 					node = y->right_;
 				}
-				if (node != nil_) {
-					node->parent_ = y->parent_;
-				}
-				if (y->parent_ != nil_) {
-					if (y == y->parent_->left_) {
-						y->parent_->left_ = node;
+				if (y != pos) {
+					pos->left_->set_parent(y);
+					y->left_ = pos->left_;
+					if (y != pos->right_) {
+						node_parent = y->parent();
+						left_side = true;
+						if (node != nil_) {
+							node->set_parent(y->parent());
+						}
+						y->parent()->left_ = node;
+						y->right_ = pos->right_;
+						pos->right_->set_parent(y);
 					} else {
-						y->parent_->right_ = node;
+						node_parent = y;
 					}
+					replace_child(pos, y);
+					y->set_parent(pos->parent());
+					std::size_t tag = y->tag();
+					y->set_tag(pos->tag());
+					pos->set_tag(tag);
 				} else {
-					root_ = node;
+					node_parent = y->parent();
+					left_side = (pos != root_ && pos == node_parent->left_);
+					if (node != nil_) {
+						node->set_parent(y->parent());
+					}
+					replace_child(pos, node);
 				}
-				if (y != pos) {
-					alloc_val_.destroy(pos->value_);
-					alloc_val_.deallocate(pos->value_, 1);
-					pos->value_ = y->value_;
+				update_path(node_parent, order_statistic());
+				erase_balance(pos, node, node_parent, left_side, balance());
+				size_--;
+			}
+
+			void replace_child(node_pointer old_child, node_pointer new_child) {
+				if (old_child == root_) {
+					root_ = new_child;
+				} else if (old_child == old_child->parent()->left_) {
+					old_child->parent()->left_ = new_child;
 				} else {
-					alloc_val_.destroy(y->value_);
-					alloc_val_.deallocate(y->value_, 1);
+					old_child->parent()->right_ = new_child;
 				}
-				alloc_node_.destroy(y);
-				alloc_node_.deallocate(y, 1);
-				nil_->parent_ = tree_maximum(root_);
-				delete_fixup(node);
-				size_--;
-				return true;		
-			}
-
-			void delete_fixup(node_pointer node) {
-				while (node != root_ && node->type_ == black) {
-					if (node == node->parent_->left_) {
-						node_pointer w = node->parent_->right_;
-						if (w->type_ == red) {
-							w->type_ = black;
-							node->parent_->type_ = red;
-							left_rotate(node->parent_);
-							w = node->parent_->right_;
+			}
+
+			//↓↓↓ node может оказаться nil_, поэтому его родитель передается отдельно,
+			// а черными считаются все узлы, кроме красных (в том числе nil_)
+			void delete_fixup(node_pointer node, node_pointer parent) {
+				while (node != root_ && node->color() != red) {
+					if (node == parent->left_) {
+						node_pointer w = parent->right_;
+						if (w->color() == red) {
+							w->set_color(black);
+							parent->set_color(red);
+							left_rotate(parent);
+							w = parent->right_;
 						}
-						if (w->left_->type_==black && w->right_->type_==black) {
-							w->type_ = red;
-							node = node->parent_;
+						if (w->left_->color() != red && w->right_->color() != red) {
+							w->set_color(red);
+							node = parent;
+							parent = parent->parent();
 						} else {
-							if (w->right_->type_==black) {
-								w->left_->type_ = black;
-								w->type_ = red;
+							if (w->right_->color() != red) {
+								w->left_->set_color(black);
+								w->set_color(red);
 								right_rotate(w);
-								w = node->parent_->right_;
+								w = parent->right_;
 							}
-							w->type_ = node->parent_->type_;
-							node->parent_->type_ = black;
-							w->right_->type_ = black;
-							left_rotate(node->parent_);
+							w->set_color(parent->color());
+							parent->set_color(black);
+							w->right_->set_color(black);
+							left_rotate(parent);
 							node = root_;
 						}
 					} else {
-						node_pointer w = node->parent_->left_;
-						if (w->type_==red) {
-							w->type_ = black;
-							node->parent_->type_ = red;
-							right_rotate(node->parent_);
-							w = node->parent_->left_;
+						node_pointer w = parent->left_;
+						if (w->color() == red) {
+							w->set_color(black);
+							parent->set_color(red);
+							right_rotate(parent);
+							w = parent->left_;
 						}
-						if (w->right_->type_ == black && w->left_->type_==black) {
-							w->type_ = red;
-							node = node->parent_;
+						if (w->right_->color() != red && w->left_->color() != red) {
+							w->set_color(red);
+							node = parent;
+							parent = parent->parent();
 						} else {
-							if (w->left_->type_==black) {
-								w->right_->type_ = black;
-								w->type_ = red;
+							if (w->left_->color() != red) {
+								w->right_->set_color(black);
+								w->set_color(red);
 								left_rotate(w);
-								w = node->parent_->left_;
+								w = parent->left_;
 							}
-							w->type_ = node->parent_->type_;
-							node->parent_->type_ = black;
-							w->left_->type_ = black;
-							right_rotate(node->parent_);
+							w->set_color(parent->color());
+							parent->set_color(black);
+							w->left_->set_color(black);
+							right_rotate(parent);
 							node = root_;
 						}
 					}
 				}
-				if (node->type_ != nil) {
-					node->type_ = black;
+				if (node != nil_) {
+					node->set_color(black);
+				}
+			}
+
+			//↓↓↓ балансировка по политике Balance (rb_node.hpp). После вставки узел уже подвешен
+			// листом; после удаления node стоит на освободившемся месте -- (left_side ? левый : правый)
+			// сын parent, removed хранит метку этого места (у красно-черного дерева -- цвет)
+			void init_tag(node_pointer node, ft::red_black_balance) { node->set_color(red); }
+			void init_tag(node_pointer node, ft::avl_balance) { node->set_balance(0); }
+			void init_tag(node_pointer node, ft::splay_balance) { node->set_tag(0); }
+
+			void build_tag(node_pointer node, bool last_level, size_type, size_type, ft::red_black_balance) {
+				node->set_color(last_level ? red : black);
+			}
+
+			void build_tag(node_pointer node, bool, size_type left_n, size_type right_n, ft::avl_balance) {
+				node->set_balance(static_cast<int>(build_height(right_n)) - static_cast<int>(build_height(left_n)));
+			}
+
+			void build_tag(node_pointer node, bool, size_type, size_type, ft::splay_balance) {
+				node->set_tag(0);
+			}
+
+			//↓↓↓ высота поддерева из n узлов, собранного build_subtree, -- число битов n
+			static size_type build_height(size_type n) {
+				size_type height = 0;
+				for (; n > 0; n >>= 1) {
+					++height;
+				}
+				return height;
+			}
+
+			void insert_balance(node_pointer node, ft::red_black_balance) { insert_fixup(node); }
+			void insert_balance(node_pointer node, ft::avl_balance) { avl_insert_fixup(node); }
+			void insert_balance(node_pointer node, ft::splay_balance) { splay(node); }
+
+			void erase_balance(node_pointer removed, node_pointer node, node_pointer parent, bool, ft::red_black_balance) {
+				if (removed->color() != red) {
+					delete_fixup(node, parent);
+				}
+			}
+
+			void erase_balance(node_pointer, node_pointer, node_pointer parent, bool left_side, ft::avl_balance) {
+				avl_erase_fixup(parent, left_side);
+			}
+
+			void erase_balance(node_pointer, node_pointer, node_pointer parent, bool, ft::splay_balance) {
+				if (parent != nil_) {
+					splay(parent);
+				}
+			}
+
+			//↓↓↓ доступ к узлу: splay_balance поднимает его в корень, остальные ничего не делают
+			void touch(node_pointer node, ft::splay_balance) {
+				if (node != nil_) {
+					splay(node);
+				}
+			}
+
+			template<typename OtherBalance>
+			void touch(node_pointer, OtherBalance) {}
+
+			//↓↓↓ AVL: высота поддерева node выросла на 1, подъем до первого узла,
+			// у которого высота не изменилась. Хватает одного (двойного) поворота
+			void avl_insert_fixup(node_pointer node) {
+				for (node_pointer parent = node->parent(); parent != nil_; parent = node->parent()) {
+					int factor = parent->balance() + (node == parent->left_ ? -1 : 1);
+					if (factor == 0) {
+						parent->set_balance(0);
+						return ;
+					}
+					if (factor == 1 || factor == -1) {
+						parent->set_balance(factor);
+						node = parent;
+						continue;
+					}
+					bool shorter;
+					avl_rotate(parent, factor, shorter);
+					return ;
+				}
+			}
+
+			//↓↓↓ AVL: высота (left_side ? левого : правого) поддерева parent уменьшилась на 1.
+			// Подъем, пока уменьшается высота очередного поддерева, -- до O(log n) поворотов
+			void avl_erase_fixup(node_pointer parent, bool left_side) {
+				while (parent != nil_) {
+					int factor = parent->balance() + (left_side ? 1 : -1);
+					node_pointer top = parent;
+					if (factor == 1 || factor == -1) {
+						parent->set_balance(factor);
+						return ;
+					}
+					if (factor == 0) {
+						parent->set_balance(0);
+					} else {
+						bool shorter;
+						top = avl_rotate(parent, factor, shorter);
+						if (!shorter) {
+							return ;
+						}
+					}
+					parent = top->parent();
+					left_side = (parent != nil_ && top == parent->left_);
+				}
+			}
+
+			//↓↓↓ node с показателем factor = +-2 поворачивается (дважды, если внутренний внук выше).
+			// Возвращает новую вершину поддерева; shorter -- стала ли высота поддерева меньше,
+			// чем до нарушения баланса (после вставки -- всегда, после удаления -- не всегда)
+			node_pointer avl_rotate(node_pointer node, int factor, bool& shorter) {
+				int side = (factor > 0 ? 1 : -1);
+				node_pointer child = (side > 0 ? node->right_ : node->left_);
+				int child_factor = child->balance();
+				if (child_factor == -side) {
+					node_pointer grandchild = (side > 0 ? child->left_ : child->right_);
+					int grand_factor = grandchild->balance();
+					rotate_toward(child, -side);
+					rotate_toward(node, side);
+					node->set_balance(grand_factor == side ? -side : 0);
+					child->set_balance(grand_factor == -side ? side : 0);
+					grandchild->set_balance(0);
+					shorter = true;
+					return grandchild;
+				}
+				rotate_toward(node, side);
+				if (child_factor == 0) {
+					node->set_balance(side);
+					child->set_balance(-side);
+					shorter = false;
+				} else {
+					node->set_balance(0);
+					child->set_balance(0);
+					shorter = true;
+				}
+				return child;
+			}
+
+			//↓↓↓ side > 0 -- правый сын node поднимается (левый поворот), side < 0 -- левый
+			void rotate_toward(node_pointer node, int side) {
+				if (side > 0) {
+					left_rotate(node);
+				} else {
+					right_rotate(node);
+				}
+			}
+
+			//↓↓↓ splay снизу вверх: zig-zig поворачивает сначала родителя, zig-zag -- дважды сам узел
+			void splay(node_pointer node) {
+				while (node->parent() != nil_) {
+					node_pointer parent = node->parent();
+					node_pointer grand = parent->parent();
+					if (grand != nil_) {
+						if ((node == parent->left_) == (parent == grand->left_)) {
+							rotate_up(parent);
+						} else {
+							rotate_up(node);
+						}
+					}
+					rotate_up(node);
+				}
+			}
+
+			void rotate_up(node_pointer node) {
+				if (node == node->parent()->left_) {
+					right_rotate(node->parent());
+				} else {
+					left_rotate(node->parent());
 				}
 			}
 			
 			void clear() {
+				if (size_ == 0) {
+					ft::release_allocator(alloc_node_);
+					return ;
+				}
 				destroy(root_);
-				root_= nil_->parent_ = nil_;
+				root_ = leftmost() = nil_;
+				set_rightmost(nil_);
+				thread_reset(nil_, threaded());
+				size_ = 0;
+				ft::release_allocator(alloc_node_);
+			}
+
+			//↓↓↓ node handles (rb_node_handle.hpp): узел переходит между деревьями без выделения
+			// памяти и копирования значения, если аллокаторы деревьев равны
+			node_type extract(iterator position) {
+				node_pointer node = position.node();
+				unlink_node(node);
+				return node_type(static_cast<link_type>(node), alloc_val_);
+			}
+
+			template<typename K>
+			node_type extract(const K& key) {
+				node_pointer node = search(key, root_);
+				if (node == nil_) {
+					return node_type();
+				}
+				return extract(iterator(node));
+			}
+
+			insert_return_type insert_handle(const node_type& nh) {
+				insert_return_type result;
+				result.position = end();
+				result.inserted = false;
+				if (nh.empty()) {
+					return result;
+				}
+				node_pointer pos;
+				bool insert_left;
+				if (unique_position(nh.value(), pos, insert_left)) {
+					result.position = iterator(pos);
+					result.node = nh;
+					return result;
+				}
+				result.position = iterator(attach_handle(pos, insert_left, nh));
+				result.inserted = true;
+				return result;
+			}
+
+			//↓↓↓ если ключ уже занят, узел остается в nh
+			iterator insert_handle(node_pointer hint, const node_type& nh) {
+				if (nh.empty()) {
+					return end();
+				}
+				node_pointer pos;
+				bool insert_left;
+				if (hint_position(hint, nh.value(), pos, insert_left)) {
+					return iterator(pos);
+				}
+				return iterator(attach_handle(pos, insert_left, nh));
+			}
+
+			//↓↓↓ узел чужого аллокатора (pool_allocator с другим пулом) дерево освободить не может:
+			// значение копируется в новый узел, как в take_node, а старый узел удаляет
+			// временная копия handle своим аллокатором
+			node_pointer attach_handle(node_pointer parent, bool insert_left, const node_type& nh) {
+				if (!(alloc_val_ == nh.get_allocator())) {
+					node_pointer node = link_node(parent, insert_left, nh.value());
+					node_type owner(nh);
+					return node;
+				}
+				if (parent == nil_) {
+					parent = own_header();
+				}
+				return attach_node(parent, insert_left, nh.release());
+			}
+
+			//↓↓↓ узлы source с ключами, которых нет в дереве, перевешиваются сюда: O(k log(n + k)),
+			// остальные остаются в source. С неравными аллокаторами узлов
+			// (pool_allocator с разными пулами) элементы копируются и удаляются из source
+			void merge(RBTree& source) {
+				if (this == &source) {
+					return ;
+				}
+				for (iterator it = source.begin(); it != source.end(); ) {
+					node_pointer node = (it++).node();
+					node_pointer pos;
+					bool insert_left;
+					if (!unique_position(value(node), pos, insert_left)) {
+						take_node(source, node, pos, insert_left);
+					}
+				}
+			}
+
+			//↓↓↓ узел source встает в свободную позицию pos этого дерева
+			void take_node(RBTree& source, node_pointer node, node_pointer pos, bool insert_left) {
+				if (alloc_node_ == source.alloc_node_) {
+					if (pos == nil_) {
+						pos = own_header();
+					}
+					source.unlink_node(node);
+					attach_node(pos, insert_left, node);
+				} else {
+					link_node(pos, insert_left, value(node));
+					source.erase_node(node);
+				}
+			}
+
+			//↓↓↓ split/join и алгебра множеств на них (Blelloch, Ferizovic, Sun, "Just Join for
+			// Parallel Ordered Sets"). Поддерево -- корень и его черная высота (у nil_ -- 0);
+			// корень поддерева всегда черный, а его родитель -- nil_. Все поддеревья одной
+			// операции висят на nil_ этого дерева, узлы другого дерева сначала перевешиваются.
+			// Прошивка (threaded_node_update) в конце строится заново за O(n).
+			struct subtree {
+				node_pointer	root;
+				size_type		height;
+			};
+
+			subtree make_subtree(node_pointer root, size_type height) const {
+				subtree tree;
+				tree.root = root;
+				tree.height = height;
+				return tree;
+			}
+
+			//↓↓↓ ребенок с черной высотой height становится отдельным поддеревом
+			subtree detach(node_pointer node, size_type height) const {
+				if (node != nil_) {
+					node->set_parent(nil_);
+					if (node->color() == red) {
+						node->set_color(black);
+						++height;
+					}
+				}
+				return make_subtree(node, height);
+			}
+
+			size_type black_height(node_pointer node) const {
+				size_type height = 0;
+				for (; node != nil_; node = node->left_) {
+					if (node->color() != red) {
+						++height;
+					}
+				}
+				return height;
+			}
+
+			//↓↓↓ l < key < r. Равные высоты -- key черный корень, иначе key красным
+			// подвешивается к краю высокого дерева на уровне черной высоты низкого
+			// и балансируется как вставка: O(|l.height - r.height| + 1)
+			subtree join_subtree(subtree l, node_pointer key, subtree r) {
+				if (l.height == r.height) {
+					key->left_ = l.root;
+					key->right_ = r.root;
+					if (l.root != nil_) {
+						l.root->set_parent(key);
+					}
+					if (r.root != nil_) {
+						r.root->set_parent(key);
+					}
+					key->set_parent(nil_);
+					key->set_color(black);
+					update_count(key, order_statistic());
+					return make_subtree(key, l.height + 1);
+				}
+				bool to_right = (l.height > r.height);
+				subtree tall = (to_right ? l : r);
+				subtree low = (to_right ? r : l);
+				node_pointer parent = nil_;
+				node_pointer node = tall.root;
+				size_type height = tall.height;
+				while (node->color() == red || height != low.height) {
+					if (node->color() != red) {
+						--height;
+					}
+					parent = node;
+					node = (to_right ? node->right_ : node->left_);
+				}
+				if (to_right) {
+					key->left_ = node;
+					key->right_ = low.root;
+					parent->right_ = key;
+				} else {
+					key->left_ = low.root;
+					key->right_ = node;
+					parent->left_ = key;
+				}
+				if (node != nil_) {
+					node->set_parent(key);
+				}
+				if (low.root != nil_) {
+					low.root->set_parent(key);
+				}
+				key->set_parent(parent);
+				key->set_color(red);
+				update_path(key, order_statistic());
+				node_pointer saved_root = root_;
+				root_ = tall.root;
+				insert_rebalance(key);
+				subtree result = make_subtree(root_, tall.height + (root_->color() == red ? 1 : 0));
+				root_->set_color(black);
+				root_ = saved_root;
+				return result;
+			}
+
+			//↓↓↓ l < r, без разделяющего узла: им становится последний узел l
+			subtree join_pair(subtree l, subtree r) {
+				if (l.root == nil_) {
+					return r;
+				}
+				if (r.root == nil_) {
+					return l;
+				}
+				node_pointer last;
+				subtree rest = split_last(l, last);
+				return join_subtree(rest, last, r);
+			}
+
+			subtree split_last(subtree tree, node_pointer& last) {
+				node_pointer node = tree.root;
+				subtree left = detach(node->left_, tree.height - 1);
+				if (node->right_ == nil_) {
+					last = node;
+					return left;
+				}
+				subtree rest = split_last(detach(node->right_, tree.height - 1), last);
+				return join_subtree(left, node, rest);
+			}
+
+			//↓↓↓ l -- меньшие key, r -- большие, mid -- равный key узел или nil_. O(log n)
+			template<typename K>
+			void split_subtree(subtree tree, const K& key, subtree& l, node_pointer& mid, subtree& r) {
+				if (tree.root == nil_) {
+					l = r = tree;
+					mid = nil_;
+					return ;
+				}
+				node_pointer node = tree.root;
+				subtree left = detach(node->left_, tree.height - 1);
+				subtree right = detach(node->right_, tree.height - 1);
+				int cmp = three_way::compare(comp_, key, value(node));
+				if (cmp == 0) {
+					l = left;
+					mid = node;
+					r = right;
+				} else if (cmp < 0) {
+					subtree rest;
+					split_subtree(left, key, l, mid, rest);
+					r = join_subtree(rest, node, right);
+				} else {
+					subtree rest;
+					split_subtree(right, key, rest, mid, r);
+					l = join_subtree(left, node, rest);
+				}
+			}
+
+			//↓↓↓ корень a делит b; при совпадении ключей остается элемент a, если a_wins
+			subtree unite(subtree a, subtree b, bool a_wins, size_type& removed) {
+				if (b.root == nil_) {
+					return a;
+				}
+				if (a.root == nil_) {
+					return b;
+				}
+				node_pointer key = a.root;
+				subtree al = detach(key->left_, a.height - 1);
+				subtree ar = detach(key->right_, a.height - 1);
+				subtree bl;
+				subtree br;
+				node_pointer dup;
+				split_subtree(b, value(key), bl, dup, br);
+				if (dup != nil_) {
+					if (!a_wins) {
+						std::swap(key, dup);
+					}
+					destroy_node(dup);
+					++removed;
+				}
+				subtree l = unite(al, bl, a_wins, removed);
+				subtree r = unite(ar, br, a_wins, removed);
+				return join_subtree(l, key, r);
+			}
+
+			//↓↓↓ other -- узел другого дерева, он только читается
+			subtree intersect(subtree a, node_pointer other, size_type& removed) {
+				if (a.root == nil_) {
+					return a;
+				}
+				if (other->is_nil()) {
+					removed += destroy_counted(a.root);
+					return make_subtree(nil_, 0);
+				}
+				subtree al;
+				subtree ar;
+				node_pointer mid;
+				split_subtree(a, value(other), al, mid, ar);
+				subtree l = intersect(al, other->left_, removed);
+				subtree r = intersect(ar, other->right_, removed);
+				if (mid != nil_) {
+					return join_subtree(l, mid, r);
+				}
+				return join_pair(l, r);
+			}
+
+			subtree subtract(subtree a, node_pointer other, size_type& removed) {
+				if (a.root == nil_ || other->is_nil()) {
+					return a;
+				}
+				subtree al;
+				subtree ar;
+				node_pointer mid;
+				split_subtree(a, value(other), al, mid, ar);
+				if (mid != nil_) {
+					destroy_node(mid);
+					++removed;
+				}
+				subtree l = subtract(al, other->left_, removed);
+				subtree r = subtract(ar, other->right_, removed);
+				return join_pair(l, r);
+			}
+
+			size_type destroy_counted(node_pointer node) {
+				if (node == nil_) {
+					return 0;
+				}
+				size_type count = destroy_counted(node->left_) + destroy_counted(node->right_) + 1;
+				destroy_node(node);
+				return count;
+			}
+
+			//↓↓↓ листья поддерева чужого дерева (from -- его nil_) перевешиваются на nil_. O(k)
+			size_type repoint(node_pointer node, node_pointer from) {
+				size_type count = 1;
+				if (node->left_ == from) {
+					node->left_ = nil_;
+				} else {
+					count += repoint(node->left_, from);
+				}
+				if (node->right_ == from) {
+					node->right_ = nil_;
+				} else {
+					count += repoint(node->right_, from);
+				}
+				return count;
+			}
+
+			//↓↓↓ поддерево на nil_ становится содержимым дерева
+			void adopt(subtree tree, size_type size) {
+				root_ = tree.root;
+				size_ = size;
+				if (root_ != nil_) {
+					root_->set_parent(nil_);
+				}
+				leftmost() = tree_minimum(root_);
+				set_rightmost(tree_maximum(root_));
+				thread_all(threaded());
+			}
+
+			//↓↓↓ узлы переданы другому дереву; nil_ остается за этим
+			void forget_nodes() {
+				root_ = leftmost() = nil_;
+				set_rightmost(nil_);
+				thread_reset(nil_, threaded());
 				size_ = 0;
 			}
 
-			node_pointer search(const value_type& value, node_pointer node) const {
+			//↓↓↓ аллокаторы узлов не равны (разные пулы pool_allocator): узлы не переходят, а копируются
+			void copy_subtree(node_pointer node, RBTree& target) const {
+				if (node != nil_) {
+					copy_subtree(node->left_, target);
+					target.insert_node(target.nil_, value(node));
+					copy_subtree(node->right_, target);
+				}
+			}
+
+			//↓↓↓ элементы не меньше key переходят в greater (его содержимое удаляется).
+			// O(log n + k), k -- число перешедших элементов: их листья перевешиваются на nil_ greater
+			template<typename K>
+			void split(const K& key, RBTree& greater) {
+				if (this != &greater) {
+					split(key, greater, red_black());
+				}
+			}
+
+			template<typename K>
+			void split(const K& key, RBTree& greater, ft::true_type) {
+				greater.clear();
+				if (size_ == 0) {
+					return ;
+				}
+				subtree l;
+				subtree r;
+				node_pointer mid;
+				split_subtree(make_subtree(root_, black_height(root_)), key, l, mid, r);
+				if (mid != nil_) {
+					r = join_subtree(make_subtree(nil_, 0), mid, r);
+				}
+				size_type moved = 0;
+				if (r.root != nil_) {
+					if (alloc_node_ == greater.alloc_node_) {
+						greater.own_header();
+						moved = greater.repoint(r.root, nil_);
+						greater.adopt(r, moved);
+					} else {
+						try {
+							copy_subtree(r.root, greater);
+						} catch (...) {
+							greater.clear();
+							adopt(join_pair(l, r), size_);
+							throw;
+						}
+						moved = destroy_counted(r.root);
+					}
+				}
+				adopt(l, size_ - moved);
+			}
+
+			//↓↓↓ все элементы greater больше элементов дерева: greater пристыковывается за O(log n + k),
+			// k -- размер меньшего из деревьев. Если диапазоны пересекаются -- это set_union
+			void join(RBTree& greater) {
+				if (this != &greater) {
+					join(greater, red_black());
+				}
+			}
+
+			void join(RBTree& greater, ft::true_type) {
+				if (greater.size_ == 0) {
+					return ;
+				}
+				if (size_ == 0) {
+					swap(greater);
+					return ;
+				}
+				if (!comp_(value(rightmost()), value(greater.leftmost()))) {
+					set_union(greater);
+					return ;
+				}
+				if (!(alloc_node_ == greater.alloc_node_)) {
+					insert_range(greater.begin(), greater.end());
+					greater.clear();
+					return ;
+				}
+				bool swapped = (size_ < greater.size_);
+				if (swapped) {
+					swap(greater);
+				}
+				size_type size = size_ + greater.size_;
+				repoint(greater.root_, greater.nil_);
+				subtree lower = make_subtree(root_, black_height(root_));
+				subtree upper = make_subtree(greater.root_, black_height(greater.root_));
+				upper.root->set_parent(nil_);
+				greater.forget_nodes();
+				if (swapped) {
+					std::swap(lower, upper);
+				}
+				node_pointer last;
+				lower = split_last(lower, last);
+				adopt(join_subtree(lower, last, upper), size);
+			}
+
+			//↓↓↓ дерево становится объединением, other опустошается. Узлы other переходят
+			// в дерево, при совпадении ключей остается элемент этого дерева.
+			// O(m log(n/m + 1)), m -- размер меньшего дерева
+			void set_union(RBTree& other) {
+				if (this != &other) {
+					set_union(other, red_black());
+				}
+			}
+
+			void set_union(RBTree& other, ft::true_type) {
+				if (!(alloc_node_ == other.alloc_node_)) {
+					insert_range(other.begin(), other.end());
+					other.clear();
+					return ;
+				}
+				bool this_wins = true;
+				if (size_ < other.size_) {
+					swap(other);
+					this_wins = false;
+				}
+				if (other.size_ == 0) {
+					return ;
+				}
+				size_type size = size_ + other.size_;
+				size_type removed = 0;
+				repoint(other.root_, other.nil_);
+				subtree a = make_subtree(root_, black_height(root_));
+				subtree b = make_subtree(other.root_, black_height(other.root_));
+				b.root->set_parent(nil_);
+				other.forget_nodes();
+				subtree result = unite(a, b, this_wins, removed);
+				adopt(result, size - removed);
+			}
+
+			//↓↓↓ остаются только элементы, ключи которых есть в other. O(m log(n/m + 1))
+			// и разрушение удаленных элементов
+			void set_intersection(const RBTree& other) {
+				if (this != &other && size_ != 0) {
+					set_intersection(other, red_black());
+				}
+			}
+
+			void set_intersection(const RBTree& other, ft::true_type) {
+				size_type removed = 0;
+				subtree result = intersect(make_subtree(root_, black_height(root_)), other.root_, removed);
+				adopt(result, size_ - removed);
+			}
+
+			//↓↓↓ удаляются элементы, ключи которых есть в other. O(m log(n/m + 1))
+			void set_difference(const RBTree& other) {
+				if (this == &other) {
+					clear();
+				} else if (size_ != 0) {
+					set_difference(other, red_black());
+				}
+			}
+
+			void set_difference(const RBTree& other, ft::true_type) {
+				size_type removed = 0;
+				subtree result = subtract(make_subtree(root_, black_height(root_)), other.root_, removed);
+				adopt(result, size_ - removed);
+			}
+
+			//↓↓↓ split/join и алгебра множеств для AVL и splay: поэлементно, но тоже без копий --
+			// узлы перевешиваются (take_node) или удаляются на месте
+			template<typename K>
+			void split(const K& key, RBTree& greater, ft::false_type) {
+				greater.clear();
+				for (iterator it = lower_bound(key); it != end(); ) {
+					node_pointer node = (it++).node();
+					greater.take_node(*this, node, greater.rightmost(), false);
+				}
+			}
+
+			void join(RBTree& greater, ft::false_type) {
+				set_union(greater, ft::false_type());
+			}
+
+			//↓↓↓ O(m log(n + m)); совпавшие элементы other удаляются
+			void set_union(RBTree& other, ft::false_type) {
+				merge(other);
+				other.clear();
+			}
+
+			//↓↓↓ O(n log m)
+			void set_intersection(const RBTree& other, ft::false_type) {
+				for (iterator it = begin(); it != end(); ) {
+					node_pointer node = (it++).node();
+					if (other.search(value(node), other.root_) == other.nil_) {
+						erase_node(node);
+					}
+				}
+			}
+
+			//↓↓↓ O(m log n)
+			void set_difference(const RBTree& other, ft::false_type) {
+				for (const_iterator it = other.begin(); it != other.end(); ++it) {
+					delete_node(*it);
+				}
+			}
+
+			//↓↓↓ поиск ведется по ключу: comp_ должен уметь сравнивать value_type с K
+			// (см. map::value_compare), поэтому временный value_type не создается.
+			// С нативным трехсторонним сравнением -- одно сравнение на узел и выход при совпадении,
+			// иначе спуск как у lower_bound и одна проверка на равенство в конце.
+			template<typename K>
+			node_pointer search(const K& key, node_pointer node) const {
 				if(!node || node == nil_)
 					return node_pointer(nil_);
-				node_pointer ret_val = node;
-				while (ret_val != nil_) {
-					if (comp_(value, *ret_val->value_)){
-						ret_val = ret_val->left_;
-					} else if (comp_(*ret_val->value_, value)) {
-						ret_val = ret_val->right_;
+				return search(key, node, native_three_way());
+			}
+
+			template<typename K>
+			node_pointer search(const K& key, node_pointer node, ft::true_type) const {
+				while (node != nil_) {
+					int cmp = three_way::compare(comp_, key, value(node));
+					if (cmp < 0) {
+						node = node->left_;
+					} else if (cmp > 0) {
+						node = node->right_;
 					} else {
-						return ret_val;
+						return node;
 					}
 				}
-				return ret_val;
+				return node;
+			}
+
+			template<typename K>
+			node_pointer search(const K& key, node_pointer node, ft::false_type) const {
+				node_pointer result = nil_;
+				while (node != nil_) {
+					if (!comp_(value(node), key)) {
+						result = node;
+						node = node->left_;
+					} else {
+						node = node->right_;
+					}
+				}
+				if (result != nil_ && comp_(key, value(result))) {
+					return nil_;
+				}
+				return result;
+			}
+
+			//↓↓↓ порядковые статистики -- только для order_statistic_node_update
+			node_pointer select_node(size_type k) const {
+				node_pointer node = root_;
+				while (node != nil_) {
+					size_type left = subtree_count(node->left_);
+					if (k < left) {
+						node = node->left_;
+					} else if (k > left) {
+						k -= left + 1;
+						node = node->right_;
+					} else {
+						return node;
+					}
+				}
+				return nil_;
+			}
+
+			//↓↓↓ позиция узла в порядке обхода; для end() -- size()
+			size_type index_of(node_pointer node) const {
+				if (node == nil_) {
+					return size_;
+				}
+				size_type index = subtree_count(node->left_);
+				for (; node != root_; node = node->parent()) {
+					if (node == node->parent()->right_) {
+						index += subtree_count(node->parent()->left_) + 1;
+					}
+				}
+				return index;
+			}
+
+			iterator nth(size_type k) { return iterator(select_node(k)); }
+			const_iterator nth(size_type k) const { return const_iterator(select_node(k)); }
+
+			//↓↓↓ количество элементов, меньших key
+			template<typename K>
+			size_type rank(const K& key) const {
+				node_pointer node = root_;
+				size_type result = 0;
+				while (node != nil_) {
+					if (comp_(value(node), key)) {
+						result += subtree_count(node->left_) + 1;
+						node = node->right_;
+					} else {
+						node = node->left_;
+					}
+				}
+				return result;
+			}
+
+			difference_type distance(const_iterator first, const_iterator last) const {
+				return static_cast<difference_type>(index_of(last.node())) - static_cast<difference_type>(index_of(first.node()));
 			}
 
 			value_compare value_comp() const { return comp_; }
 			allocator_type get_allocator() const {return alloc_val_; }
 
 
-			iterator find(const value_type &value) {
-				node_pointer find_res = search(value, root_);
+			template<typename K>
+			iterator find(const K& key) {
+				node_pointer find_res = search(key, root_);
+				touch(find_res, balance());
 				return (find_res == nil_ ? end() : iterator(find_res));
 			}
 
-			const_iterator find(const value_type& value) const {
-				node_pointer find_res = search(value, root_);
+			template<typename K>
+			const_iterator find(const K& key) const {
+				node_pointer find_res = search(key, root_);
 				return (find_res == nil_ ? end() : const_iterator(find_res));
 			}
 			
-			size_type count(const value_type& value) const {
-				node_pointer find_res = search(value, root_);
+			template<typename K>
+			size_type count(const K& key) const {
+				node_pointer find_res = search(key, root_);
 				return (find_res == nil_ ? 0 : 1);
 			}
 
-			iterator lower_bound(const value_type& value) {
-				iterator last = end();
-				for (iterator first = begin(); first != last; ++first){
-					if(!comp_(*first, value)) {
-						return (first);
+			//↓↓↓ пакетный поиск: результат для каждого ключа [first, last) (end() -- ключа нет)
+			// пишется в out. Спуски batch_width ключей идут вперемешку по уровню за раз,
+			// и для каждого заранее загружается следующий узел: промахи кэша независимых
+			// спусков перекрываются, а не ждут друг друга. Итератор ключей -- прямой
+			template<typename ForwardIterator, typename OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) {
+				node_pointer found[batch_width];
+				while (first != last) {
+					size_type n = search_batch(first, last, found);
+					for (size_type i = 0; i < n; ++i) {
+						*out++ = iterator(found[i]);
+					}
+				}
+				return out;
+			}
+
+			template<typename ForwardIterator, typename OutputIterator>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+				node_pointer found[batch_width];
+				while (first != last) {
+					size_type n = search_batch(first, last, found);
+					for (size_type i = 0; i < n; ++i) {
+						*out++ = const_iterator(found[i]);
 					}
 				}
-				return (last);
+				return out;
 			}
 
-			const_iterator lower_bound(const value_type& value) const {
-				const_iterator last = end();
-				for (const_iterator first = begin(); first != last; ++first) {
-					if(!comp_(*first, value)) {
-						return (first);
+			static const size_type batch_width = 32;
+
+			//↓↓↓ до batch_width спусков как у lower_bound, first сдвигается за обработанные ключи.
+			// Ветвление по сравнению одинаково для всех политик, равенство проверяется в конце
+			template<typename ForwardIterator>
+			size_type search_batch(ForwardIterator& first, ForwardIterator last, node_pointer* found) const {
+				typedef typename ft::iterator_traits<ForwardIterator>::value_type	key_type;
+				const key_type* keys[batch_width];
+				node_pointer node[batch_width];
+				size_type n = 0;
+				for (; n < batch_width && first != last; ++n, ++first) {
+					keys[n] = &*first;
+					node[n] = root_;
+					found[n] = nil_;
+				}
+				for (bool active = (root_ != nil_); active; ) {
+					active = false;
+					for (size_type i = 0; i < n; ++i) {
+						node_pointer x = node[i];
+						if (x == nil_) {
+							continue;
+						}
+						if (!comp_(value(x), *keys[i])) {
+							found[i] = x;
+							x = x->left_;
+						} else {
+							x = x->right_;
+						}
+						ft::prefetch(x);
+						node[i] = x;
+						active = true;
+					}
+				}
+				for (size_type i = 0; i < n; ++i) {
+					if (found[i] != nil_ && comp_(*keys[i], value(found[i]))) {
+						found[i] = nil_;
 					}
 				}
-				return (last);
+				return n;
 			}
 
-			iterator upper_bound(const value_type& value) {
-				iterator last = end();
-				for (iterator first = begin(); first != last; ++first) {
-					if(comp_(value, *first)) {
-						return (first);
+			template<typename K>
+			node_pointer lower_bound_node(const K& key) const {
+				node_pointer node = root_;
+				node_pointer result = nil_;
+				while (node != nil_) {
+					if (!comp_(value(node), key)) {
+						result = node;
+						node = node->left_;
+					} else {
+						node = node->right_;
 					}
 				}
-				return (last);
+				return result;
 			}
 
-			const_iterator upper_bound(const value_type& value) const {
-				const_iterator last = end();
-				for (const_iterator first = begin(); first != last; ++first) {
-					if(_comp(value, *first)) {
-						return (first);
+			template<typename K>
+			node_pointer upper_bound_node(const K& key) const {
+				node_pointer node = root_;
+				node_pointer result = nil_;
+				while (node != nil_) {
+					if (comp_(key, value(node))) {
+						result = node;
+						node = node->left_;
+					} else {
+						node = node->right_;
 					}
 				}
-				return (last);
+				return result;
 			}
 
-			ft::pair<iterator, iterator> equal_range(const value_type &value) {
-				return (ft::make_pair(lower_bound(value), upper_bound(value)));
+			template<typename K>
+			iterator lower_bound(const K& key) { return iterator(lower_bound_node(key)); }
+			template<typename K>
+			const_iterator lower_bound(const K& key) const { return const_iterator(lower_bound_node(key)); }
+			template<typename K>
+			iterator upper_bound(const K& key) { return iterator(upper_bound_node(key)); }
+			template<typename K>
+			const_iterator upper_bound(const K& key) const { return const_iterator(upper_bound_node(key)); }
+
+			template<typename K>
+			ft::pair<iterator, iterator> equal_range(const K& key) {
+				iterator first = lower_bound(key);
+				iterator last = first;
+				if (last.node() != nil_ && !comp_(key, *last)) {
+					++last;
+				}
+				return (ft::make_pair(first, last));
 			}
 
-			pair<const_iterator, const_iterator> equal_range(const value_type &value) const {
-				return (ft::make_pair(lower_bound(value), upper_bound(value)));
+			template<typename K>
+			pair<const_iterator, const_iterator> equal_range(const K& key) const {
+				const_iterator first = lower_bound(key);
+				const_iterator last = first;
+				if (last.node() != nil_ && !comp_(key, *last)) {
+					++last;
+				}
+				return (ft::make_pair(first, last));
 			}
 	
 	}; //tree
 
-	template<typename t_Content, typename t_Compare, typename t_Alloc>
-	bool operator<(const RBTree<t_Content, t_Compare, t_Alloc>& lhs,  const RBTree<t_Content, t_Compare, t_Alloc>& rhs) {
+	//↓↓↓ дерево, на котором строятся map и set: по умолчанию RBTree, другое хранилище
+	// подключается специализацией по NodeUpdate (см. rb_tree_indexed.hpp). Хранилища
+	// indexed и persistent -- только красно-черные
+	template<typename Value, typename Compare, typename Allocator, typename NodeUpdate, typename Balance>
+	struct tree_select {
+		typedef RBTree<Value, Compare, Allocator, NodeUpdate, Balance>	type;
+	};
+
+	template<typename t_Content, typename t_Compare, typename t_Alloc, typename t_Update, typename t_Balance>
+	bool operator<(const RBTree<t_Content, t_Compare, t_Alloc, t_Update, t_Balance>& lhs,  const RBTree<t_Content, t_Compare, t_Alloc, t_Update, t_Balance>& rhs) {
 		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 	}
 
-	template<typename t_Content, typename t_Compare, typename t_Alloc>
-		bool operator>(const RBTree<t_Content, t_Compare, t_Alloc>& lhs,  const RBTree<t_Content, t_Compare, t_Alloc>& rhs) {
+	template<typename t_Content, typename t_Compare, typename t_Alloc, typename t_Update, typename t_Balance>
+		bool operator>(const RBTree<t_Content, t_Compare, t_Alloc, t_Update, t_Balance>& lhs,  const RBTree<t_Content, t_Compare, t_Alloc, t_Update, t_Balance>& rhs) {
 		return (lhs < rhs);
 	}
 
-	template<typename t_Content, typename t_Compare, typename t_Alloc>
-	bool operator==(const RBTree<t_Content, t_Compare, t_Alloc>& lhs, const RBTree<t_Content, t_Compare, t_Alloc>& rhs) {
+	template<typename t_Content, typename t_Compare, typename t_Alloc, typename t_Update, typename t_Balance>
+	bool operator==(const RBTree<t_Content, t_Compare, t_Alloc, t_Update, t_Balance>& lhs, const RBTree<t_Content, t_Compare, t_Alloc, t_Update, t_Balance>& rhs) {
 		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 	}
 	
@@ -0,0 +1,914 @@
+/*
+// RBTree_indexed -- красно-черное дерево, узлы которого лежат в одном растущем массиве
+// и ссылаются друг на друга 32-битными индексами. map и set строятся на нем,
+// если последним параметром шаблона указана политика ft::indexed_node_storage:
+//		ft::map<K, V, std::less<K>, std::allocator<ft::pair<const K, V> >, ft::indexed_node_storage>
+// Каркас узла -- 12 байт вместо трех указателей, узлы идут подряд без заголовков malloc.
+// Ячейка 0 -- nil, удаленные узлы уходят в список свободных и переиспользуются.
+// Массив не содержит указателей: его можно скопировать целиком, индексы останутся верными.
+// Ограничения:
+//		- не больше 2^31 - 2 элементов (индекс родителя делит слово с цветом), дальше -- length_error;
+//		- массив растет удвоением с копированием значений, поэтому вставка, как push_back у vector,
+//		  делает недействительными ссылки и указатели на элементы. Итераторы хранят индекс
+//		  и остаются валидными до удаления своего элемента.
+// Использованные материалы:
+//		https://en.cppreference.com/w/cpp/named_req/TriviallyCopyable
+//		https://github.com/gcc-mirror/gcc/blob/master/libstdc%2B%2B-v3/src/c%2B%2B98/tree.cc
+*/
+
+#ifndef RB_TREE_INDEXED_HPP
+# define RB_TREE_INDEXED_HPP
+
+# include <cstddef>
+# include <memory>
+# include <new>
+# include <stdexcept>
+# include "rb_tree.hpp"
+# include "../iterators/RBTree_handle_iterator.hpp"
+# include "../iterators/iterator_reverse.hpp"
+
+namespace ft {
+	template<typename Value, typename Compare = std::less<Value>, typename Allocator = std::allocator<Value> >
+	class RBTree_indexed {
+		public:
+			typedef Value													value_type;
+			typedef Compare 												value_compare;
+			typedef	Allocator												allocator_type;
+			typedef typename allocator_type::reference 						reference;
+			typedef typename allocator_type::const_reference			 	const_reference;
+			typedef typename allocator_type::pointer 						pointer;
+			typedef typename allocator_type::const_pointer					const_pointer;
+			typedef typename allocator_type::size_type						size_type;
+			typedef std::ptrdiff_t											difference_type;
+
+			typedef RB_Node_indexed<Value>									Node;
+			typedef typename Node::index_type								node_pointer;
+			typedef ft::three_way_compare<Compare, Value>					three_way;
+			typedef ft::integral_constant<bool, three_way::native>			native_three_way;
+
+			typedef typename allocator_type::template rebind<Node>::other 	allocator_node;
+
+			typedef ft::RBTree_handle_iterator<Value, RBTree_indexed>			iterator;
+			typedef ft::RBTree_handle_iterator<const Value, RBTree_indexed>	const_iterator;
+			typedef ft::reverse_iterator<iterator>								reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
+			//↓↓↓ узлы не извлекаются (см. rb_node_handle.hpp)
+			typedef ft::RBTree_no_node_handle								node_type;
+			typedef ft::RBTree_no_node_handle								insert_return_type;
+
+			//↓↓↓ индекс nil: общий лист и end()
+			static const node_pointer	nil_ = 0;
+
+		private:
+			//↓↓↓ parent_color_ свободной ячейки; у живого узла такого значения быть не может
+			static const node_pointer	free_mark = ~static_cast<node_pointer>(0);
+			//↓↓↓ ячеек в массиве, включая nil: родитель должен уместиться в 31 бит
+			static const node_pointer	max_nodes = 0x7fffffff;
+			static const node_pointer	first_capacity = 16;
+
+			allocator_node  alloc_node_;
+			allocator_type  alloc_val_;
+			Node*			nodes_;
+			node_pointer	capacity_;
+			//↓↓↓ ячейки [1, used_) уже выдавались; свободные из них связаны через left_
+			node_pointer	used_;
+			node_pointer	free_;
+			node_pointer 	root_;
+			node_pointer	leftmost_;
+			node_pointer	rightmost_;
+			value_compare 	comp_;
+			size_t 			size_;
+
+		private:
+			node_pointer& left(node_pointer node) const { return nodes_[node].left_; }
+			node_pointer& right(node_pointer node) const { return nodes_[node].right_; }
+			reference value(node_pointer node) const { return nodes_[node].value_; }
+
+			node_pointer parent(node_pointer node) const {
+				return nodes_[node].parent_color_ >> 1;
+			}
+
+			void set_parent(node_pointer node, node_pointer parent) {
+				nodes_[node].parent_color_ = (parent << 1) | (nodes_[node].parent_color_ & 1);
+			}
+
+			//↓↓↓ nil черный; ячейки 0 может не быть вовсе, поэтому он не читается
+			NodeColor color(node_pointer node) const {
+				return (node == nil_ ? black : static_cast<NodeColor>(nodes_[node].parent_color_ & 1));
+			}
+
+			void set_color(node_pointer node, NodeColor color) {
+				nodes_[node].parent_color_ = (nodes_[node].parent_color_ & ~static_cast<node_pointer>(1)) | color;
+			}
+
+			node_pointer tree_minimum(node_pointer node) const {
+				while (node != nil_ && left(node) != nil_) {
+					node = left(node);
+				}
+				return node;
+			}
+
+			node_pointer tree_maximum(node_pointer node) const {
+				while (node != nil_ && right(node) != nil_) {
+					node = right(node);
+				}
+				return node;
+			}
+
+			//↓↓↓ массив узлов
+			bool full() const {
+				return free_ == nil_ && used_ >= capacity_;
+			}
+
+			void grow() {
+				if (capacity_ >= max_nodes) {
+					throw std::length_error("ft::RBTree_indexed");
+				}
+				node_pointer capacity = first_capacity;
+				if (capacity_ >= max_nodes / 2) {
+					capacity = max_nodes;
+				} else if (capacity_ > 0) {
+					capacity = capacity_ * 2;
+				}
+				reallocate(capacity);
+			}
+
+			//↓↓↓ переносит узлы [1, used_) в новый массив, индексы не меняются
+			void reallocate(node_pointer capacity) {
+				Node* nodes = alloc_node_.allocate(capacity);
+				node_pointer i = 1;
+				try {
+					for (; i < used_; ++i) {
+						copy_slot(nodes, nodes_, i);
+					}
+				} catch (...) {
+					destroy_slots(nodes, i);
+					alloc_node_.deallocate(nodes, capacity);
+					throw;
+				}
+				nodes[nil_].left_ = nodes[nil_].right_ = nodes[nil_].parent_color_ = nil_;
+				release_nodes();
+				nodes_ = nodes;
+				capacity_ = capacity;
+			}
+
+			void copy_slot(Node* to, const Node* from, node_pointer i) {
+				to[i].left_ = from[i].left_;
+				to[i].right_ = from[i].right_;
+				to[i].parent_color_ = from[i].parent_color_;
+				if (from[i].parent_color_ != free_mark) {
+					alloc_val_.construct(&to[i].value_, from[i].value_);
+				}
+			}
+
+			void destroy_slots(Node* nodes, node_pointer end) {
+				for (node_pointer i = 1; i < end; ++i) {
+					if (nodes[i].parent_color_ != free_mark) {
+						alloc_val_.destroy(&nodes[i].value_);
+					}
+				}
+			}
+
+			void release_nodes() {
+				if (nodes_ != 0) {
+					destroy_slots(nodes_, used_);
+					alloc_node_.deallocate(nodes_, capacity_);
+				}
+			}
+
+			node_pointer take_slot() {
+				if (free_ != nil_) {
+					node_pointer slot = free_;
+					free_ = nodes_[slot].left_;
+					return slot;
+				}
+				if (used_ >= capacity_) {
+					grow();
+				}
+				return used_++;
+			}
+
+			void release_slot(node_pointer slot) {
+				nodes_[slot].parent_color_ = free_mark;
+				nodes_[slot].left_ = free_;
+				free_ = slot;
+			}
+
+			//↓↓↓ черная высота поддерева или -1: узлов больше size_, ячейка свободна, сын не
+			// ссылается на родителя, красный узел с красным сыном, разные высоты
+			int verify_subtree(node_pointer node, size_type& count) const {
+				if (node == nil_) {
+					return 0;
+				}
+				if (++count > size_ || node >= used_ || nodes_[node].parent_color_ == free_mark
+						|| (left(node) != nil_ && parent(left(node)) != node)
+						|| (right(node) != nil_ && parent(right(node)) != node)
+						|| (color(node) == red && (color(left(node)) == red || color(right(node)) == red))) {
+					return -1;
+				}
+				int left_height = verify_subtree(left(node), count);
+				int right_height = verify_subtree(right(node), count);
+				if (left_height < 0 || left_height != right_height) {
+					return -1;
+				}
+				return left_height + (color(node) == black);
+			}
+
+			void copy_from(const RBTree_indexed& rhs) {
+				if (rhs.size_ == 0) {
+					return ;
+				}
+				Node* nodes = alloc_node_.allocate(rhs.used_);
+				node_pointer i = 1;
+				try {
+					for (; i < rhs.used_; ++i) {
+						copy_slot(nodes, rhs.nodes_, i);
+					}
+				} catch (...) {
+					destroy_slots(nodes, i);
+					alloc_node_.deallocate(nodes, rhs.used_);
+					throw;
+				}
+				nodes[nil_].left_ = nodes[nil_].right_ = nodes[nil_].parent_color_ = nil_;
+				nodes_ = nodes;
+				capacity_ = used_ = rhs.used_;
+				free_ = rhs.free_;
+				root_ = rhs.root_;
+				leftmost_ = rhs.leftmost_;
+				rightmost_ = rhs.rightmost_;
+				size_ = rhs.size_;
+			}
+
+		public:
+			RBTree_indexed() :
+					alloc_node_(allocator_node()),
+					alloc_val_(allocator_type()),
+					nodes_(0), capacity_(0), used_(1), free_(nil_),
+					root_(nil_), leftmost_(nil_), rightmost_(nil_),
+					comp_(value_compare()),
+					size_(0) {
+			}
+
+			RBTree_indexed(const Compare &cmp, const allocator_type& alloc = allocator_type()):
+					alloc_node_(alloc),
+					alloc_val_(alloc),
+					nodes_(0), capacity_(0), used_(1), free_(nil_),
+					root_(nil_), leftmost_(nil_), rightmost_(nil_),
+					comp_(cmp),
+					size_(0) {
+			}
+
+			RBTree_indexed(const RBTree_indexed& rhs) :
+					alloc_node_(rhs.alloc_node_),
+					alloc_val_(rhs.alloc_val_),
+					nodes_(0), capacity_(0), used_(1), free_(nil_),
+					root_(nil_), leftmost_(nil_), rightmost_(nil_),
+					comp_(rhs.comp_),
+					size_(0) {
+				copy_from(rhs);
+			}
+
+			//↓↓↓ копия -- тот же массив с теми же индексами, без спусков и балансировки
+			RBTree_indexed& operator=(const RBTree_indexed& rhs) {
+				if (this == &rhs) {
+					return *this;
+				}
+				clear();
+				alloc_node_ = rhs.alloc_node_;
+				alloc_val_ = rhs.alloc_val_;
+				comp_ = rhs.comp_;
+				copy_from(rhs);
+				return *this;
+			}
+
+			~RBTree_indexed() {
+				release_nodes();
+			}
+
+			bool empty() const { return size_ == 0; }
+			size_type size() const { return size_; }
+
+			size_type max_size() const {
+				size_type limit = max_nodes - 1;
+				return (alloc_node_.max_size() < limit ? alloc_node_.max_size() : limit);
+			}
+
+			//↓↓↓ инварианты (для тестов), O(n): связи с родителями, порядок ключей, крайние узлы,
+			// цвета и черная высота, size_; каждая выданная ячейка [1, used_) -- либо узел
+			// дерева, либо звено списка свободных
+			bool verify() const {
+				if (capacity_ == 0 ? (used_ != 1 || size_ != 0) : used_ > capacity_) {
+					return false;
+				}
+				if (leftmost_ != tree_minimum(root_) || rightmost_ != tree_maximum(root_)
+						|| (root_ != nil_ && (parent(root_) != nil_ || color(root_) != black))) {
+					return false;
+				}
+				size_type count = 0;
+				if (verify_subtree(root_, count) < 0 || count != size_) {
+					return false;
+				}
+				node_pointer prev = nil_;
+				for (node_pointer node = leftmost_; node != nil_; node = next_node(node)) {
+					if (prev != nil_ && !comp_(value(prev), value(node))) {
+						return false;
+					}
+					prev = node;
+				}
+				size_type free = 0;
+				for (node_pointer slot = free_; slot != nil_; slot = left(slot)) {
+					if (slot >= used_ || nodes_[slot].parent_color_ != free_mark || ++free >= used_) {
+						return false;
+					}
+				}
+				return size_ + free == used_ - 1;
+			}
+
+			//↓↓↓ для итераторов: шаги в порядке обхода, замкнутые через nil
+			const value_type& node_value(node_pointer node) const { return nodes_[node].value_; }
+
+			node_pointer next_node(node_pointer node) const {
+				if (node == nil_) {
+					return leftmost_;
+				}
+				if (right(node) != nil_) {
+					return tree_minimum(right(node));
+				}
+				node_pointer tmp = parent(node);
+				while (tmp != nil_ && node == right(tmp)) {
+					node = tmp;
+					tmp = parent(tmp);
+				}
+				return tmp;
+			}
+
+			node_pointer prev_node(node_pointer node) const {
+				if (node == nil_) {
+					return rightmost_;
+				}
+				if (left(node) != nil_) {
+					return tree_maximum(left(node));
+				}
+				node_pointer tmp = parent(node);
+				while (tmp != nil_ && node == left(tmp)) {
+					node = tmp;
+					tmp = parent(tmp);
+				}
+				return tmp;
+			}
+
+			iterator end() { return iterator(this, nil_); }
+			const_iterator end() const { return const_iterator(this, nil_); }
+			iterator begin() { return iterator(this, leftmost_); }
+			const_iterator begin() const { return const_iterator(this, leftmost_); }
+			reverse_iterator rbegin() { return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+			reverse_iterator rend() { return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+			//↓↓↓ итераторы помнят дерево, поэтому после swap они указывают в другой контейнер
+			void swap(RBTree_indexed &rhs) {
+				std::swap(nodes_, rhs.nodes_);
+				std::swap(capacity_, rhs.capacity_);
+				std::swap(used_, rhs.used_);
+				std::swap(free_, rhs.free_);
+				std::swap(root_, rhs.root_);
+				std::swap(leftmost_, rhs.leftmost_);
+				std::swap(rightmost_, rhs.rightmost_);
+				std::swap(comp_, rhs.comp_);
+				std::swap(size_, rhs.size_);
+				ft::swap_allocator(alloc_node_, rhs.alloc_node_);
+				ft::swap_allocator(alloc_val_, rhs.alloc_val_);
+			}
+
+			void replace_child(node_pointer old_child, node_pointer new_child) {
+				if (old_child == root_) {
+					root_ = new_child;
+				} else if (old_child == left(parent(old_child))) {
+					left(parent(old_child)) = new_child;
+				} else {
+					right(parent(old_child)) = new_child;
+				}
+			}
+
+			void left_rotate(node_pointer node) {
+				node_pointer y = right(node);
+				right(node) = left(y);
+				if (left(y) != nil_) {
+					set_parent(left(y), node);
+				}
+				set_parent(y, parent(node));
+				replace_child(node, y);
+				left(y) = node;
+				set_parent(node, y);
+			}
+
+			void right_rotate(node_pointer node) {
+				node_pointer y = left(node);
+				left(node) = right(y);
+				if (right(y) != nil_) {
+					set_parent(right(y), node);
+				}
+				set_parent(y, parent(node));
+				replace_child(node, y);
+				right(y) = node;
+				set_parent(node, y);
+			}
+
+			ft::pair<iterator, bool> insert_node(const value_type& val) {
+				node_pointer pos;
+				bool insert_left;
+				if (unique_position(val, pos, insert_left)) {
+					return ft::pair<iterator, bool>(iterator(this, pos), false);
+				}
+				return ft::pair<iterator, bool>(iterator(this, link_node(pos, insert_left, val)), true);
+			}
+
+			//↓↓↓ то же, что RBTree::unique_position
+			template<typename K>
+			bool unique_position(const K& key, node_pointer& pos, bool& insert_left) const {
+				return unique_position(key, pos, insert_left, native_three_way());
+			}
+
+			template<typename K>
+			bool unique_position(const K& key, node_pointer& pos, bool& insert_left, ft::true_type) const {
+				node_pointer curr = root_;
+				pos = nil_;
+				insert_left = true;
+				while (curr != nil_) {
+					int cmp = three_way::compare(comp_, key, value(curr));
+					if (cmp == 0) {
+						pos = curr;
+						return true;
+					}
+					pos = curr;
+					insert_left = (cmp < 0);
+					curr = insert_left ? left(curr) : right(curr);
+				}
+				return false;
+			}
+
+			template<typename K>
+			bool unique_position(const K& key, node_pointer& pos, bool& insert_left, ft::false_type) const {
+				node_pointer curr = root_;
+				pos = nil_;
+				insert_left = true;
+				while (curr != nil_) {
+					pos = curr;
+					insert_left = comp_(key, value(curr));
+					curr = insert_left ? left(curr) : right(curr);
+				}
+				node_pointer prev = pos;
+				if (insert_left) {
+					if (pos == leftmost_) {
+						return false;
+					}
+					prev = prev_node(pos);
+				}
+				if (comp_(value(prev), key)) {
+					return false;
+				}
+				pos = prev;
+				return true;
+			}
+
+			//↓↓↓ вставка с подсказкой, как RBTree::insert_node(hint, val)
+			ft::pair<iterator, bool> insert_node(node_pointer hint, const value_type& val) {
+				if (hint == nil_) {
+					if (size_ > 0 && comp_(value(rightmost_), val)) {
+						return ft::pair<iterator, bool>(iterator(this, link_node(rightmost_, false, val)), true);
+					}
+					return insert_node(val);
+				}
+				if (comp_(val, value(hint))) {
+					if (hint == leftmost_) {
+						return ft::pair<iterator, bool>(iterator(this, link_node(hint, true, val)), true);
+					}
+					node_pointer before = prev_node(hint);
+					if (comp_(value(before), val)) {
+						if (right(before) == nil_) {
+							return ft::pair<iterator, bool>(iterator(this, link_node(before, false, val)), true);
+						}
+						return ft::pair<iterator, bool>(iterator(this, link_node(hint, true, val)), true);
+					}
+					return insert_node(val);
+				}
+				if (comp_(value(hint), val)) {
+					if (hint == rightmost_) {
+						return ft::pair<iterator, bool>(iterator(this, link_node(hint, false, val)), true);
+					}
+					node_pointer after = next_node(hint);
+					if (comp_(val, value(after))) {
+						if (right(hint) == nil_) {
+							return ft::pair<iterator, bool>(iterator(this, link_node(hint, false, val)), true);
+						}
+						return ft::pair<iterator, bool>(iterator(this, link_node(after, true, val)), true);
+					}
+					return insert_node(val);
+				}
+				return ft::pair<iterator, bool>(iterator(this, hint), false);
+			}
+
+			//↓↓↓ возрастающий диапазон идет через подсказку end() -- без спуска от корня
+			template<typename InputIterator>
+			void insert_range(InputIterator first, InputIterator last) {
+				for (; first != last; ++first) {
+					insert_node(nil_, *first);
+				}
+			}
+
+			//↓↓↓ при росте массива val может ссылаться на элемент этого же дерева,
+			// поэтому он сначала копируется, а потом массив переезжает
+			node_pointer link_node(node_pointer parent, bool insert_left, const value_type& val) {
+				if (full()) {
+					value_type tmp(val);
+					grow();
+					return link_node(parent, insert_left, tmp);
+				}
+				node_pointer node = take_slot();
+				try {
+					alloc_val_.construct(&nodes_[node].value_, val);
+				} catch (...) {
+					release_slot(node);
+					throw;
+				}
+				return attach_node(parent, insert_left, node);
+			}
+
+			template<typename K, typename M>
+			node_pointer emplace_node(node_pointer parent, bool insert_left, const K& key, const M& obj) {
+				if (full()) {
+					value_type tmp(key, obj);
+					grow();
+					return link_node(parent, insert_left, tmp);
+				}
+				node_pointer node = take_slot();
+				try {
+					::new (static_cast<void*>(&nodes_[node].value_)) value_type(ft::pair_ref<K, M>(key, obj));
+				} catch (...) {
+					release_slot(node);
+					throw;
+				}
+				return attach_node(parent, insert_left, node);
+			}
+
+			template<typename K, typename M>
+			ft::pair<iterator, bool> try_emplace(const K& key, const M& obj) {
+				node_pointer pos;
+				bool insert_left;
+				if (unique_position(key, pos, insert_left)) {
+					return ft::pair<iterator, bool>(iterator(this, pos), false);
+				}
+				return ft::pair<iterator, bool>(iterator(this, emplace_node(pos, insert_left, key, obj)), true);
+			}
+
+			//↓↓↓ map::operator[]
+			template<typename K, typename M>
+			value_type& emplace_value(const K& key, const M& obj) {
+				return *try_emplace(key, obj).first;
+			}
+
+			node_pointer attach_node(node_pointer parent, bool insert_left, node_pointer node) {
+				left(node) = right(node) = nil_;
+				nodes_[node].parent_color_ = (parent << 1) | red;
+				if (parent == nil_) {
+					root_ = leftmost_ = rightmost_ = node;
+				} else if (insert_left) {
+					left(parent) = node;
+					if (parent == leftmost_) {
+						leftmost_ = node;
+					}
+				} else {
+					right(parent) = node;
+					if (parent == rightmost_) {
+						rightmost_ = node;
+					}
+				}
+				insert_fixup(node);
+				++size_;
+				return node;
+			}
+
+			void insert_fixup(node_pointer node) {
+				while (node != root_ && color(parent(node)) == red) {
+					node_pointer grand = parent(parent(node));
+					if (parent(node) == left(grand)) {
+						node_pointer y = right(grand);
+						if (color(y) == red) {
+							set_color(parent(node), black);
+							set_color(y, black);
+							set_color(grand, red);
+							node = grand;
+						} else {
+							if (node == right(parent(node))) {
+								node = parent(node);
+								left_rotate(node);
+							}
+							set_color(parent(node), black);
+							set_color(parent(parent(node)), red);
+							right_rotate(parent(parent(node)));
+						}
+					} else {
+						node_pointer y = left(grand);
+						if (color(y) == red) {
+							set_color(parent(node), black);
+							set_color(y, black);
+							set_color(grand, red);
+							node = grand;
+						} else {
+							if (node == left(parent(node))) {
+								node = parent(node);
+								right_rotate(node);
+							}
+							set_color(parent(node), black);
+							set_color(parent(parent(node)), red);
+							left_rotate(parent(parent(node)));
+						}
+					}
+				}
+				set_color(root_, black);
+			}
+
+			template<typename K>
+			bool delete_node(const K& key) {
+				node_pointer pos = search(key);
+				if (pos == nil_) {
+					return false;
+				}
+				erase_node(pos);
+				return true;
+			}
+
+			void erase(iterator position) {
+				erase_node(position.node());
+			}
+
+			void erase(iterator first, iterator last) {
+				if (first == begin() && last == end()) {
+					clear();
+					return;
+				}
+				while (first != last) {
+					erase_node((first++).node());
+				}
+			}
+
+			//↓↓↓ как RBTree::erase_node: на место pos с двумя потомками перевешивается
+			// следующий узел, значения не перемещаются, ячейка pos уходит в список свободных
+			void erase_node(node_pointer pos) {
+				node_pointer y = pos;
+				node_pointer node;
+				node_pointer node_parent;
+				if (pos == leftmost_) {
+					leftmost_ = (right(pos) != nil_ ? tree_minimum(right(pos)) : parent(pos));
+				}
+				if (pos == rightmost_) {
+					rightmost_ = (left(pos) != nil_ ? tree_maximum(left(pos)) : parent(pos));
+				}
+				if (left(y) == nil_) {
+					node = right(y);
+				} else if (right(y) == nil_) {
+					node = left(y);
+				} else {
+					y = tree_minimum(right(y));
+					node = right(y);
+				}
+				if (y != pos) {
+					set_parent(left(pos), y);
+					left(y) = left(pos);
+					if (y != right(pos)) {
+						node_parent = parent(y);
+						if (node != nil_) {
+							set_parent(node, parent(y));
+						}
+						left(parent(y)) = node;
+						right(y) = right(pos);
+						set_parent(right(pos), y);
+					} else {
+						node_parent = y;
+					}
+					replace_child(pos, y);
+					set_parent(y, parent(pos));
+					NodeColor tmp = color(y);
+					set_color(y, color(pos));
+					set_color(pos, tmp);
+				} else {
+					node_parent = parent(y);
+					if (node != nil_) {
+						set_parent(node, parent(y));
+					}
+					replace_child(pos, node);
+				}
+				if (color(pos) != red) {
+					delete_fixup(node, node_parent);
+				}
+				alloc_val_.destroy(&nodes_[pos].value_);
+				release_slot(pos);
+				size_--;
+			}
+
+			void delete_fixup(node_pointer node, node_pointer parent_node) {
+				while (node != root_ && color(node) != red) {
+					if (node == left(parent_node)) {
+						node_pointer w = right(parent_node);
+						if (color(w) == red) {
+							set_color(w, black);
+							set_color(parent_node, red);
+							left_rotate(parent_node);
+							w = right(parent_node);
+						}
+						if (color(left(w)) != red && color(right(w)) != red) {
+							set_color(w, red);
+							node = parent_node;
+							parent_node = parent(parent_node);
+						} else {
+							if (color(right(w)) != red) {
+								set_color(left(w), black);
+								set_color(w, red);
+								right_rotate(w);
+								w = right(parent_node);
+							}
+							set_color(w, color(parent_node));
+							set_color(parent_node, black);
+							set_color(right(w), black);
+							left_rotate(parent_node);
+							node = root_;
+						}
+					} else {
+						node_pointer w = left(parent_node);
+						if (color(w) == red) {
+							set_color(w, black);
+							set_color(parent_node, red);
+							right_rotate(parent_node);
+							w = left(parent_node);
+						}
+						if (color(right(w)) != red && color(left(w)) != red) {
+							set_color(w, red);
+							node = parent_node;
+							parent_node = parent(parent_node);
+						} else {
+							if (color(left(w)) != red) {
+								set_color(right(w), black);
+								set_color(w, red);
+								left_rotate(w);
+								w = left(parent_node);
+							}
+							set_color(w, color(parent_node));
+							set_color(parent_node, black);
+							set_color(left(w), black);
+							right_rotate(parent_node);
+							node = root_;
+						}
+					}
+				}
+				if (node != nil_) {
+					set_color(node, black);
+				}
+			}
+
+			//↓↓↓ массив освобождается целиком: пустое дерево не держит памяти
+			void clear() {
+				release_nodes();
+				nodes_ = 0;
+				capacity_ = 0;
+				used_ = 1;
+				free_ = root_ = leftmost_ = rightmost_ = nil_;
+				size_ = 0;
+				ft::release_allocator(alloc_node_);
+			}
+
+			//↓↓↓ поиск по ключу, как RBTree::search
+			template<typename K>
+			node_pointer search(const K& key) const {
+				return search(key, native_three_way());
+			}
+
+			template<typename K>
+			node_pointer search(const K& key, ft::true_type) const {
+				node_pointer node = root_;
+				while (node != nil_) {
+					int cmp = three_way::compare(comp_, key, value(node));
+					if (cmp < 0) {
+						node = left(node);
+					} else if (cmp > 0) {
+						node = right(node);
+					} else {
+						return node;
+					}
+				}
+				return node;
+			}
+
+			template<typename K>
+			node_pointer search(const K& key, ft::false_type) const {
+				node_pointer result = lower_bound_node(key);
+				if (result != nil_ && comp_(key, value(result))) {
+					return nil_;
+				}
+				return result;
+			}
+
+			value_compare value_comp() const { return comp_; }
+			allocator_type get_allocator() const { return alloc_val_; }
+
+			template<typename K>
+			iterator find(const K& key) { return iterator(this, search(key)); }
+
+			template<typename K>
+			const_iterator find(const K& key) const { return const_iterator(this, search(key)); }
+
+			template<typename K>
+			size_type count(const K& key) const {
+				return (search(key) == nil_ ? 0 : 1);
+			}
+
+			template<typename K>
+			node_pointer lower_bound_node(const K& key) const {
+				node_pointer node = root_;
+				node_pointer result = nil_;
+				while (node != nil_) {
+					if (!comp_(value(node), key)) {
+						result = node;
+						node = left(node);
+					} else {
+						node = right(node);
+					}
+				}
+				return result;
+			}
+
+			template<typename K>
+			node_pointer upper_bound_node(const K& key) const {
+				node_pointer node = root_;
+				node_pointer result = nil_;
+				while (node != nil_) {
+					if (comp_(key, value(node))) {
+						result = node;
+						node = left(node);
+					} else {
+						node = right(node);
+					}
+				}
+				return result;
+			}
+
+			template<typename K>
+			iterator lower_bound(const K& key) { return iterator(this, lower_bound_node(key)); }
+			template<typename K>
+			const_iterator lower_bound(const K& key) const { return const_iterator(this, lower_bound_node(key)); }
+			template<typename K>
+			iterator upper_bound(const K& key) { return iterator(this, upper_bound_node(key)); }
+			template<typename K>
+			const_iterator upper_bound(const K& key) const { return const_iterator(this, upper_bound_node(key)); }
+
+			template<typename K>
+			ft::pair<iterator, iterator> equal_range(const K& key) {
+				iterator first = lower_bound(key);
+				iterator last = first;
+				if (last.node() != nil_ && !comp_(key, *last)) {
+					++last;
+				}
+				return (ft::make_pair(first, last));
+			}
+
+			template<typename K>
+			pair<const_iterator, const_iterator> equal_range(const K& key) const {
+				const_iterator first = lower_bound(key);
+				const_iterator last = first;
+				if (last.node() != nil_ && !comp_(key, *last)) {
+					++last;
+				}
+				return (ft::make_pair(first, last));
+			}
+	}; //tree
+
+	template<typename Value, typename Compare, typename Allocator>
+	const typename RBTree_indexed<Value, Compare, Allocator>::node_pointer RBTree_indexed<Value, Compare, Allocator>::nil_;
+
+	template<typename Value, typename Compare, typename Allocator>
+	const typename RBTree_indexed<Value, Compare, Allocator>::node_pointer RBTree_indexed<Value, Compare, Allocator>::free_mark;
+
+	template<typename Value, typename Compare, typename Allocator>
+	const typename RBTree_indexed<Value, Compare, Allocator>::node_pointer RBTree_indexed<Value, Compare, Allocator>::max_nodes;
+
+	template<typename Value, typename Compare, typename Allocator>
+	const typename RBTree_indexed<Value, Compare, Allocator>::node_pointer RBTree_indexed<Value, Compare, Allocator>::first_capacity;
+
+	template<typename Value, typename Compare, typename Allocator>
+	struct tree_select<Value, Compare, Allocator, ft::indexed_node_storage, ft::red_black_balance> {
+		typedef RBTree_indexed<Value, Compare, Allocator>	type;
+	};
+
+	template<typename t_Content, typename t_Compare, typename t_Alloc>
+	bool operator<(const RBTree_indexed<t_Content, t_Compare, t_Alloc>& lhs, const RBTree_indexed<t_Content, t_Compare, t_Alloc>& rhs) {
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template<typename t_Content, typename t_Compare, typename t_Alloc>
+	bool operator==(const RBTree_indexed<t_Content, t_Compare, t_Alloc>& lhs, const RBTree_indexed<t_Content, t_Compare, t_Alloc>& rhs) {
+		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,629 @@
+/*
+// RBTree_persistent -- персистентное (path copying) красно-черное дерево.
+// map и set строятся на нем, если последним параметром шаблона указана политика
+// ft::persistent_node_storage:
+//		ft::map<K, V, std::less<K>, std::allocator<ft::pair<const K, V> >, ft::persistent_node_storage>
+// Копия контейнера -- снимок за O(1): версии делят узлы, у каждого узла счетчик ссылок.
+// Запись меняет на месте узлы, принадлежащие только этой версии, а общие с другими
+// версиями копирует -- не больше O(log n) узлов на операцию. Узел освобождается,
+// когда на него не ссылается ни одна версия.
+// Дерево левостороннее (LLRB): у узлов нет родителя, вставка и удаление -- рекурсивный
+// спуск с балансировкой на обратном пути.
+// Отличия от RBTree:
+//		- итераторы только на чтение (iterator == const_iterator): запись через итератор
+//		  изменила бы и снимки. Значение меняется через operator[] или insert;
+//		- ++ у листа -- поиск следующего ключа от корня, O(log n);
+//		- любое изменение контейнера делает недействительными его итераторы, ссылки
+//		  и указатели; итераторы снимков остаются валидными;
+//		- счетчики ссылок не атомарные: версии, делящие узлы, нельзя менять или
+//		  разрушать из разных потоков одновременно.
+//		- узлы переходят между версиями, поэтому копии аллокатора должны освобождать
+//		  память друг друга (std::allocator, ft::pool_allocator с общим пулом копий).
+// Использованные материалы:
+//		https://sedgewick.io/wp-content/themes/sedgewick/papers/2008LLRB.pdf
+//		https://algs4.cs.princeton.edu/33balanced/RedBlackBST.java.html
+//		https://en.wikipedia.org/wiki/Persistent_data_structure
+*/
+
+#ifndef RB_TREE_PERSISTENT_HPP
+# define RB_TREE_PERSISTENT_HPP
+
+# include <cstddef>
+# include <memory>
+# include <new>
+# include "rb_tree.hpp"
+# include "../iterators/RBTree_handle_iterator.hpp"
+# include "../iterators/iterator_reverse.hpp"
+
+namespace ft {
+	template<typename Value, typename Compare = std::less<Value>, typename Allocator = std::allocator<Value> >
+	class RBTree_persistent {
+		public:
+			typedef Value													value_type;
+			typedef Compare 												value_compare;
+			typedef	Allocator												allocator_type;
+			typedef typename allocator_type::reference 						reference;
+			typedef typename allocator_type::const_reference			 	const_reference;
+			typedef typename allocator_type::pointer 						pointer;
+			typedef typename allocator_type::const_pointer					const_pointer;
+			typedef typename allocator_type::size_type						size_type;
+			typedef std::ptrdiff_t											difference_type;
+
+			typedef RB_Node_persistent<Value>								Node;
+			typedef Node*													node_pointer;
+			typedef ft::three_way_compare<Compare, Value>					three_way;
+			typedef ft::integral_constant<bool, three_way::native>			native_three_way;
+
+			typedef typename allocator_type::template rebind<Node>::other 	allocator_node;
+
+			typedef ft::RBTree_handle_iterator<const Value, RBTree_persistent>	iterator;
+			typedef iterator													const_iterator;
+			typedef ft::reverse_iterator<iterator>								reverse_iterator;
+			typedef reverse_iterator											const_reverse_iterator;
+			//↓↓↓ узлы не извлекаются (см. rb_node_handle.hpp)
+			typedef ft::RBTree_no_node_handle								node_type;
+			typedef ft::RBTree_no_node_handle								insert_return_type;
+
+		private:
+			allocator_node  alloc_node_;
+			allocator_type  alloc_val_;
+			node_pointer 	root_;
+			value_compare 	comp_;
+			size_t 			size_;
+
+		private:
+			static bool is_red(node_pointer node) {
+				return node != 0 && node->color() == red;
+			}
+
+			node_pointer tree_minimum(node_pointer node) const {
+				while (node != 0 && node->left_ != 0) {
+					node = node->left_;
+				}
+				return node;
+			}
+
+			node_pointer tree_maximum(node_pointer node) const {
+				while (node != 0 && node->right_ != 0) {
+					node = node->right_;
+				}
+				return node;
+			}
+
+			node_pointer create_node(const value_type& val) {
+				node_pointer node = alloc_node_.allocate(1);
+				try {
+					alloc_val_.construct(&node->value_, val);
+				} catch (...) {
+					alloc_node_.deallocate(node, 1);
+					throw;
+				}
+				node->init(red);
+				return node;
+			}
+
+			template<typename K, typename M>
+			node_pointer create_node(const K& key, const M& obj) {
+				node_pointer node = alloc_node_.allocate(1);
+				try {
+					::new (static_cast<void*>(&node->value_)) value_type(ft::pair_ref<K, M>(key, obj));
+				} catch (...) {
+					alloc_node_.deallocate(node, 1);
+					throw;
+				}
+				node->init(red);
+				return node;
+			}
+
+			void destroy_node(node_pointer node) {
+				alloc_val_.destroy(&node->value_);
+				alloc_node_.deallocate(node, 1);
+			}
+
+			//↓↓↓ отпускает ссылку; последняя ссылка освобождает узел и отпускает детей
+			void release(node_pointer node) {
+				if (node != 0 && node->release() == 0) {
+					release(node->left_);
+					release(node->right_);
+					destroy_node(node);
+				}
+			}
+
+			//↓↓↓ делает узел по ссылке link собственным для этой версии: общий узел
+			// заменяется копией (дети копии -- те же, с лишней ссылкой). Ссылка обновляется
+			// сразу, поэтому исключение из create_node оставляет дерево целым.
+			node_pointer own(node_pointer& link) {
+				node_pointer node = link;
+				if (node->refs() == 1) {
+					return node;
+				}
+				node_pointer copy = create_node(node->value_);
+				copy->set_color(node->color());
+				copy->left_ = node->left_;
+				copy->right_ = node->right_;
+				if (copy->left_ != 0) {
+					copy->left_->acquire();
+				}
+				if (copy->right_ != 0) {
+					copy->right_->acquire();
+				}
+				node->release();
+				link = copy;
+				return copy;
+			}
+
+			//↓↓↓ балансировка LLRB; node и все узлы, которые меняются, -- собственные
+			node_pointer rotate_left(node_pointer node) {
+				node_pointer x = own(node->right_);
+				node->right_ = x->left_;
+				x->left_ = node;
+				x->set_color(node->color());
+				node->set_color(red);
+				return x;
+			}
+
+			node_pointer rotate_right(node_pointer node) {
+				node_pointer x = own(node->left_);
+				node->left_ = x->right_;
+				x->right_ = node;
+				x->set_color(node->color());
+				node->set_color(red);
+				return x;
+			}
+
+			void flip_colors(node_pointer node) {
+				node->flip_color();
+				own(node->left_)->flip_color();
+				own(node->right_)->flip_color();
+			}
+
+			node_pointer fix_up(node_pointer node) {
+				if (is_red(node->right_) && !is_red(node->left_)) {
+					node = rotate_left(node);
+				}
+				if (is_red(node->left_) && is_red(node->left_->left_)) {
+					node = rotate_right(node);
+				}
+				if (is_red(node->left_) && is_red(node->right_)) {
+					flip_colors(node);
+				}
+				return node;
+			}
+
+			node_pointer move_red_left(node_pointer node) {
+				flip_colors(node);
+				if (is_red(node->right_->left_)) {
+					node->right_ = rotate_right(own(node->right_));
+					node = rotate_left(node);
+					flip_colors(node);
+				}
+				return node;
+			}
+
+			node_pointer move_red_right(node_pointer node) {
+				flip_colors(node);
+				if (is_red(node->left_->left_)) {
+					node = rotate_right(node);
+					flip_colors(node);
+				}
+				return node;
+			}
+
+			//↓↓↓ x -- новый лист; ключа x в дереве нет (проверено поиском)
+			node_pointer put(node_pointer node, node_pointer x) {
+				if (comp_(x->value_, node->value_)) {
+					node->left_ = (node->left_ == 0 ? x : put(own(node->left_), x));
+				} else {
+					node->right_ = (node->right_ == 0 ? x : put(own(node->right_), x));
+				}
+				return fix_up(node);
+			}
+
+			//↓↓↓ вырезает минимальный узел поддерева и отдает его в min, не разрушая
+			node_pointer remove_min(node_pointer node, node_pointer& min) {
+				if (node->left_ == 0) {
+					min = node;
+					return 0;
+				}
+				if (!is_red(node->left_) && !is_red(node->left_->left_)) {
+					node = move_red_left(node);
+				}
+				node->left_ = remove_min(own(node->left_), min);
+				return fix_up(node);
+			}
+
+			//↓↓↓ ключ в дереве есть. key может лежать в удаляемом узле: после его
+			// разрушения сравнений больше нет
+			template<typename K>
+			node_pointer remove(node_pointer node, const K& key) {
+				if (comp_(key, node->value_)) {
+					if (!is_red(node->left_) && !is_red(node->left_->left_)) {
+						node = move_red_left(node);
+					}
+					node->left_ = remove(own(node->left_), key);
+				} else {
+					if (is_red(node->left_)) {
+						node = rotate_right(node);
+					}
+					if (node->right_ == 0 && !comp_(node->value_, key)) {
+						destroy_node(node);
+						return 0;
+					}
+					if (!is_red(node->right_) && !is_red(node->right_->left_)) {
+						node = move_red_right(node);
+					}
+					if (!comp_(node->value_, key)) {
+						//↓↓↓ значения не копируются: на место node встает следующий за ним узел
+						node_pointer min;
+						node->right_ = remove_min(own(node->right_), min);
+						min->left_ = node->left_;
+						min->right_ = node->right_;
+						min->set_color(node->color());
+						destroy_node(node);
+						node = min;
+					} else {
+						node->right_ = remove(own(node->right_), key);
+					}
+				}
+				return fix_up(node);
+			}
+
+			template<typename K>
+			void erase_value(const K& key) {
+				own(root_);
+				if (!is_red(root_->left_) && !is_red(root_->right_)) {
+					root_->set_color(red);
+				}
+				root_ = remove(root_, key);
+				if (root_ != 0) {
+					root_->set_color(black);
+				}
+				--size_;
+			}
+
+			node_pointer link_node(node_pointer x) {
+				if (root_ == 0) {
+					root_ = x;
+				} else {
+					try {
+						root_ = put(own(root_), x);
+					} catch (...) {
+						destroy_node(x);
+						throw;
+					}
+				}
+				root_->set_color(black);
+				++size_;
+				return x;
+			}
+
+			//↓↓↓ черная высота поддерева между low и high (0 -- без границы) или -1, если
+			// нарушен порядок ключей, правило LLRB или у узла нет ссылок
+			int verify_subtree(node_pointer node, node_pointer low, node_pointer high, size_type& count) const {
+				if (node == 0) {
+					return 0;
+				}
+				if (node->refs() == 0 || is_red(node->right_) || (is_red(node) && is_red(node->left_))
+						|| (low != 0 && !comp_(low->value_, node->value_))
+						|| (high != 0 && !comp_(node->value_, high->value_))) {
+					return -1;
+				}
+				++count;
+				int left = verify_subtree(node->left_, low, node, count);
+				int right = verify_subtree(node->right_, node, high, count);
+				if (left < 0 || left != right) {
+					return -1;
+				}
+				return left + !is_red(node);
+			}
+
+			//↓↓↓ путь до узла с ключом key становится собственным -- в узел можно писать
+			template<typename K>
+			node_pointer own_path(const K& key) {
+				node_pointer* link = &root_;
+				while (true) {
+					node_pointer node = own(*link);
+					if (comp_(key, node->value_)) {
+						link = &node->left_;
+					} else if (comp_(node->value_, key)) {
+						link = &node->right_;
+					} else {
+						return node;
+					}
+				}
+			}
+
+		public:
+		 	RBTree_persistent() :
+					alloc_node_(allocator_node()),
+					alloc_val_(allocator_type()),
+					root_(0),
+					comp_(value_compare()),
+					size_(0) {
+			}
+
+			RBTree_persistent(const Compare &cmp, const allocator_type& alloc = allocator_type()):
+					alloc_node_(alloc),
+					alloc_val_(alloc),
+					root_(0),
+					comp_(cmp),
+					size_(0) {
+			}
+
+			//↓↓↓ снимок: O(1), узлы общие
+			RBTree_persistent(const RBTree_persistent& rhs) :
+					alloc_node_(rhs.alloc_node_),
+					alloc_val_(rhs.alloc_val_),
+					root_(rhs.root_),
+					comp_(rhs.comp_),
+					size_(rhs.size_) {
+				if (root_ != 0) {
+					root_->acquire();
+				}
+			}
+
+			RBTree_persistent& operator=(const RBTree_persistent& rhs) {
+				if (this == &rhs) {
+					return *this;
+				}
+				if (rhs.root_ != 0) {
+					rhs.root_->acquire();
+				}
+				release(root_);
+				root_ = rhs.root_;
+				size_ = rhs.size_;
+				alloc_node_ = rhs.alloc_node_;
+				alloc_val_ = rhs.alloc_val_;
+				comp_ = rhs.comp_;
+				return *this;
+			}
+
+			~RBTree_persistent() {
+				release(root_);
+			}
+
+			bool empty() const { return size_ == 0; }
+			size_type size() const { return size_; }
+			size_type max_size() const { return alloc_node_.max_size(); }
+
+			//↓↓↓ инварианты (для тестов), O(n): корень черный, красные ссылки только левые
+			// и не подряд, черная высота одна на всех путях, ключи по возрастанию, size_ --
+			// число узлов
+			bool verify() const {
+				size_type count = 0;
+				return !is_red(root_) && verify_subtree(root_, 0, 0, count) >= 0 && count == size_;
+			}
+
+			//↓↓↓ для итераторов. Родителей нет: у узла без правого поддерева
+			// следующий ищется от корня -- как upper_bound его значения
+			const value_type& node_value(node_pointer node) const { return node->value_; }
+
+			node_pointer next_node(node_pointer node) const {
+				if (node == 0) {
+					return tree_minimum(root_);
+				}
+				if (node->right_ != 0) {
+					return tree_minimum(node->right_);
+				}
+				return upper_bound_node(node->value_);
+			}
+
+			node_pointer prev_node(node_pointer node) const {
+				if (node == 0) {
+					return tree_maximum(root_);
+				}
+				if (node->left_ != 0) {
+					return tree_maximum(node->left_);
+				}
+				node_pointer curr = root_;
+				node_pointer result = 0;
+				while (curr != 0) {
+					if (comp_(curr->value_, node->value_)) {
+						result = curr;
+						curr = curr->right_;
+					} else {
+						curr = curr->left_;
+					}
+				}
+				return result;
+			}
+
+			iterator end() const { return iterator(this, 0); }
+			iterator begin() const { return iterator(this, tree_minimum(root_)); }
+			reverse_iterator rbegin() const { return reverse_iterator(end()); }
+			reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+			void swap(RBTree_persistent &rhs) {
+				std::swap(root_, rhs.root_);
+				std::swap(comp_, rhs.comp_);
+				std::swap(size_, rhs.size_);
+				ft::swap_allocator(alloc_node_, rhs.alloc_node_);
+				ft::swap_allocator(alloc_val_, rhs.alloc_val_);
+			}
+
+			//↓↓↓ сначала поиск без записи: при попадании ни один узел не копируется
+			ft::pair<iterator, bool> insert_node(const value_type& val) {
+				node_pointer pos = search(val);
+				if (pos != 0) {
+					return ft::pair<iterator, bool>(iterator(this, pos), false);
+				}
+				return ft::pair<iterator, bool>(iterator(this, link_node(create_node(val))), true);
+			}
+
+			//↓↓↓ подсказке не с чем работать: у узлов нет родителей
+			ft::pair<iterator, bool> insert_node(node_pointer, const value_type& val) {
+				return insert_node(val);
+			}
+
+			template<typename InputIterator>
+			void insert_range(InputIterator first, InputIterator last) {
+				for (; first != last; ++first) {
+					insert_node(*first);
+				}
+			}
+
+			template<typename K, typename M>
+			ft::pair<iterator, bool> try_emplace(const K& key, const M& obj) {
+				node_pointer pos = search(key);
+				if (pos != 0) {
+					return ft::pair<iterator, bool>(iterator(this, pos), false);
+				}
+				return ft::pair<iterator, bool>(iterator(this, link_node(create_node(key, obj))), true);
+			}
+
+			//↓↓↓ map::operator[]: значение, в которое можно писать. Найденный узел и путь к нему
+			// становятся собственными, поэтому запись не видна снимкам
+			template<typename K, typename M>
+			value_type& emplace_value(const K& key, const M& obj) {
+				if (search(key) != 0) {
+					return own_path(key)->value_;
+				}
+				return link_node(create_node(key, obj))->value_;
+			}
+
+			template<typename K>
+			bool delete_node(const K& key) {
+				if (search(key) == 0) {
+					return false;
+				}
+				erase_value(key);
+				return true;
+			}
+
+			void erase(iterator position) {
+				erase_value(position.node()->value_);
+			}
+
+			//↓↓↓ удаление меняет узлы на пути, поэтому следующий элемент ищется по значению
+			// до удаления. Его прежний узел остается жив до конца шага: либо он все еще в дереве,
+			// либо его держит другая версия
+			void erase(iterator first, iterator last) {
+				if (first == begin() && last == end()) {
+					clear();
+					return;
+				}
+				size_type n = 0;
+				for (iterator it = first; it != last; ++it) {
+					++n;
+				}
+				node_pointer pos = first.node();
+				while (n-- > 0) {
+					node_pointer next = (n > 0 ? upper_bound_node(pos->value_) : 0);
+					erase_value(pos->value_);
+					pos = next;
+				}
+			}
+
+			void clear() {
+				release(root_);
+				root_ = 0;
+				size_ = 0;
+				ft::release_allocator(alloc_node_);
+			}
+
+			//↓↓↓ поиск по ключу, как RBTree::search
+			template<typename K>
+			node_pointer search(const K& key) const {
+				return search(key, native_three_way());
+			}
+
+			template<typename K>
+			node_pointer search(const K& key, ft::true_type) const {
+				node_pointer node = root_;
+				while (node != 0) {
+					int cmp = three_way::compare(comp_, key, node->value_);
+					if (cmp < 0) {
+						node = node->left_;
+					} else if (cmp > 0) {
+						node = node->right_;
+					} else {
+						return node;
+					}
+				}
+				return node;
+			}
+
+			template<typename K>
+			node_pointer search(const K& key, ft::false_type) const {
+				node_pointer result = lower_bound_node(key);
+				if (result != 0 && comp_(key, result->value_)) {
+					return 0;
+				}
+				return result;
+			}
+
+			value_compare value_comp() const { return comp_; }
+			allocator_type get_allocator() const { return alloc_val_; }
+
+			template<typename K>
+			iterator find(const K& key) const { return iterator(this, search(key)); }
+
+			template<typename K>
+			size_type count(const K& key) const {
+				return (search(key) == 0 ? 0 : 1);
+			}
+
+			template<typename K>
+			node_pointer lower_bound_node(const K& key) const {
+				node_pointer node = root_;
+				node_pointer result = 0;
+				while (node != 0) {
+					if (!comp_(node->value_, key)) {
+						result = node;
+						node = node->left_;
+					} else {
+						node = node->right_;
+					}
+				}
+				return result;
+			}
+
+			template<typename K>
+			node_pointer upper_bound_node(const K& key) const {
+				node_pointer node = root_;
+				node_pointer result = 0;
+				while (node != 0) {
+					if (comp_(key, node->value_)) {
+						result = node;
+						node = node->left_;
+					} else {
+						node = node->right_;
+					}
+				}
+				return result;
+			}
+
+			template<typename K>
+			iterator lower_bound(const K& key) const { return iterator(this, lower_bound_node(key)); }
+			template<typename K>
+			iterator upper_bound(const K& key) const { return iterator(this, upper_bound_node(key)); }
+
+			template<typename K>
+			ft::pair<iterator, iterator> equal_range(const K& key) const {
+				iterator first = lower_bound(key);
+				iterator last = first;
+				if (last.node() != 0 && !comp_(key, *last)) {
+					++last;
+				}
+				return (ft::make_pair(first, last));
+			}
+	}; //tree
+
+	template<typename Value, typename Compare, typename Allocator>
+	struct tree_select<Value, Compare, Allocator, ft::persistent_node_storage, ft::red_black_balance> {
+		typedef RBTree_persistent<Value, Compare, Allocator>	type;
+	};
+
+	template<typename t_Content, typename t_Compare, typename t_Alloc>
+	bool operator<(const RBTree_persistent<t_Content, t_Compare, t_Alloc>& lhs, const RBTree_persistent<t_Content, t_Compare, t_Alloc>& rhs) {
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template<typename t_Content, typename t_Compare, typename t_Alloc>
+	bool operator==(const RBTree_persistent<t_Content, t_Compare, t_Alloc>& lhs, const RBTree_persistent<t_Content, t_Compare, t_Alloc>& rhs) {
+		return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+} // namespace ft
+
+#endif
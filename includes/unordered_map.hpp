@@ -0,0 +1,191 @@
+/*
+// unordered_map -- хеш-таблица с открытой адресацией (tree/hash_table.hpp): поиск по ключу
+// за O(1) в среднем вместо O(log n) сравнений у ft::map, когда порядок ключей не нужен.
+//		ft::unordered_map<K, V>
+//		ft::unordered_map<K, V, MyHash, MyEqual>	// свой хешер: size_t operator()(const K&) const
+// Хешер по умолчанию -- ft::hash (utils/hash.hpp): целые, указатели, std::string.
+// Отличия от std::unordered_map:
+//		- корзин-списков нет, bucket_count() -- число ячеек таблицы, интерфейса корзин нет;
+//		- max_load_factor() фиксирован (7/8);
+//		- вставка с рехешированием делает недействительными все итераторы и ссылки,
+//		  удаление -- только на удаленный элемент.
+// Использованные материалы:
+//		https://abseil.io/about/design/swisstables
+//		https://en.cppreference.com/w/cpp/container/unordered_map
+*/
+
+#ifndef UNORDERED_MAP_HPP
+# define UNORDERED_MAP_HPP
+
+# include <functional>
+# include <memory>
+# include "tree/hash_table.hpp"
+# include "utils/hash.hpp"
+# include "utils/utils.hpp"
+
+namespace ft {
+
+	template<typename Key, typename T, typename Hash = ft::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+			typename Allocator = std::allocator<ft::pair<const Key, T> > >
+	class unordered_map {
+		public:
+// types:
+			typedef Key													key_type;
+			typedef T													mapped_type;
+			typedef ft::pair<const Key, T>								value_type;
+			typedef Hash												hasher;
+			typedef KeyEqual											key_equal;
+			typedef	Allocator											allocator_type;
+
+			typedef typename	Allocator::reference					reference;
+			typedef typename	Allocator::const_reference				const_reference;
+			typedef typename	Allocator::difference_type				difference_type;
+			typedef typename	Allocator::size_type					size_type;
+			typedef typename	Allocator::pointer						pointer;
+			typedef typename	Allocator::const_pointer				const_pointer;
+			typedef ft::HashTable<Key, value_type, ft::select_first<value_type>, Hash, KeyEqual, Allocator>	table_type;
+			typedef typename table_type::iterator						iterator;
+			typedef typename table_type::const_iterator					const_iterator;
+
+		private:
+			table_type		table_;
+
+			//↓↓↓ mapped_type() строится, только когда в таблицу вставляется новый элемент
+			struct default_mapped {
+				operator mapped_type() const { return mapped_type(); }
+			};
+
+// construct/copy/destroy:
+		public:
+			explicit unordered_map(size_type bucket_count = 0, const hasher& hash = hasher(),
+					const key_equal& eq = key_equal(), const allocator_type& alloc = allocator_type()) :
+					table_(hash, eq, alloc) {
+				table_.rehash(bucket_count);
+			}
+
+			template<typename InputIterator>
+			unordered_map(InputIterator first, InputIterator last, size_type bucket_count = 0,
+					const hasher& hash = hasher(), const key_equal& eq = key_equal(),
+					const allocator_type& alloc = allocator_type()) :
+								table_(hash, eq, alloc) {
+				table_.rehash(bucket_count);
+				insert(first, last);
+			}
+
+			unordered_map(const unordered_map& rhs) : table_(rhs.table_) {}
+
+			unordered_map& operator=(const unordered_map& rhs) {
+				table_ = rhs.table_;
+				return *this;
+			}
+
+			~unordered_map() {}
+
+			allocator_type get_allocator() const { return table_.get_allocator(); }
+
+// iterators:
+			iterator begin() { return table_.begin(); }
+			const_iterator begin() const { return table_.begin(); }
+			iterator end() { return table_.end(); }
+			const_iterator end() const { return table_.end(); }
+
+// capacity:
+			bool empty() const { return table_.empty(); }
+			size_type size() const { return table_.size(); }
+			size_type max_size() const { return table_.max_size(); }
+
+// element access:
+			mapped_type& operator[](const key_type& k) {
+				return table_.try_emplace(k, default_mapped()).first->second;
+			}
+
+			pair<iterator, bool> try_emplace(const key_type& k) {
+				return table_.try_emplace(k, default_mapped());
+			}
+
+			pair<iterator, bool> try_emplace(const key_type& k, const mapped_type& obj) {
+				return table_.try_emplace(k, obj);
+			}
+
+// modifiers:
+			pair<iterator, bool> insert(const value_type& x) {
+				return table_.insert_unique(x);
+			}
+
+			//↓↓↓ подсказка не нужна хеш-таблице, перегрузка -- для совместимости с ft::map
+			iterator insert(const_iterator position, const value_type& x) {
+				(void)position;
+				return table_.insert_unique(x).first;
+			}
+
+			template<typename InputIterator>
+			void insert(InputIterator first, InputIterator last) {
+				table_.insert_range(first, last);
+			}
+
+			iterator erase(const_iterator position) {
+				return table_.erase(position);
+			}
+
+			size_type erase(const key_type& x) {
+				return table_.erase_key(x);
+			}
+
+			iterator erase(const_iterator first, const_iterator last) {
+				return table_.erase(first, last);
+			}
+
+			void swap(unordered_map& other) {
+				table_.swap(other.table_);
+			}
+
+			void clear() {
+				table_.clear();
+			}
+
+// lookup:
+			iterator find(const key_type& x) { return table_.find(x); }
+			const_iterator find(const key_type& x) const { return table_.find(x); }
+			size_type count(const key_type& x) const { return table_.count(x); }
+			pair<iterator, iterator> equal_range(const key_type& x) { return table_.equal_range(x); }
+			pair<const_iterator, const_iterator> equal_range(const key_type& x) const { return table_.equal_range(x); }
+
+// hash policy:
+			size_type bucket_count() const { return table_.bucket_count(); }
+			float load_factor() const { return table_.load_factor(); }
+			float max_load_factor() const { return table_.max_load_factor(); }
+			void rehash(size_type count) { table_.rehash(count); }
+			void reserve(size_type count) { table_.reserve(count); }
+
+// observers:
+			hasher hash_function() const { return table_.hash_function(); }
+			key_equal key_eq() const { return table_.key_eq(); }
+
+			//↓↓↓ порядок обхода у равных таблиц может отличаться: каждый элемент ищется в другой
+			friend bool operator==(const unordered_map& lhs, const unordered_map& rhs) {
+				if (lhs.size() != rhs.size()) {
+					return false;
+				}
+				for (const_iterator it = lhs.begin(); it != lhs.end(); ++it) {
+					const_iterator found = rhs.find(it->first);
+					if (found == rhs.end() || !(found->second == it->second)) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			friend bool operator!=(const unordered_map& lhs, const unordered_map& rhs) {
+				return !(lhs == rhs);
+			}
+	}; //unordered_map
+
+// specialized algorithms:
+	template<typename t_Key, typename t_T, typename t_Hash, typename t_Equal, typename t_Alloc>
+	void swap(unordered_map<t_Key, t_T, t_Hash, t_Equal, t_Alloc>& lhs, unordered_map<t_Key, t_T, t_Hash, t_Equal, t_Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+
+} // namespace ft
+
+#endif
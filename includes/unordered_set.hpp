@@ -0,0 +1,163 @@
+/*
+// unordered_set -- хеш-таблица с открытой адресацией (tree/hash_table.hpp): тот же интерфейс,
+// что у ft::unordered_map, но значение -- сам ключ.
+//		ft::unordered_set<K>
+//		ft::unordered_set<K, MyHash, MyEqual>
+// iterator -- константный (как у std::unordered_set): изменение ключа сломало бы таблицу.
+// Отличия от std::unordered_set -- как у unordered_map (unordered_map.hpp).
+// Использованные материалы:
+//		https://abseil.io/about/design/swisstables
+//		https://en.cppreference.com/w/cpp/container/unordered_set
+*/
+
+#ifndef UNORDERED_SET_HPP
+# define UNORDERED_SET_HPP
+
+# include <functional>
+# include <memory>
+# include "tree/hash_table.hpp"
+# include "utils/hash.hpp"
+# include "utils/utils.hpp"
+
+namespace ft {
+
+	template<typename Key, typename Hash = ft::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+			typename Allocator = std::allocator<Key> >
+	class unordered_set {
+		public:
+			typedef				Key										key_type;
+			typedef				Key										value_type;
+			typedef				Hash									hasher;
+			typedef				KeyEqual								key_equal;
+			typedef				Allocator								allocator_type;
+			typedef typename	Allocator::reference					reference;
+			typedef typename	Allocator::const_reference				const_reference;
+			typedef typename	Allocator::difference_type				difference_type;
+			typedef typename	Allocator::size_type					size_type;
+			typedef typename	Allocator::pointer						pointer;
+			typedef typename	Allocator::const_pointer				const_pointer;
+			typedef ft::HashTable<Key, Key, ft::identity<Key>, Hash, KeyEqual, Allocator>	table_type;
+			typedef typename	table_type::const_iterator				iterator;
+			typedef typename	table_type::const_iterator				const_iterator;
+
+		private:
+			table_type table_;
+
+		public:
+// construct/copy/destroy:
+			explicit unordered_set(size_type bucket_count = 0, const hasher& hash = hasher(),
+					const key_equal& eq = key_equal(), const allocator_type& alloc = allocator_type()) :
+				table_(hash, eq, alloc) {
+				table_.rehash(bucket_count);
+			}
+
+			template<typename InputIterator>
+			unordered_set(InputIterator first,
+					InputIterator last,
+					size_type bucket_count = 0,
+					const hasher& hash = hasher(),
+					const key_equal& eq = key_equal(),
+					const allocator_type& alloc = allocator_type()) :
+				table_(hash, eq, alloc) {
+				table_.rehash(bucket_count);
+				insert(first, last);
+			}
+
+			unordered_set(const unordered_set& rhs) : table_(rhs.table_) {}
+
+			unordered_set& operator=(const unordered_set& rhs) {
+				table_ = rhs.table_;
+				return *this;
+			}
+
+			allocator_type get_allocator() const {
+				return table_.get_allocator();
+			}
+
+// iterators:
+			iterator begin() const { return table_.begin(); }
+			iterator end() const { return table_.end(); }
+
+// capacity:
+			bool empty() const { return table_.empty(); }
+			size_type size() const { return table_.size(); }
+			size_type max_size() const { return table_.max_size(); }
+
+// modifiers:
+			ft::pair<iterator, bool> insert(const value_type& x) {
+				return table_.insert_unique(x);
+			}
+
+			//↓↓↓ подсказка не нужна хеш-таблице, перегрузка -- для совместимости с ft::set
+			iterator insert(iterator position, const value_type& x) {
+				(void)position;
+				return table_.insert_unique(x).first;
+			}
+
+			template<typename InputIterator>
+			void insert(InputIterator first, InputIterator last) {
+				table_.insert_range(first, last);
+			}
+
+			iterator erase(iterator position) {
+				return table_.erase(position);
+			}
+
+			size_type erase(const key_type& x) {
+				return table_.erase_key(x);
+			}
+
+			iterator erase(iterator first, iterator last) {
+				return table_.erase(first, last);
+			}
+
+			void swap(unordered_set& rhs) {
+				table_.swap(rhs.table_);
+			}
+
+			void clear() {
+				table_.clear();
+			}
+
+// lookup:
+			iterator find(const key_type& x) const { return table_.find(x); }
+			size_type count(const key_type& x) const { return table_.count(x); }
+			pair<iterator, iterator> equal_range(const key_type& x) const { return table_.equal_range(x); }
+
+// hash policy:
+			size_type bucket_count() const { return table_.bucket_count(); }
+			float load_factor() const { return table_.load_factor(); }
+			float max_load_factor() const { return table_.max_load_factor(); }
+			void rehash(size_type count) { table_.rehash(count); }
+			void reserve(size_type count) { table_.reserve(count); }
+
+// observers:
+			hasher hash_function() const { return table_.hash_function(); }
+			key_equal key_eq() const { return table_.key_eq(); }
+
+			friend bool operator==(const unordered_set& lhs, const unordered_set& rhs) {
+				if (lhs.size() != rhs.size()) {
+					return false;
+				}
+				for (iterator it = lhs.begin(); it != lhs.end(); ++it) {
+					if (rhs.find(*it) == rhs.end()) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			friend bool operator!=(const unordered_set& lhs, const unordered_set& rhs) {
+				return !(lhs == rhs);
+			}
+	}; //unordered_set
+
+// specialized algorithms:
+	template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+	void swap(ft::unordered_set<Key, Hash, KeyEqual, Alloc>& lhs, ft::unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+		lhs.swap(rhs);
+	}
+
+} // namespace ft
+
+#endif
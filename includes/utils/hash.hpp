@@ -0,0 +1,57 @@
+#ifndef HASH_HPP
+# define HASH_HPP
+
+# include <cstddef>
+# include <string>
+
+//https://en.cppreference.com/w/cpp/utility/hash
+//http://www.isthe.com/chongo/tech/comp/fnv/index.html
+
+namespace ft {
+
+	//↓↓↓ хешер по умолчанию для ft::unordered_map / ft::unordered_set (в C++98 нет std::hash).
+	// Целые и указатели хешируются сами в себя, как в libstdc++: таблица (tree/hash_table.hpp)
+	// все равно перемешивает результат, поэтому свой hasher тоже может быть простым
+	template<typename T>
+	struct hash;
+
+	template<typename T>
+	struct hash<T*> {
+		std::size_t operator()(T* p) const { return reinterpret_cast<std::size_t>(p); }
+	};
+
+	template<typename T>
+	struct hash_integral {
+		std::size_t operator()(T x) const { return static_cast<std::size_t>(x); }
+	};
+
+	template <> struct hash<bool> : public hash_integral<bool> {};
+	template <> struct hash<char> : public hash_integral<char> {};
+	template <> struct hash<signed char> : public hash_integral<signed char> {};
+	template <> struct hash<unsigned char> : public hash_integral<unsigned char> {};
+	template <> struct hash<wchar_t> : public hash_integral<wchar_t> {};
+	template <> struct hash<short> : public hash_integral<short> {};
+	template <> struct hash<unsigned short> : public hash_integral<unsigned short> {};
+	template <> struct hash<int> : public hash_integral<int> {};
+	template <> struct hash<unsigned int> : public hash_integral<unsigned int> {};
+	template <> struct hash<long> : public hash_integral<long> {};
+	template <> struct hash<unsigned long> : public hash_integral<unsigned long> {};
+
+	//↓↓↓ FNV-1a по байтам строки
+	inline std::size_t hash_bytes(const char* p, std::size_t n) {
+		std::size_t h = static_cast<std::size_t>(14695981039346656037ULL);
+		for (std::size_t i = 0; i < n; ++i) {
+			h ^= static_cast<unsigned char>(p[i]);
+			h *= static_cast<std::size_t>(1099511628211ULL);
+		}
+		return h;
+	}
+
+	template<>
+	struct hash<std::string> {
+		std::size_t operator()(const std::string& s) const { return hash_bytes(s.data(), s.size()); }
+	};
+
+} // namespace ft
+
+#endif
@@ -2,6 +2,7 @@
 # define IS_ITER_HPP
 
 # include "utils.hpp"
+# include "../iterators/RBTree_iterator.hpp"
 
 namespace ft {
 
@@ -0,0 +1,48 @@
+#ifndef LESS_HPP
+# define LESS_HPP
+
+# include <functional>
+# include "enableif.hpp"
+
+//https://en.cppreference.com/w/cpp/utility/functional/less_void
+//https://en.cppreference.com/w/cpp/container/map/find
+
+namespace ft {
+
+	template<typename T = void>
+	struct less : public std::binary_function<T, T, bool> {
+		bool operator()(const T& x, const T& y) const { return x < y; }
+	};
+
+	//↓↓↓ прозрачный компаратор: сравнивает аргументы разных типов без приведения,
+	// например std::string с const char*, поэтому поиск не создает временный ключ
+	template<>
+	struct less<void> {
+		typedef void is_transparent;
+
+		template<typename T, typename U>
+		bool operator()(const T& x, const U& y) const { return x < y; }
+	};
+
+	//↓↓↓ true, если у компаратора есть вложенный тип is_transparent
+	template<typename Compare>
+	struct is_transparent {
+		private:
+			typedef char	yes;
+			struct no { char c[2]; };
+
+			template<typename U> static yes test(typename U::is_transparent*);
+			template<typename U> static no test(...);
+
+		public:
+			static const bool value = (sizeof(test<Compare>(0)) == sizeof(yes));
+	};
+
+	//↓↓↓ R, если Compare прозрачный. K нужен только для того, чтобы условие зависело
+	// от параметра шаблона функции и неподходящая перегрузка отбрасывалась (SFINAE)
+	template<typename Compare, typename K, typename R>
+	struct enable_if_transparent : public ft::enable_if<is_transparent<Compare>::value, R> {};
+
+} // namespace ft
+
+#endif
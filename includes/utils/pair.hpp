@@ -2,6 +2,17 @@
 # define PAIR_HPP
 
 namespace ft {
+	//↓↓↓ ключ и значение по ссылке: pair(pair_ref) строит каждое поле прямо из аргумента.
+	// Значение, приводимое к типу поля (default_mapped у map), конструируется один раз,
+	// без временного объекта и его копии
+	template<typename T1, typename T2>
+	struct pair_ref {
+		const T1&	first;
+		const T2&	second;
+
+		pair_ref(const T1& f, const T2& s): first(f), second(s) {}
+	};
+
 	template <typename key, typename value>
 	struct pair {
 		typedef key		firsttype;
@@ -16,6 +27,9 @@ namespace ft {
 
 		template<typename U, typename V>
 		pair (const pair<U, V>& p) : first(p.first), second(p.second) {}
+
+		template<typename U, typename V>
+		pair(const pair_ref<U, V>& p) : first(p.first), second(p.second) {}
 	
 		pair& operator=(const pair& p) {
 			if (this == &p) {
@@ -0,0 +1,300 @@
+/*
+// pool_allocator -- аллокатор узлов для контейнеров (параметр шаблона Allocator).
+// Узлы нарезаются из больших блоков (slab), освобожденные узлы уходят в интрузивный
+// список свободных и переиспользуются без malloc/free. Блоки возвращаются системе целиком:
+// при clear() контейнера, если живых узлов не осталось, и когда пул разрушает последний
+// аллокатор, который на него ссылается.
+//		ft::map<K, V, std::less<K>, ft::pool_allocator<ft::pair<const K, V> > >
+// Пул -- общий у аллокатора, его копий и rebind (счетчик ссылок), присваивание
+// переводит аллокатор на пул источника. Аллокаторы равны, когда у них один пул: тогда
+// память, выделенная одним, освобождается другим, и копии контейнера, node handle и
+// merge работают как с std::allocator. Внутри пула свой список свободных для каждого
+// размера узла, поэтому rebind на узлы разного размера не мешают друг другу.
+// Пул не потокобезопасен -- как и сам контейнер: копии аллокатора (и контейнеры с ними)
+// нельзя использовать из разных потоков одновременно.
+// Использованные материалы:
+//		https://en.cppreference.com/w/cpp/named_req/Allocator
+//		https://en.wikipedia.org/wiki/Slab_allocation
+*/
+
+#ifndef POOL_ALLOCATOR_HPP
+# define POOL_ALLOCATOR_HPP
+
+# include <cstddef>
+# include <new>
+# include <memory>
+# include <algorithm>
+
+namespace ft {
+
+	//↓↓↓ память пула: по одной корзине на размер узла, корзина -- блоки и список свободных.
+	// Разрушается вместе с последним pool_allocator, который на нее ссылается
+	class pool_resource {
+		private:
+			//↓↓↓ заголовок блока; узлы лежат сразу за ним, выравнивание как у operator new
+			union slab {
+				slab*			next_;
+				long double		align_;
+			};
+
+			struct free_node {
+				free_node*		next_;
+			};
+
+			//↓↓↓ блоки растут вдвое от first_slab до max_slab узлов
+			enum { first_slab = 16, max_slab = 4096 };
+
+		public:
+			struct bucket {
+				bucket*			next_;
+				std::size_t		stride_;
+				slab*			slabs_;
+				free_node*		free_;
+				std::size_t		live_;
+				std::size_t		next_slab_;
+			};
+
+		private:
+			bucket*			buckets_;
+			std::size_t		refs_;
+
+			pool_resource(const pool_resource&);
+			pool_resource& operator=(const pool_resource&);
+
+		public:
+			pool_resource() : buckets_(0), refs_(1) {}
+
+			~pool_resource() {
+				while (buckets_ != 0) {
+					bucket* next = buckets_->next_;
+					free_slabs(buckets_);
+					delete buckets_;
+					buckets_ = next;
+				}
+			}
+
+			void retain() { ++refs_; }
+
+			//↓↓↓ true -- ссылок не осталось, пул нужно удалить
+			bool drop() { return --refs_ == 0; }
+
+			static std::size_t stride(std::size_t size) {
+				return (size < sizeof(free_node) ? sizeof(free_node) : size);
+			}
+
+			//↓↓↓ корзина узлов размера stride; 0 -- такие узлы еще не выделялись
+			bucket* find(std::size_t stride) const {
+				bucket* b = buckets_;
+				while (b != 0 && b->stride_ != stride) {
+					b = b->next_;
+				}
+				return b;
+			}
+
+			bucket* get(std::size_t stride) {
+				bucket* b = find(stride);
+				if (b == 0) {
+					b = new bucket;
+					b->next_ = buckets_;
+					b->stride_ = stride;
+					b->slabs_ = 0;
+					b->free_ = 0;
+					b->live_ = 0;
+					b->next_slab_ = first_slab;
+					buckets_ = b;
+				}
+				return b;
+			}
+
+			static void* allocate(bucket* b) {
+				if (b->free_ == 0) {
+					grow(b);
+				}
+				free_node* node = b->free_;
+				b->free_ = node->next_;
+				++b->live_;
+				return node;
+			}
+
+			static void deallocate(bucket* b, void* p) {
+				free_node* node = static_cast<free_node*>(p);
+				node->next_ = b->free_;
+				b->free_ = node;
+				--b->live_;
+			}
+
+			//↓↓↓ возвращает блоки корзины системе, если ни один ее узел не занят
+			static void release(bucket* b) {
+				if (b->live_ == 0) {
+					free_slabs(b);
+				}
+			}
+
+		private:
+			static void grow(bucket* b) {
+				std::size_t count = b->next_slab_;
+				slab* block = static_cast<slab*>(::operator new(sizeof(slab) + count * b->stride_));
+				block->next_ = b->slabs_;
+				b->slabs_ = block;
+				char* first = reinterpret_cast<char*>(block + 1);
+				for (std::size_t i = count; i > 0; --i) {
+					free_node* node = reinterpret_cast<free_node*>(first + (i - 1) * b->stride_);
+					node->next_ = b->free_;
+					b->free_ = node;
+				}
+				if (b->next_slab_ < max_slab) {
+					b->next_slab_ *= 2;
+				}
+			}
+
+			static void free_slabs(bucket* b) {
+				while (b->slabs_ != 0) {
+					slab* next = b->slabs_->next_;
+					::operator delete(b->slabs_);
+					b->slabs_ = next;
+				}
+				b->free_ = 0;
+				b->next_slab_ = first_slab;
+			}
+	};
+
+	template<typename T>
+	class pool_allocator {
+		public:
+			typedef T					value_type;
+			typedef T*					pointer;
+			typedef const T*			const_pointer;
+			typedef T&					reference;
+			typedef const T&			const_reference;
+			typedef std::size_t			size_type;
+			typedef std::ptrdiff_t		difference_type;
+
+			template<typename U>
+			struct rebind { typedef pool_allocator<U> other; };
+
+		private:
+			pool_resource*				pool_;
+			//↓↓↓ корзина для sizeof(T), находится при первом allocate
+			pool_resource::bucket*		bucket_;
+
+			pool_resource::bucket* bucket() {
+				if (bucket_ == 0) {
+					bucket_ = pool_->get(pool_resource::stride(sizeof(T)));
+				}
+				return bucket_;
+			}
+
+		public:
+			pool_allocator() : pool_(new pool_resource), bucket_(0) {}
+
+			pool_allocator(const pool_allocator& rhs) throw() : pool_(rhs.pool_), bucket_(rhs.bucket_) {
+				pool_->retain();
+			}
+
+			template<typename U>
+			pool_allocator(const pool_allocator<U>& rhs) throw() : pool_(rhs.resource()), bucket_(0) {
+				pool_->retain();
+			}
+
+			pool_allocator& operator=(const pool_allocator& rhs) {
+				rhs.pool_->retain();
+				if (pool_->drop()) {
+					delete pool_;
+				}
+				pool_ = rhs.pool_;
+				bucket_ = rhs.bucket_;
+				return *this;
+			}
+
+			~pool_allocator() {
+				if (pool_->drop()) {
+					delete pool_;
+				}
+			}
+
+			pointer address(reference x) const { return &x; }
+			const_pointer address(const_reference x) const { return &x; }
+
+			size_type max_size() const throw() {
+				return static_cast<size_type>(-1) / sizeof(T);
+			}
+
+			//↓↓↓ из пула -- только одиночные объекты, массивы идут мимо него
+			pointer allocate(size_type n, const void* = 0) {
+				if (n != 1) {
+					return static_cast<pointer>(::operator new(n * sizeof(T)));
+				}
+				return static_cast<pointer>(pool_resource::allocate(bucket()));
+			}
+
+			void deallocate(pointer p, size_type n) {
+				if (n != 1) {
+					::operator delete(p);
+					return ;
+				}
+				pool_resource::deallocate(bucket(), p);
+			}
+
+			void construct(pointer p, const T& val) {
+				::new (static_cast<void*>(p)) T(val);
+			}
+
+			void destroy(pointer p) {
+				p->~T();
+			}
+
+			//↓↓↓ возвращает блоки узлов размера T системе, если ни один такой узел
+			// в пуле не занят (ни этим аллокатором, ни его копиями)
+			void release() {
+				pool_resource::bucket* b = pool_->find(pool_resource::stride(sizeof(T)));
+				if (b != 0) {
+					pool_resource::release(b);
+				}
+			}
+
+			void swap(pool_allocator& rhs) {
+				std::swap(pool_, rhs.pool_);
+				std::swap(bucket_, rhs.bucket_);
+			}
+
+			//↓↓↓ занятых узлов размера T во всем пуле
+			size_type live() const {
+				pool_resource::bucket* b = pool_->find(pool_resource::stride(sizeof(T)));
+				return (b != 0 ? b->live_ : 0);
+			}
+
+			pool_resource* resource() const { return pool_; }
+
+			template<typename U>
+			bool operator==(const pool_allocator<U>& rhs) const {
+				return pool_ == rhs.resource();
+			}
+
+			template<typename U>
+			bool operator!=(const pool_allocator<U>& rhs) const {
+				return !(*this == rhs);
+			}
+	};
+
+	//↓↓↓ точки расширения для контейнеров: для обычных аллокаторов -- ничего особенного
+	template<typename Allocator>
+	inline void release_allocator(Allocator&) {}
+
+	template<typename T>
+	inline void release_allocator(pool_allocator<T>& alloc) {
+		alloc.release();
+	}
+
+	template<typename Allocator>
+	inline void swap_allocator(Allocator& lhs, Allocator& rhs) {
+		std::swap(lhs, rhs);
+	}
+
+	template<typename T>
+	inline void swap_allocator(pool_allocator<T>& lhs, pool_allocator<T>& rhs) {
+		lhs.swap(rhs);
+	}
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef PREFETCH_HPP
+# define PREFETCH_HPP
+
+//https://gcc.gnu.org/onlinedocs/gcc/Other-Builtins.html#index-_005f_005fbuiltin_005fprefetch
+
+namespace ft {
+
+	//↓↓↓ подсказка процессору заранее загрузить строку кэша с addr для чтения.
+	// Не меняет поведения программы; без GCC/Clang -- пустая функция
+	inline void prefetch(const void* addr) {
+#if defined(__GNUC__)
+		__builtin_prefetch(addr, 0, 3);
+#else
+		(void)addr;
+#endif
+	}
+
+} //namespace ft
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef SELECT_HPP
+# define SELECT_HPP
+
+//https://gcc.gnu.org/onlinedocs/libstdc++/libstdc++-html-USERS-4.4/a01584.html
+
+namespace ft {
+
+	//↓↓↓ KeyOfValue контейнеров, которые хранят ключи отдельно от сравнения значений
+	// (tree/btree.hpp, tree/flat_tree.hpp): у set ключ -- само значение, у map -- first
+	template<typename T>
+	struct identity {
+		const T& operator()(const T& x) const { return x; }
+	};
+
+	template<typename Pair>
+	struct select_first {
+		const typename Pair::firsttype& operator()(const Pair& x) const { return x.first; }
+	};
+
+} // namespace ft
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef THREE_WAY_HPP
+# define THREE_WAY_HPP
+
+# include <functional>
+# include <string>
+# include "enableif.hpp"
+# include "is_integral.hpp"
+# include "less.hpp"
+
+//https://en.cppreference.com/w/cpp/string/basic_string/compare
+//https://en.cppreference.com/w/cpp/language/default_comparisons
+
+namespace ft {
+
+	//↓↓↓ трехстороннее сравнение для спусков по дереву: compare(comp, x, y) < 0, если x < y,
+	// 0 -- если равны, > 0 -- если x > y. native == true, когда ответ дает одно сравнение;
+	// иначе дерево спускается с одним вызовом comp на уровень, как lower_bound.
+	// Свой компаратор подключается специализацией three_way_compare<Compare, Key>.
+	template<typename Compare, typename Key, typename Enable = void>
+	struct three_way_compare {
+		static const bool native = false;
+
+		//↓↓↓ адаптер поверх less-подобного компаратора: до двух вызовов comp
+		template<typename T, typename U>
+		static int compare(const Compare& comp, const T& x, const U& y) {
+			if (comp(x, y)) {
+				return -1;
+			}
+			if (comp(y, x)) {
+				return 1;
+			}
+			return 0;
+		}
+	};
+
+	template<typename Key>
+	struct integral_three_way {
+		static const bool native = true;
+
+		template<typename Compare>
+		static int compare(const Compare&, const Key& x, const Key& y) {
+			return static_cast<int>(y < x) - static_cast<int>(x < y);
+		}
+	};
+
+	//↓↓↓ std::string::compare проходит общий префикс один раз, а x < y и y < x -- дважды
+	struct string_three_way {
+		static const bool native = true;
+
+		template<typename Compare>
+		static int compare(const Compare&, const std::string& x, const std::string& y) {
+			return x.compare(y);
+		}
+	};
+
+	template<typename Key>
+	struct three_way_compare<std::less<Key>, Key, typename ft::enable_if<ft::is_integral<Key>::value>::type>
+			: public integral_three_way<Key> {};
+
+	template<typename Key>
+	struct three_way_compare<ft::less<Key>, Key, typename ft::enable_if<ft::is_integral<Key>::value>::type>
+			: public integral_three_way<Key> {};
+
+	template<>
+	struct three_way_compare<std::less<std::string>, std::string> : public string_three_way {};
+
+	template<>
+	struct three_way_compare<ft::less<std::string>, std::string> : public string_three_way {};
+
+	//↓↓↓ true, если у компаратора есть вложенный тип key_three_way (см. map::value_compare)
+	template<typename Compare>
+	struct has_key_three_way {
+		private:
+			typedef char	yes;
+			struct no { char c[2]; };
+
+			template<typename U> static yes test(typename U::key_three_way*);
+			template<typename U> static no test(...);
+
+		public:
+			static const bool value = (sizeof(test<Compare>(0)) == sizeof(yes));
+	};
+
+	//↓↓↓ компаратор элементов, который сам сравнивает по ключу (map::value_compare):
+	// сравнение делегируется его three_way, а native берется у трейта ключа
+	template<typename Compare, typename Value>
+	struct three_way_compare<Compare, Value, typename ft::enable_if<has_key_three_way<Compare>::value>::type> {
+		static const bool native = Compare::key_three_way::native;
+
+		template<typename T, typename U>
+		static int compare(const Compare& comp, const T& x, const U& y) {
+			return comp.three_way(x, y);
+		}
+	};
+
+} // namespace ft
+
+#endif
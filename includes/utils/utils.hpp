@@ -10,7 +10,11 @@
 # include "is_integral.hpp"
 # include "is_iter.hpp"
 # include "lexicographical_cmp.hpp"
+# include "less.hpp"
 # include "nullptr.hpp"
 # include "pair.hpp"
+# include "prefetch.hpp"
+# include "select.hpp"
+# include "three_way.hpp"
 
 #endif
\ No newline at end of file
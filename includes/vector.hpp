@@ -16,6 +16,8 @@
 #ifndef VECTOR_HPP
 # define VECTOR_HPP
 
+# include <memory>
+# include <stdexcept>
 # include "utils/utils.hpp"
 
 namespace ft {
@@ -100,7 +102,7 @@ namespace ft {
 			}
 
 			vector &operator=(const vector& rhs) {
-				if (*this == rhs) {
+				if (this == &rhs) {
 					return *this;
 				}
 				if (rhs.ptr_start_ > rhs.ptr_end_) {
@@ -162,7 +164,7 @@ namespace ft {
 			reverse_iterator rbegin() { return reverse_iterator(end()); }
 			const_reverse_iterator rbegin() const {return const_reverse_iterator(end()); }
 			reverse_iterator rend() { return reverse_iterator(begin()); }
-			const_reverse_iterator rend() const { return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
 
 // capacity:
 			size_type size() const { return (ptr_for_data_ - ptr_start_); }
@@ -259,8 +261,10 @@ namespace ft {
 				alloc_.destroy(--ptr_for_data_);
 			}
 
+			//↓↓↓ элементы сдвигаются конструированием копии и разрушением оригинала, без присваивания:
+			// так работают и типы с константными полями (ft::pair<const Key, T> у flat_map)
 			iterator insert(iterator position, const value_type& x) {
-				pointer pos = &(*position);
+				pointer pos = position.base();
 				if (capacity() == 0) {
 					ptr_start_ = alloc_.allocate(1);
 					ptr_end_ = ptr_start_ + 1;
@@ -268,13 +272,15 @@ namespace ft {
 					alloc_.construct(ptr_for_data_++, x);
 					return iterator(ptr_start_);
 				} else if (capacity() >= size() + 1) {
+					value_type copy(x);
 					pointer tmp = ptr_for_data_;
 					while (pos != tmp--) {
 						alloc_.construct(tmp + 1, *tmp);
+						alloc_.destroy(tmp);
 					}
-					alloc_.construct(tmp, x);
+					alloc_.construct(pos, copy);
 					ptr_for_data_++;
-					return iterator(tmp);
+					return iterator(pos);
 				} else {
 					difference_type n = pos - ptr_start_;
 					pointer prev_start = ptr_start_;
@@ -282,13 +288,14 @@ namespace ft {
 					pointer prev_end = ptr_for_data_;
 					size_type prev_capacity = capacity();
 					ptr_start_ = alloc_.allocate(prev_capacity * 2);
-					ptr_end_ = ptr_start_ = ptr_start_ + (prev_capacity * 2);
+					ptr_end_ = ptr_start_ + (prev_capacity * 2);
 					ptr_for_data_ = ptr_start_;
+					alloc_.construct(ptr_start_ + n, x);
 					while (prev_start != pos) {
 						alloc_.construct(ptr_for_data_++, *prev_start);
 						alloc_.destroy(prev_start++);
 					}
-					alloc_.construct(ptr_for_data_++, x);
+					++ptr_for_data_;
 					while (prev_start != prev_end) {
 						alloc_.construct(ptr_for_data_++, *prev_start);
 						alloc_.destroy(prev_start++);
@@ -299,7 +306,7 @@ namespace ft {
 			}
 
 			void insert(iterator position, size_type n, const value_type& x) {
-				pointer pos = &(*position);
+				pointer pos = position.base();
 				if (n == 0) {
 					return ;
 				}
@@ -350,7 +357,7 @@ namespace ft {
 				if (first > last || position < begin() || position > end()) {
 					throw std::logic_error("vector");
 				}
-				pointer pos = &(*position);
+				pointer pos = position.base();
 				difference_type n = ft::distance(first, last);
 				if (n == 0) {
 					return ;
@@ -397,12 +404,13 @@ namespace ft {
 			}
 
 			iterator erase(iterator position) {
-				pointer pos = &(*position);
+				pointer pos = position.base();
 				alloc_.destroy(pos);
 				for (; pos != ptr_for_data_ - 1; ++pos) {
 					alloc_.construct(pos, *(pos + 1));
+					alloc_.destroy(pos + 1);
 				}
-				alloc_.destroy(--ptr_for_data_);
+				--ptr_for_data_;
 				return position;
 			}
 
@@ -410,15 +418,19 @@ namespace ft {
 				if (first > last) {
 					std::length_error("vector");
 				}
-				pointer ptr_first = &(*first);
-				pointer ptr_last = &(*last);
+				if (first == last) {
+					return first;
+				}
+				pointer ptr_first = first.base();
+				pointer ptr_last = last.base();
 				pointer tmp  = ptr_first;
 				while (tmp != ptr_last) {
 					alloc_.destroy(tmp++);
 				}
 				tmp = ptr_first;
 				while (ptr_last != ptr_for_data_) {
-					alloc_.construct(tmp++, *ptr_last++);
+					alloc_.construct(tmp++, *ptr_last);
+					alloc_.destroy(ptr_last++);
 				}
 				ptr_for_data_ = tmp;
 				return first;
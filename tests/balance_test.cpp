@@ -0,0 +1,125 @@
+/*
+// Политики балансировки ft::map: red_black_balance, avl_balance и splay_balance с каждой
+// политикой узлов (обычной, order statistic, прошитой). Вставка с подсказкой и без,
+// operator[], удаление по ключу, итератору и диапазону, lower/upper_bound сверяются
+// с std::map, после каждого шага -- verify(). У splay поиск перестраивает дерево:
+// итераторы после него остаются валидными, а поиск в const map дерево не меняет.
+*/
+
+#include <functional>
+#include <map>
+#include <vector>
+#include "map.hpp"
+#include "test.hpp"
+
+template<typename NodeUpdate, typename Balance>
+struct balanced_map {
+	typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, NodeUpdate, Balance>	type;
+};
+
+typedef balanced_map<ft::threaded_node_update, ft::splay_balance>::type		splay_map;
+
+template<typename Balance>
+static void test_policies(unsigned long long seed) {
+	test::random_rounds<typename balanced_map<ft::null_node_update, Balance>::type>(seed, 20, 1500, 2000, test::tree_ops());
+	test::random_rounds<typename balanced_map<ft::order_statistic_node_update, Balance>::type>(seed + 1, 20, 1500, 2000, test::tree_ops());
+	test::random_rounds<typename balanced_map<ft::threaded_node_update, Balance>::type>(seed + 2, 20, 1500, 2000, test::tree_ops());
+	//↓↓↓ узкий диапазон ключей: дерево часто пустеет и заполняется снова
+	test::random_rounds<typename balanced_map<ft::null_node_update, Balance>::type>(seed + 3, 60, 30, 400, test::tree_ops());
+}
+
+//↓↓↓ возрастающая вставка превращает splay-дерево в цепочку; поиск в ее конце, удаление
+// и вставка в середину идут без рекурсии и не ломают порядок
+template<typename Map>
+static void test_chain() {
+	Map m;
+	test::reference_map ref;
+	for (int i = 0; i < 20000; ++i) {
+		m.insert(m.end(), ft::make_pair(i, i));
+		ref[i] = i;
+	}
+	CHECK(m.verify() && m.find(0)->second == 0 && m.verify());
+	m.erase(m.find(19999));
+	ref.erase(19999);
+	m[10000] = -1;
+	ref[10000] = -1;
+	CHECK(m.lower_bound(10000)->second == -1 && m.verify() && test::same(m, ref));
+	Map copy(m);
+	CHECK(copy.verify() && test::same(copy, ref));
+}
+
+//↓↓↓ поиск в splay-дереве поднимает узел в корень поворотами: значения не переезжают,
+// итераторы на все элементы остаются валидными и шагают в прежнем порядке
+static void test_splay_iterators() {
+	test::Random rnd(21);
+	splay_map m;
+	for (int i = 0; i < 2000; ++i) {
+		m[rnd.next_int(5000)] = i;
+	}
+	std::vector<splay_map::iterator> its;
+	std::vector<int> keys;
+	for (splay_map::iterator it = m.begin(); it != m.end(); ++it) {
+		its.push_back(it);
+		keys.push_back(it->first);
+	}
+	for (int i = 0; i < 5000; ++i) {
+		int key = rnd.next_int(5000);
+		switch (rnd.next_int(4)) {
+			case 0:
+				m.find(key);
+				break;
+			case 1:
+				m.lower_bound(key);
+				break;
+			case 2:
+				m.try_emplace(keys[static_cast<std::size_t>(key) % keys.size()], 0);
+				break;
+			default:
+				m.insert(ft::make_pair(keys[static_cast<std::size_t>(key) % keys.size()], 0));
+				break;
+		}
+	}
+	CHECK(m.verify() && m.size() == keys.size());
+	for (std::size_t i = 0; i < its.size(); ++i) {
+		splay_map::iterator next = its[i];
+		++next;
+		CHECK(its[i]->first == keys[i] && (i + 1 == its.size() ? next == m.end() : next == its[i + 1]));
+	}
+}
+
+//↓↓↓ const map не перестраивается: обход идет параллельно с поиском и границами, и каждый
+// поиск совпадает с std::map
+static void test_splay_const() {
+	test::Random rnd(22);
+	splay_map m;
+	test::reference_map ref;
+	for (int i = 0; i < 3000; ++i) {
+		int key = rnd.next_int(6000);
+		m[key] = i;
+		ref[key] = i;
+	}
+	const splay_map& cm = m;
+	test::reference_map::const_iterator r = ref.begin();
+	for (splay_map::const_iterator it = cm.begin(); it != cm.end(); ++it, ++r) {
+		CHECK(it->first == r->first);
+		int key = rnd.next_int(6000);
+		splay_map::const_iterator found = cm.find(key);
+		CHECK(ref.count(key) ? (found != cm.end() && found->second == ref[key]) : found == cm.end());
+		CHECK(test::same_position(cm, cm.lower_bound(key), ref, ref.lower_bound(key)));
+		CHECK(test::same_position(cm, cm.upper_bound(key), ref, ref.upper_bound(key)));
+		CHECK(cm.count(key) == ref.count(key) && cm.equal_range(key).first == cm.lower_bound(key));
+	}
+	CHECK(r == ref.end() && cm.verify() && test::same(cm, ref));
+}
+
+int main() {
+	test_policies<ft::red_black_balance>(1);
+	test_policies<ft::avl_balance>(11);
+	test_policies<ft::splay_balance>(21);
+	test_chain<balanced_map<ft::null_node_update, ft::splay_balance>::type>();
+	test_chain<splay_map>();
+	test_chain<balanced_map<ft::order_statistic_node_update, ft::avl_balance>::type>();
+	test_splay_iterators();
+	test_splay_const();
+	return test::report("balance");
+}
@@ -0,0 +1,86 @@
+/*
+// ft::btree_map и ft::btree_set: вставка (с подсказкой и без), operator[], удаление
+// по ключу, итератору и диапазону, lower/upper_bound сверяются с std::map; обход в прямом
+// и обратном порядке; поиск с прозрачным ft::less<>; копирование, присваивание, swap и
+// вставка в копию с ft::pool_allocator. Маленькие NodeBytes дают много уровней и частые
+// разбиения и слияния узлов.
+*/
+
+#include <cstdio>
+#include <functional>
+#include <set>
+#include <string>
+#include "btree_map.hpp"
+#include "btree_set.hpp"
+#include "utils/less.hpp"
+#include "utils/pool_allocator.hpp"
+#include "test.hpp"
+
+typedef ft::btree_map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> >, 64>	pool_map;
+
+//↓↓↓ последовательная вставка с подсказкой в конец и в начало -- основной сценарий hint
+static void test_sequential() {
+	ft::btree_map<int, int> up;
+	ft::btree_map<int, int> down;
+	for (int i = 0; i < 20000; ++i) {
+		up.insert(up.end(), ft::make_pair(i, i));
+		down.insert(down.begin(), ft::make_pair(20000 - i, i));
+	}
+	CHECK(up.size() == 20000 && down.size() == 20000);
+	int expected = 0;
+	for (ft::btree_map<int, int>::iterator it = up.begin(); it != up.end(); ++it, ++expected) {
+		CHECK(it->first == expected);
+	}
+	expected = 20000;
+	for (ft::btree_map<int, int>::reverse_iterator it = down.rbegin(); it != down.rend(); ++it, --expected) {
+		CHECK(it->first == expected);
+	}
+	//↓↓↓ удаление с краев: листья сливаются и дерево теряет уровни до пустого
+	while (!up.empty()) {
+		up.erase(up.begin());
+		down.erase(--down.end());
+	}
+	CHECK(down.empty() && up.begin() == up.end() && down.begin() == down.end());
+}
+
+static void test_transparent() {
+	ft::btree_map<std::string, int, ft::less<> > m;
+	ft::btree_set<std::string, ft::less<> > s;
+	char key[16];
+	for (int i = 0; i < 1000; ++i) {
+		std::sprintf(key, "k%04d", i);
+		m[key] = i;
+		s.insert(key);
+	}
+	CHECK(m.find("k0500")->second == 500 && m.find("x") == m.end());
+	CHECK(m.count("k0999") == 1 && m.lower_bound("k05")->first == "k0500");
+	CHECK(m.upper_bound("k0500")->first == "k0501");
+	CHECK(s.count("k0001") == 1 && s.lower_bound("k1") == s.end() && *s.find("k0042") == "k0042");
+	CHECK(m.equal_range("k0007").first->second == 7);
+}
+
+static void test_set() {
+	test::Random rnd(5);
+	ft::btree_set<int, std::less<int>, std::allocator<int>, 48> s;
+	std::set<int> ref;
+	for (int i = 0; i < 30000; ++i) {
+		int key = rnd.next_int(5000);
+		if (rnd.next_int(3)) {
+			CHECK(s.insert(key).second == ref.insert(key).second);
+		} else {
+			CHECK(s.erase(key) == ref.erase(key));
+		}
+	}
+	CHECK(test::same(s, ref));
+}
+
+int main() {
+	test::random_rounds<ft::btree_map<int, int> >(1, 30, 3000, 5000, test::ordered_ops());
+	test::random_rounds<ft::btree_map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, 64> >(2, 30, 3000, 5000, test::ordered_ops());
+	test::random_rounds<ft::btree_map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> >, 96> >(3, 30, 3000, 5000, test::ordered_ops());
+	test_sequential();
+	test_transparent();
+	test_set();
+	test::pool_copies<pool_map>();
+	return test::report("btree");
+}
@@ -0,0 +1,129 @@
+/*
+// Вставка диапазона в ft::map и ft::set (RBTree::insert_range): пустой диапазон,
+// строго возрастающий диапазон любой длины (сборка за O(n)), возрастающий с повторами
+// (остается первое значение), возрастающий префикс с неупорядоченным хвостом (хвост идет
+// через вставку с подсказкой), диапазон в непустое дерево. После каждой вставки --
+// verify(): проверяются не только элементы, но и цвета или показатели баланса сборки.
+*/
+
+#include <functional>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include "map.hpp"
+#include "set.hpp"
+#include "test.hpp"
+
+typedef std::vector<ft::pair<int, int> >	source;
+
+//↓↓↓ значение -- номер в диапазоне: по нему видно, какой из повторов остался
+static source sorted(int n, int step, int first) {
+	source s;
+	for (int i = 0; i < n; ++i) {
+		s.push_back(ft::make_pair(first + i * step, static_cast<int>(s.size())));
+	}
+	return s;
+}
+
+template<typename Map>
+static bool built(const Map& m, const source& s, test::reference_map ref) {
+	for (source::const_iterator i = s.begin(); i != s.end(); ++i) {
+		ref.insert(std::make_pair(i->first, i->second));
+	}
+	return m.verify() && test::same(m, ref);
+}
+
+template<typename Map>
+static void test_range() {
+	test::Random rnd(5);
+	source empty;
+	Map m(empty.begin(), empty.end());
+	m.insert(empty.begin(), empty.end());
+	CHECK(m.empty() && m.verify() && m.begin() == m.end());
+	//↓↓↓ все длины до 300: неполный последний уровень любой формы
+	for (int n = 1; n <= 300; ++n) {
+		source s = sorted(n, 1 + rnd.next_int(3), rnd.next_int(100) - 50);
+		Map built_map(s.begin(), s.end());
+		CHECK(built(built_map, s, test::reference_map()));
+		built_map.insert(ft::make_pair(-1000, 0));
+		built_map.erase(s[static_cast<std::size_t>(n / 2)].first);
+		CHECK(built_map.verify());
+	}
+	source big = sorted(1 << 14, 2, 0);
+	Map large(big.begin(), big.end());
+	CHECK(built(large, big, test::reference_map()));
+	big.push_back(ft::make_pair(1 << 16, 0));
+	Map larger(big.begin(), big.end());
+	CHECK(built(larger, big, test::reference_map()));
+	//↓↓↓ повторы подряд: цепочка обрывается на первом, остаются значения первых вхождений
+	for (int round = 0; round < 50; ++round) {
+		source s;
+		int key = 0;
+		for (int i = 0; i < 200; ++i) {
+			key += rnd.next_int(3) == 0 ? 0 : 1 + rnd.next_int(3);
+			s.push_back(ft::make_pair(key, i));
+		}
+		Map dup;
+		dup.insert(s.begin(), s.end());
+		CHECK(built(dup, s, test::reference_map()));
+	}
+	//↓↓↓ возрастающий префикс, потом произвольный хвост
+	for (int round = 0; round < 50; ++round) {
+		source s = sorted(rnd.next_int(200), 2, 0);
+		int tail = rnd.next_int(200);
+		for (int i = 0; i < tail; ++i) {
+			s.push_back(ft::make_pair(rnd.next_int(500) - 50, 1000 + i));
+		}
+		Map mixed(s.begin(), s.end());
+		CHECK(built(mixed, s, test::reference_map()));
+	}
+	//↓↓↓ в непустое дерево: все элементы идут поэлементно, старые значения не меняются
+	for (int round = 0; round < 50; ++round) {
+		Map target;
+		test::reference_map ref;
+		for (int i = 0; i < rnd.next_int(300); ++i) {
+			int key = rnd.next_int(600);
+			target[key] = -1;
+			ref[key] = -1;
+		}
+		source s = sorted(rnd.next_int(300), 1 + rnd.next_int(3), rnd.next_int(300));
+		target.insert(s.begin(), s.end());
+		CHECK(built(target, s, ref));
+	}
+	//↓↓↓ входной итератор -- двунаправленный список, а не вектор
+	source s = sorted(100, 1, 0);
+	std::list<ft::pair<int, int> > list(s.begin(), s.end());
+	Map from_list(list.begin(), list.end());
+	CHECK(built(from_list, s, test::reference_map()));
+}
+
+template<typename Set>
+static void test_set() {
+	std::vector<int> keys;
+	for (int i = 0; i < 1000; ++i) {
+		keys.push_back(i / 3);
+	}
+	Set s(keys.begin(), keys.end());
+	std::set<int> ref(keys.begin(), keys.end());
+	CHECK(s.verify() && test::same(s, ref));
+	keys.assign(1, -1);
+	s.insert(keys.begin(), keys.end());
+	ref.insert(-1);
+	CHECK(s.verify() && test::same(s, ref));
+}
+
+template<typename Balance>
+static void test_balance() {
+	test_range<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::null_node_update, Balance> >();
+	test_range<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::order_statistic_node_update, Balance> >();
+	test_range<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::threaded_node_update, Balance> >();
+	test_set<ft::set<int, std::less<int>, std::allocator<int>, ft::threaded_node_update, Balance> >();
+}
+
+int main() {
+	test_balance<ft::red_black_balance>();
+	test_balance<ft::avl_balance>();
+	test_balance<ft::splay_balance>();
+	return test::report("build");
+}
@@ -0,0 +1,86 @@
+/*
+// map::operator[] и map::try_emplace ищут ключ одним спуском: при попадании значение
+// не конструируется и не копируется, при промахе mapped_type конструируется ровно один
+// раз -- сразу в узле. Ссылка на значение другого элемента остается валидной при вставке:
+// m[k] = m[other] и try_emplace(k, m[other]) копируют нужное значение.
+*/
+
+#include <functional>
+#include <map>
+#include <string>
+#include "map.hpp"
+#include "test.hpp"
+
+template<typename NodeUpdate, typename Balance>
+struct counted_map {
+	typedef ft::map<int, test::counted, std::less<int>, std::allocator<ft::pair<const int, test::counted> >, NodeUpdate, Balance>	type;
+};
+
+template<typename Map>
+static void test_counts() {
+	Map m;
+	test::counted seven(7);
+	for (int key = 0; key < 200; key += 2) {
+		test::counted::reset();
+		CHECK(m[key].value == 0 && test::counted::constructed() == 1);
+		test::counted::reset();
+		ft::pair<typename Map::iterator, bool> res = m.try_emplace(key + 1, seven);
+		CHECK(res.second && res.first->second.value == 7 && test::counted::constructed() == 1);
+		test::counted::reset();
+		res = m.try_emplace(key + 1000);
+		CHECK(res.second && res.first->second.value == 0 && test::counted::constructed() == 1);
+	}
+	for (int key = 0; key < 200; ++key) {
+		test::counted::reset();
+		m[key].value += 1;
+		CHECK(test::counted::constructed() == 0 && test::counted::assigned() == 0);
+		ft::pair<typename Map::iterator, bool> res = m.try_emplace(key, seven);
+		CHECK(!res.second && res.first->first == key && test::counted::constructed() == 0 && test::counted::assigned() == 0);
+		if (key % 2 == 0) {
+			res = m.try_emplace(key + 1000);
+			CHECK(!res.second && test::counted::constructed() == 0 && test::counted::assigned() == 0);
+		}
+		CHECK(m[key].value == (key % 2 == 0 ? 1 : 8));
+	}
+	CHECK(m.size() == 300 && m.verify());
+}
+
+//↓↓↓ значение другого элемента берется по ссылке, пока дерево перестраивается вставкой
+template<typename Map>
+static void test_aliasing() {
+	Map m;
+	std::map<int, std::string> ref;
+	m[0] = "zero";
+	ref[0] = "zero";
+	test::Random rnd(9);
+	for (int i = 1; i < 1500; ++i) {
+		int key = rnd.next_int(3000);
+		int other = rnd.next_int(3000);
+		if (i % 2 == 0) {
+			m[key] = m[other] + "+";
+			std::string& value = ref[other];
+			ref[key] = value + "+";
+		} else {
+			m.try_emplace(key, m[other]);
+			std::string value = ref[other];
+			ref.insert(std::make_pair(key, value));
+		}
+		m[key] = m[key];
+	}
+	CHECK(m.verify() && test::same(m, ref));
+}
+
+template<typename NodeUpdate, typename Balance>
+static void test_policy() {
+	test_counts<typename counted_map<NodeUpdate, Balance>::type>();
+	test_aliasing<ft::map<int, std::string, std::less<int>, std::allocator<ft::pair<const int, std::string> >, NodeUpdate, Balance> >();
+	test_aliasing<ft::map<int, std::string, std::less<int>, ft::pool_allocator<ft::pair<const int, std::string> >, NodeUpdate, Balance> >();
+}
+
+int main() {
+	test_policy<ft::null_node_update, ft::red_black_balance>();
+	test_policy<ft::order_statistic_node_update, ft::red_black_balance>();
+	test_policy<ft::threaded_node_update, ft::avl_balance>();
+	test_policy<ft::null_node_update, ft::splay_balance>();
+	return test::report("emplace");
+}
@@ -0,0 +1,102 @@
+/*
+// find_batch у ft::map и ft::set: результат для каждого ключа сверяется с find() --
+// пустой map, пачки из 1, 31, 32, 33 и 100 ключей (границы batch_width = 32 и неполная
+// последняя пачка), только промахи и промахи вперемешку с попаданиями, повторы ключей.
+// Ключи идут через прямой итератор (std::list); промах пишет end() поверх прежнего
+// значения, вернувшийся out указывает сразу за последней записью.
+*/
+
+#include <functional>
+#include <iterator>
+#include <list>
+#include <vector>
+#include "map.hpp"
+#include "set.hpp"
+#include "test.hpp"
+
+//↓↓↓ результат find_batch совпадает с find() по каждому ключу, и для map, и для const map
+template<typename Map>
+static void check_batch(Map& m, const std::list<int>& keys) {
+	typedef typename Map::iterator			iterator;
+	typedef typename Map::const_iterator	const_iterator;
+	//↓↓↓ заполнение begin(): промах обязан записать end() поверх
+	std::vector<iterator> out(keys.size() + 1, m.begin());
+	typename std::vector<iterator>::iterator last = m.find_batch(keys.begin(), keys.end(), out.begin());
+	CHECK(last == out.begin() + static_cast<long>(keys.size()) && out.back() == m.begin());
+	std::size_t i = 0;
+	for (std::list<int>::const_iterator k = keys.begin(); k != keys.end(); ++k, ++i) {
+		CHECK(out[i] == m.find(*k));
+	}
+	const Map& cm = m;
+	std::vector<const_iterator> const_out;
+	cm.find_batch(keys.begin(), keys.end(), std::back_inserter(const_out));
+	CHECK(const_out.size() == keys.size());
+	i = 0;
+	for (std::list<int>::const_iterator k = keys.begin(); k != keys.end() && i < const_out.size(); ++k, ++i) {
+		CHECK(const_out[i] == cm.find(*k));
+	}
+}
+
+//↓↓↓ ключи map -- четные из [0, 2 * size): нечетные и выходящие за края -- промахи
+static std::list<int> make_keys(test::Random& rnd, int count, int size, int misses_per_8) {
+	std::list<int> keys;
+	for (int i = 0; i < count; ++i) {
+		if (rnd.next_int(8) < misses_per_8) {
+			int kind = rnd.next_int(3);
+			keys.push_back(kind == 0 ? -1 - rnd.next_int(10) : kind == 1 ? 2 * size + rnd.next_int(10) : 2 * rnd.next_int(size + 1) + 1);
+		} else {
+			keys.push_back(2 * rnd.next_int(size > 0 ? size : 1));
+		}
+	}
+	return keys;
+}
+
+template<typename Map>
+static void test_map() {
+	test::Random rnd(20);
+	const int counts[] = { 0, 1, 31, 32, 33, 64, 100 };
+	const int sizes[] = { 0, 1, 5, 100, 5000 };
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		Map m;
+		for (int i = 0; i < sizes[s]; ++i) {
+			m[2 * i] = i;
+		}
+		for (std::size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+			check_batch(m, make_keys(rnd, counts[c], sizes[s], 8));
+			check_batch(m, make_keys(rnd, counts[c], sizes[s], 4));
+			check_batch(m, make_keys(rnd, counts[c], sizes[s], 0));
+		}
+	}
+	//↓↓↓ повторы: все ключи пачки одинаковые
+	Map m;
+	m[4] = 4;
+	check_batch(m, std::list<int>(33, 4));
+	check_batch(m, std::list<int>(33, 5));
+}
+
+static void test_set() {
+	ft::set<int> s;
+	for (int i = 0; i < 1000; i += 2) {
+		s.insert(i);
+	}
+	std::list<int> keys;
+	for (int i = -3; i < 1003; ++i) {
+		keys.push_back(i);
+	}
+	std::vector<ft::set<int>::iterator> out;
+	s.find_batch(keys.begin(), keys.end(), std::back_inserter(out));
+	CHECK(out.size() == keys.size());
+	std::size_t i = 0;
+	for (std::list<int>::iterator k = keys.begin(); k != keys.end() && i < out.size(); ++k, ++i) {
+		CHECK(out[i] == s.find(*k) && (out[i] == s.end()) == (*k < 0 || *k >= 1000 || *k % 2 != 0));
+	}
+}
+
+int main() {
+	test_map<ft::map<int, int> >();
+	test_map<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::order_statistic_node_update> >();
+	test_map<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::threaded_node_update> >();
+	test_map<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::null_node_update, ft::avl_balance> >();
+	test_set();
+	return test::report("find_batch");
+}
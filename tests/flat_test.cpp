@@ -0,0 +1,84 @@
+/*
+// ft::flat_map и ft::flat_set: одиночная вставка (с подсказкой и без), operator[],
+// вставка пачкой (слияние с массивом, дубликаты внутри пачки и с массивом), удаление
+// по ключу, итератору и диапазону сверяются с std::map; обход в прямом и обратном
+// порядке; поиск с прозрачным ft::less<>; копирование и swap с ft::pool_allocator.
+*/
+
+#include <cstdio>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+#include "flat_map.hpp"
+#include "flat_set.hpp"
+#include "utils/less.hpp"
+#include "utils/pool_allocator.hpp"
+#include "test.hpp"
+
+typedef ft::flat_map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > >	pool_map;
+
+//↓↓↓ к общим шагам упорядоченного map добавляется вставка пачкой: неотсортированной,
+// с повторами внутри и с ключами, которые уже есть
+struct flat_ops : test::ordered_ops {
+	template<typename Map>
+	void step(test::Random& rnd, Map& m, test::reference_map& ref, int key, int range, int i) const {
+		if (rnd.next_int(4)) {
+			test::ordered_ops::step(rnd, m, ref, key, range, i);
+			return ;
+		}
+		std::vector<ft::pair<int, int> > batch;
+		int n = rnd.next_int(40);
+		for (int j = 0; j < n; ++j) {
+			int k = rnd.next_int(range);
+			batch.push_back(ft::make_pair(k, i + j));
+			ref.insert(std::make_pair(k, i + j));
+		}
+		m.insert(batch.begin(), batch.end());
+	}
+};
+
+static void test_transparent() {
+	ft::flat_map<std::string, int, ft::less<> > m;
+	ft::flat_set<std::string, ft::less<> > s;
+	char key[16];
+	for (int i = 999; i >= 0; --i) {
+		std::sprintf(key, "k%04d", i);
+		m[key] = i;
+		s.insert(s.begin(), key);
+	}
+	CHECK(m.find("k0500")->second == 500 && m.find("x") == m.end());
+	CHECK(m.count("k0999") == 1 && m.lower_bound("k05")->first == "k0500");
+	CHECK(m.upper_bound("k0500")->first == "k0501" && m.equal_range("k0007").first->second == 7);
+	CHECK(s.count("k0001") == 1 && s.lower_bound("k1") == s.end() && *s.find("k0042") == "k0042");
+}
+
+static void test_set() {
+	test::Random rnd(5);
+	ft::flat_set<int> s;
+	std::set<int> ref;
+	for (int i = 0; i < 10000; ++i) {
+		int key = rnd.next_int(3000);
+		if (rnd.next_int(3)) {
+			CHECK(s.insert(key).second == ref.insert(key).second);
+		} else {
+			CHECK(s.erase(key) == ref.erase(key));
+		}
+	}
+	std::vector<int> batch;
+	for (int i = 0; i < 5000; ++i) {
+		batch.push_back(rnd.next_int(6000));
+	}
+	s.insert(batch.begin(), batch.end());
+	ref.insert(batch.begin(), batch.end());
+	CHECK(test::same(s, ref));
+}
+
+int main() {
+	test::random_rounds<ft::flat_map<int, int> >(1, 40, 2000, 2000, flat_ops());
+	test::random_rounds<pool_map>(2, 40, 2000, 2000, flat_ops());
+	test_transparent();
+	test_set();
+	test::pool_copies<pool_map>();
+	return test::report("flat");
+}
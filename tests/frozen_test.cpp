@@ -0,0 +1,101 @@
+/*
+// ft::frozen_map: снимки случайных ft::map всех размеров от 0 (неполные последние уровни
+// дерева Эйтцингера) сверяются с исходным map -- обход в обе стороны, find, count,
+// lower/upper_bound и equal_range для каждого ключа и промахов между ними; поиск
+// с прозрачным ft::less<>; копирование, присваивание и swap, в том числе с ft::pool_allocator.
+*/
+
+#include <functional>
+#include <string>
+#include "frozen_map.hpp"
+#include "map.hpp"
+#include "utils/less.hpp"
+#include "utils/pool_allocator.hpp"
+#include "test.hpp"
+
+typedef ft::map<int, int>			source_map;
+typedef ft::frozen_map<int, int>	frozen;
+
+static bool probe(const frozen& f, const source_map& m, int key) {
+	frozen::const_iterator found = f.find(key);
+	source_map::const_iterator ref = m.find(key);
+	if ((found == f.end()) != (ref == m.end()) || (ref != m.end() && found->second != ref->second)) {
+		return false;
+	}
+	frozen::const_iterator lb = f.lower_bound(key);
+	frozen::const_iterator ub = f.upper_bound(key);
+	source_map::const_iterator rl = m.lower_bound(key);
+	source_map::const_iterator ru = m.upper_bound(key);
+	if (rl == m.end() ? lb != f.end() : lb->first != rl->first) {
+		return false;
+	}
+	if (ru == m.end() ? ub != f.end() : ub->first != ru->first) {
+		return false;
+	}
+	ft::pair<frozen::const_iterator, frozen::const_iterator> range = f.equal_range(key);
+	return f.count(key) == m.count(key) && range.first == lb && range.second == ub;
+}
+
+static void test_random() {
+	test::Random rnd(777);
+	for (int round = 0; round < 150; ++round) {
+		int n = round < 70 ? round : rnd.next_int(3000);
+		int range = 1 + n * 3;
+		source_map m;
+		while (static_cast<int>(m.size()) < n) {
+			int key = rnd.next_int(range);
+			m[key] = key * 7;
+		}
+		frozen f(m);
+		CHECK(test::same(f, m));
+		bool probes = true;
+		for (int key = -2; key < range + 2 && probes; ++key) {
+			probes = probe(f, m, key);
+		}
+		CHECK(probes);
+		frozen copy(f);
+		CHECK(copy == f && !(copy < f));
+		frozen assigned;
+		CHECK(assigned.empty() && assigned.begin() == assigned.end() && assigned.find(1) == assigned.end());
+		assigned = ft::freeze(m);
+		assigned.swap(copy);
+		CHECK(test::same(assigned, m) && test::same(copy, m));
+		copy = frozen();
+		CHECK(copy.empty() && (n == 0 || copy < assigned));
+	}
+}
+
+static void test_transparent() {
+	ft::map<std::string, int, ft::less<> > m;
+	m["a"] = 1;
+	m["b"] = 2;
+	ft::frozen_map<std::string, int, ft::less<> > f(m);
+	CHECK(f.find("b")->second == 2 && f.count("c") == 0 && f.lower_bound("aa")->first == "b");
+}
+
+static void test_pool() {
+	typedef ft::pool_allocator<ft::pair<const int, int> >	pool;
+	typedef ft::map<int, int, std::less<int>, pool>			pool_map;
+	typedef ft::frozen_map<int, int, std::less<int>, pool>	pool_frozen;
+	pool_map m;
+	for (int i = 0; i < 1000; ++i) {
+		m[i] = i;
+	}
+	pool_frozen a = ft::freeze(m);
+	pool_frozen b;
+	{
+		pool_frozen c(a);
+		b = c;
+		pool_frozen d(m);
+		d.swap(c);
+	}
+	m.clear();
+	CHECK(a.size() == 1000 && b.size() == 1000 && b.find(999)->second == 999);
+}
+
+int main() {
+	test_random();
+	test_transparent();
+	test_pool();
+	return test::report("frozen");
+}
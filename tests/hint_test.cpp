@@ -0,0 +1,167 @@
+/*
+// Вставка с подсказкой в ft::map и ft::set: подсказка begin(), end(), точная (lower_bound
+// ключа), на элемент раньше, на элемент позже и случайная. Для нового ключа возвращается
+// итератор на вставленный элемент, для существующего -- на него самого, значение не
+// меняется. Обратный итератор: base() и обратное преобразование, rend() пустого дерева,
+// явный конструктор из прямого итератора (шаг назад).
+*/
+
+#include <functional>
+#include <map>
+#include <set>
+#include "map.hpp"
+#include "set.hpp"
+#include "test.hpp"
+
+enum hint_kind { hint_begin, hint_end, hint_exact, hint_before, hint_after, hint_wrong, hint_kinds };
+
+template<typename Map>
+static typename Map::iterator make_hint(Map& m, int key, int kind, test::Random& rnd) {
+	typename Map::iterator exact = m.lower_bound(key);
+	switch (kind) {
+		case hint_begin:
+			return m.begin();
+		case hint_end:
+			return m.end();
+		case hint_exact:
+			return exact;
+		case hint_before:
+			return exact == m.begin() ? exact : --exact;
+		case hint_after:
+			return exact == m.end() ? exact : ++exact;
+		default: {
+			typename Map::iterator it = m.begin();
+			for (int i = rnd.next_int(static_cast<int>(m.size()) + 1); i > 0; --i) {
+				++it;
+			}
+			return it;
+		}
+	}
+}
+
+//↓↓↓ ключи 0, 2, ..., 2(n-1); вставляются все ключи от -1 до 2n с каждым видом подсказки
+template<typename Map>
+static void test_positions() {
+	static const int sizes[] = {0, 1, 2, 3, 10, 100};
+	test::Random rnd(4);
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		Map base;
+		test::reference_map base_ref;
+		for (int i = 0; i < sizes[s]; ++i) {
+			base[2 * i] = i;
+			base_ref[2 * i] = i;
+		}
+		for (int key = -1; key <= 2 * sizes[s]; ++key) {
+			for (int kind = 0; kind < hint_kinds; ++kind) {
+				Map m(base);
+				test::reference_map ref(base_ref);
+				bool existed = ref.count(key) != 0;
+				typename Map::iterator hint = make_hint(m, key, kind, rnd);
+				typename Map::iterator it = m.insert(hint, ft::make_pair(key, -7));
+				ref.insert(std::make_pair(key, -7));
+				CHECK(it != m.end() && it->first == key && it == m.find(key));
+				CHECK(it->second == (existed ? key / 2 : -7));
+				CHECK(m.verify() && test::same(m, ref));
+			}
+		}
+	}
+}
+
+//↓↓↓ типичные подсказки при заполнении: end() по возрастанию, begin() по убыванию,
+// результат предыдущей вставки вперемешку с повторами
+template<typename Map>
+static void test_sequences() {
+	Map up, down, chained;
+	test::reference_map ref;
+	typename Map::iterator last = chained.end();
+	for (int i = 0; i < 3000; ++i) {
+		up.insert(up.end(), ft::make_pair(i, i));
+		down.insert(down.begin(), ft::make_pair(2999 - i, 2999 - i));
+		last = chained.insert(last, ft::make_pair(i / 2, i / 2));
+		CHECK(last->first == i / 2);
+		ref[i] = i;
+	}
+	CHECK(up.verify() && test::same(up, ref));
+	CHECK(down.verify() && test::same(down, ref));
+	CHECK(chained.verify() && chained.size() == 1500);
+}
+
+template<typename Set>
+static void test_set() {
+	Set s;
+	std::set<int> ref;
+	test::Random rnd(12);
+	for (int i = 0; i < 2000; ++i) {
+		int key = rnd.next_int(1000);
+		typename Set::iterator hint = s.lower_bound(key + rnd.next_int(3) - 1);
+		typename Set::iterator it = s.insert(hint, key);
+		ref.insert(key);
+		CHECK(*it == key && it == s.find(key));
+	}
+	CHECK(s.verify() && test::same(s, ref));
+}
+
+//↓↓↓ обратный итератор на каждой позиции: reverse_iterator(it) стоит на элементе перед it,
+// его base() возвращает it; из reverse_iterator и обратно через base() -- тот же итератор
+template<typename Map>
+static void test_reverse() {
+	typedef typename Map::iterator				iterator;
+	typedef typename Map::reverse_iterator		reverse_iterator;
+	typedef typename Map::const_reverse_iterator	const_reverse_iterator;
+	static const int sizes[] = {0, 1, 2, 5, 100};
+	for (std::size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		Map m;
+		for (int i = 0; i < sizes[s]; ++i) {
+			m[i * 3] = i;
+		}
+		const Map& cm = m;
+		CHECK(m.rend().base() == m.begin() && m.rbegin().base() == m.end());
+		CHECK(reverse_iterator(m.end()) == m.rbegin() && reverse_iterator(m.begin()) == m.rend());
+		CHECK(cm.rend() == const_reverse_iterator(m.rend()) && cm.rbegin() == const_reverse_iterator(m.rbegin()));
+		if (m.empty()) {
+			CHECK(m.rbegin() == m.rend() && cm.rbegin() == cm.rend());
+			CHECK(m.rend().base() == m.end());
+		}
+		for (iterator it = m.begin();; ++it) {
+			reverse_iterator r(it);
+			CHECK(r.base() == it);
+			if (it == m.begin()) {
+				CHECK(r == m.rend());
+			} else {
+				iterator before = it;
+				--before;
+				CHECK(&*r == &*before && r->first == before->first);
+			}
+			if (it == m.end()) {
+				break;
+			}
+		}
+		int expected = sizes[s] - 1;
+		for (reverse_iterator r = m.rbegin(); r != m.rend(); ++r, --expected) {
+			CHECK(r->first == expected * 3 && reverse_iterator(r.base()) == r);
+			reverse_iterator next = r;
+			CHECK(--(++next) == r);
+			const_reverse_iterator cr = r;
+			CHECK(cr == r && &*cr == &*r);
+		}
+		CHECK(expected == -1);
+	}
+}
+
+template<typename NodeUpdate, typename Balance>
+static void test_policy() {
+	typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, NodeUpdate, Balance>	map_type;
+	test_positions<map_type>();
+	test_sequences<map_type>();
+	test_reverse<map_type>();
+	test_set<ft::set<int, std::less<int>, std::allocator<int>, NodeUpdate, Balance> >();
+}
+
+int main() {
+	test_policy<ft::null_node_update, ft::red_black_balance>();
+	test_policy<ft::order_statistic_node_update, ft::red_black_balance>();
+	test_policy<ft::threaded_node_update, ft::red_black_balance>();
+	test_policy<ft::null_node_update, ft::avl_balance>();
+	test_policy<ft::threaded_node_update, ft::splay_balance>();
+	return test::report("hint");
+}
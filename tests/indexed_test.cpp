@@ -0,0 +1,144 @@
+/*
+// ft::map и ft::set на RBTree_indexed (ft::indexed_node_storage): вставка (с подсказкой
+// и без), operator[], удаление по ключу, итератору и диапазону сверяются с std::map,
+// после каждого шага -- verify(). Отдельно: try_emplace со значением из этого же map на
+// каждой границе роста массива, переиспользование ячеек после удаления, копирование,
+// присваивание и swap массива со свободными ячейками, обратный обход.
+*/
+
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "set.hpp"
+#include "utils/pool_allocator.hpp"
+#include "test.hpp"
+
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::indexed_node_storage>												indexed_map;
+typedef ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> >,
+		ft::indexed_node_storage>												pool_map;
+typedef ft::map<int, std::string, std::less<int>, std::allocator<ft::pair<const int, std::string> >,
+		ft::indexed_node_storage>												text_map;
+typedef ft::set<int, std::less<int>, std::allocator<int>, ft::indexed_node_storage>	indexed_set;
+
+static std::string text(int v) {
+	char buf[48];
+	std::sprintf(buf, "value %d, long enough for the heap", v);
+	return buf;
+}
+
+//↓↓↓ значение берется из элемента этого же map, а вставка переносит массив: каждая
+// вставка на единицу больше предыдущей, поэтому попадает на все границы удвоения
+static void test_self_reference() {
+	text_map m;
+	std::map<int, std::string> ref;
+	m[0] = text(0);
+	ref[0] = text(0);
+	for (int n = 1; n < 600; ++n) {
+		const std::string& other = m[n / 2];
+		ft::pair<text_map::iterator, bool> r = m.try_emplace(n, other);
+		ref[n] = ref[n / 2];
+		CHECK(r.second && r.first->second == ref[n] && m[n / 2] == ref[n / 2]);
+		ft::pair<text_map::iterator, bool> again = m.try_emplace(n, m[0]);
+		CHECK(!again.second && again.first == r.first);
+		if (n % 7 == 0) {
+			m[n / 3] = text(n);
+			ref[n / 3] = text(n);
+		}
+	}
+	CHECK(m.verify() && test::same(m, ref));
+}
+
+//↓↓↓ удаленные ячейки уходят в список свободных (последняя удаленная -- первая выданная),
+// новые узлы занимают их, пока список не кончится
+static void test_free_slots() {
+	indexed_map m;
+	for (int i = 0; i < 1000; ++i) {
+		m[i] = i;
+	}
+	std::vector<const void*> freed;
+	for (int i = 0; i < 1000; i += 3) {
+		freed.push_back(&*m.find(i));
+		m.erase(i);
+	}
+	CHECK(m.verify() && m.size() == 1000 - 334);
+	for (std::size_t i = 0; i < freed.size(); ++i) {
+		int key = 5000 + static_cast<int>(i);
+		m[key] = key;
+		CHECK(&*m.find(key) == freed[freed.size() - 1 - i]);
+	}
+	CHECK(m.verify() && m.size() == 1000);
+	const void* last = &*m.find(998);
+	m.erase(m.find(998));
+	CHECK(&*m.insert(ft::make_pair(-1, -1)).first == last);
+	m.erase(m.begin(), m.end());
+	CHECK(m.empty() && m.verify() && m.begin() == m.end() && m.rbegin() == m.rend());
+	m[1] = 1;
+	CHECK(m.size() == 1 && m.verify());
+}
+
+//↓↓↓ копия -- тот же массив вместе со свободными ячейками: оригинал и копия дальше
+// выдают одни и те же индексы, но каждый из своего массива
+static void test_copies() {
+	test::Random rnd(16);
+	indexed_map a;
+	test::reference_map ra;
+	test::random_ops(rnd, a, ra, 3000, 4000, test::tree_ops());
+	indexed_map b(a);
+	test::reference_map rb(ra);
+	indexed_map c;
+	c[-5] = -5;
+	c = a;
+	test::reference_map rc(ra);
+	test::random_ops(rnd, a, ra, 3000, 2000, test::tree_ops());
+	test::random_ops(rnd, b, rb, 3000, 2000, test::tree_ops());
+	test::random_ops(rnd, c, rc, 3000, 2000, test::tree_ops());
+	CHECK(test::same(a, ra) && test::same(b, rb) && test::same(c, rc));
+	a.swap(b);
+	CHECK(a.verify() && b.verify() && test::same(a, rb) && test::same(b, ra));
+	c = c;
+	c.clear();
+	CHECK(c.verify() && c.empty() && c.rbegin() == c.rend());
+	c.swap(a);
+	CHECK(a.empty() && a.verify() && test::same(c, rb));
+	indexed_map::const_reverse_iterator rit = c.rbegin();
+	test::reference_map::const_reverse_iterator rr = rb.rbegin();
+	for (; rr != rb.rend(); ++rr, ++rit) {
+		CHECK(rit->first == rr->first && rit.base() != c.begin());
+	}
+	CHECK(rit == c.rend() && rit.base() == c.begin());
+}
+
+static void test_set() {
+	test::Random rnd(7);
+	indexed_set s;
+	std::set<int> ref;
+	for (int i = 0; i < 20000; ++i) {
+		int key = rnd.next_int(3000);
+		if (rnd.next_int(3)) {
+			CHECK(s.insert(key).second == ref.insert(key).second);
+		} else {
+			CHECK(s.erase(key) == ref.erase(key));
+		}
+	}
+	CHECK(s.verify() && test::same(s, ref));
+	indexed_set copy(s);
+	s.erase(s.begin(), s.lower_bound(1500));
+	CHECK(s.verify() && copy.verify() && test::same(copy, ref));
+}
+
+int main() {
+	test::random_rounds<indexed_map>(1, 30, 2000, 3000, test::tree_ops());
+	test::random_rounds<indexed_map>(2, 60, 40, 500, test::tree_ops());
+	test::random_rounds<pool_map>(3, 20, 2000, 3000, test::tree_ops());
+	test_self_reference();
+	test_free_slots();
+	test_copies();
+	test_set();
+	test::pool_copies<pool_map>();
+	return test::report("indexed");
+}
@@ -0,0 +1,182 @@
+/*
+// Node handles ft::map и ft::set: extract, insert(node) с подсказкой и без, merge --
+// случайные операции сверяются с std::map. При равных аллокаторах узел переходит без
+// копирования значения, при разных пулах pool_allocator -- значение копируется.
+*/
+
+#include <functional>
+#include <map>
+#include <string>
+#include "map.hpp"
+#include "set.hpp"
+#include "utils/pool_allocator.hpp"
+#include "test.hpp"
+
+static int live = 0;
+static int copies = 0;
+
+struct Value {
+	int v;
+	Value(int x = 0) : v(x) { ++live; }
+	Value(const Value& rhs) : v(rhs.v) { ++live; ++copies; }
+	~Value() { --live; }
+};
+
+template<typename Map>
+static void same(const Map& m, const std::map<int, int>& ref) {
+	CHECK(m.size() == ref.size());
+	std::map<int, int>::const_iterator j = ref.begin();
+	for (typename Map::const_iterator i = m.begin(); i != m.end() && j != ref.end(); ++i, ++j) {
+		CHECK(i->first == j->first && i->second.v == j->second);
+	}
+}
+
+template<typename Map>
+static void test_random() {
+	test::Random rnd;
+	Map a;
+	Map b;
+	std::map<int, int> ra;
+	std::map<int, int> rb;
+	for (int i = 0; i < 3000; ++i) {
+		int k = rnd.next_int(2000);
+		int op = rnd.next_int(6);
+		if (op < 2) {
+			a.insert(ft::make_pair(k, Value(i)));
+			ra.insert(std::make_pair(k, i));
+		} else if (op == 2) {
+			b.insert(ft::make_pair(k, Value(i)));
+			rb.insert(std::make_pair(k, i));
+		} else if (op == 3) {
+			int before = copies;
+			typename Map::node_type nh = a.extract(k);
+			CHECK(nh.empty() == (ra.count(k) == 0));
+			if (nh.empty()) {
+				continue;
+			}
+			CHECK(nh.key() == k);
+			nh.mapped().v += 1;
+			int v = ra[k] + 1;
+			ra.erase(k);
+			typename Map::insert_return_type r = b.insert(nh);
+			CHECK(nh.empty() && r.position->first == k);
+			if (rb.count(k)) {
+				CHECK(!r.inserted && !r.node.empty() && r.node.mapped().v == v);
+			} else {
+				CHECK(r.inserted && r.node.empty());
+				rb[k] = v;
+			}
+			CHECK(copies == before);
+		} else if (op == 4 && !b.empty()) {
+			typename Map::iterator it = b.lower_bound(k);
+			if (it == b.end()) {
+				--it;
+			}
+			int key = it->first;
+			int v = it->second.v;
+			typename Map::node_type nh = b.extract(it);
+			rb.erase(key);
+			nh.key() = key + 1;
+			typename Map::iterator r = a.insert(a.lower_bound(key + 1), nh);
+			CHECK(r->first == key + 1);
+			if (ra.count(key + 1)) {
+				CHECK(!nh.empty());
+			} else {
+				CHECK(nh.empty() && r->second.v == v);
+				ra[key + 1] = v;
+			}
+		} else if (op == 5 && i % 50 == 0) {
+			int before = copies;
+			a.merge(b);
+			CHECK(copies == before);
+			for (std::map<int, int>::iterator j = rb.begin(); j != rb.end(); ) {
+				if (ra.insert(*j).second) {
+					rb.erase(j++);
+				} else {
+					++j;
+				}
+			}
+		}
+	}
+	same(a, ra);
+	same(b, rb);
+
+	typename Map::node_type empty;
+	typename Map::insert_return_type r = a.insert(empty);
+	CHECK(!r.inserted && r.position == a.end());
+	typename Map::node_type x = a.extract(a.begin());
+	typename Map::node_type y = x;
+	CHECK(x.empty() && !y.empty());
+	y = a.extract(a.begin());
+	x.swap(y);
+	CHECK(y.empty() && !x.empty());
+
+	Map c;
+	c.merge(a);
+	CHECK(a.empty() && c.size() + 2 == ra.size());
+	c.merge(c);
+	CHECK(c.size() + 2 == ra.size());
+}
+
+//↓↓↓ разные пулы: узел не переходит, значение копируется, handle освобождает узел своим пулом
+static void test_pool() {
+	typedef ft::map<int, Value, std::less<int>, ft::pool_allocator<ft::pair<const int, Value> > > pool_map;
+	pool_map a;
+	pool_map b;
+	for (int i = 0; i < 100; ++i) {
+		a[i * 2] = Value(i);
+		b[i * 3] = Value(i);
+	}
+	a.merge(b);
+	CHECK(a.size() == 166 && b.size() == 34);
+	{
+		pool_map c;
+		c[1] = Value(7);
+		pool_map::node_type nh = c.extract(1);
+		int before = copies;
+		CHECK(b.insert(nh).inserted && nh.empty());
+		CHECK(copies == before + 1);
+		nh = c.extract(2);
+		CHECK(nh.empty());
+	}
+	CHECK(b.size() == 35 && b[1].v == 7);
+	b.clear();
+	for (int i = 0; i < 100; ++i) {
+		b[i] = Value(i);
+	}
+	pool_map d(b);
+	pool_map::node_type nh = d.extract(4);
+	int before = copies;
+	pool_map::insert_return_type r = a.insert(nh);
+	CHECK(!r.inserted && !r.node.empty());
+	CHECK(b.insert(b.end(), d.extract(7)) != b.end());
+	d.insert(r.node);
+	CHECK(copies == before && d.size() == 99 && d.count(4) == 1);
+}
+
+static void test_set() {
+	ft::set<std::string> s;
+	ft::set<std::string> t;
+	s.insert("a");
+	s.insert("b");
+	t.insert("b");
+	ft::set<std::string>::node_type nh = s.extract("a");
+	CHECK(nh.value() == "a" && s.size() == 1);
+	nh.value() = "c";
+	CHECK(t.insert(nh).inserted && t.size() == 2);
+	t.merge(s);
+	CHECK(s.size() == 1 && t.size() == 2);
+	s.insert(t.extract(t.begin()));
+	ft::set<std::string>::node_type dropped = t.extract("c");
+	CHECK(t.empty() && dropped.value() == "c");
+}
+
+int main() {
+	test_random<ft::map<int, Value> >();
+	test_random<ft::map<int, Value, std::less<int>, std::allocator<ft::pair<const int, Value> >, ft::order_statistic_node_update> >();
+	test_random<ft::map<int, Value, std::less<int>, std::allocator<ft::pair<const int, Value> >, ft::threaded_node_update> >();
+	test_pool();
+	test_set();
+	CHECK(live == 0);
+	return test::report("node_handle");
+}
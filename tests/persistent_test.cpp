@@ -0,0 +1,128 @@
+/*
+// ft::map и ft::set на RBTree_persistent (ft::persistent_node_storage): случайные
+// вставки, operator[], удаления и снимки сверяются с std::map. Каждый снимок хранится
+// вместе со своей копией std::map и после всех последующих записей -- и в оригинал,
+// и в другие снимки -- должен остаться прежним. После каждого шага проверяются
+// инварианты LLRB (verify).
+*/
+
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "map.hpp"
+#include "set.hpp"
+#include "test.hpp"
+
+typedef ft::map<int, std::string, std::less<int>, std::allocator<ft::pair<const int, std::string> >,
+		ft::persistent_node_storage>												persistent_map;
+typedef ft::set<int, std::less<int>, std::allocator<int>, ft::persistent_node_storage>	persistent_set;
+typedef std::map<int, std::string>													reference_map;
+
+static std::string text(int v) {
+	char buf[16];
+	std::sprintf(buf, "v%d", v);
+	return buf;
+}
+
+//↓↓↓ запись идет в случайную версию: в основную или в один из снимков
+static void test_map() {
+	test::Random rnd(7);
+	std::vector<persistent_map> versions(1);
+	std::vector<reference_map> refs(1);
+	for (int step = 0; step < 20000; ++step) {
+		std::size_t v = static_cast<std::size_t>(rnd.next_int(static_cast<int>(versions.size())));
+		persistent_map& m = versions[v];
+		reference_map& ref = refs[v];
+		int key = rnd.next_int(500);
+		int op = rnd.next_int(10);
+		if (op < 3) {
+			bool inserted = m.insert(ft::make_pair(key, text(step))).second;
+			CHECK(inserted == ref.insert(std::make_pair(key, text(step))).second);
+		} else if (op < 5) {
+			m[key] = text(step);
+			ref[key] = text(step);
+		} else if (op < 7) {
+			CHECK(m.erase(key) == ref.erase(key));
+		} else if (op == 7 && !ref.empty()) {
+			int high = key + rnd.next_int(20);
+			m.erase(m.lower_bound(key), m.upper_bound(high));
+			ref.erase(ref.lower_bound(key), ref.upper_bound(high));
+		} else if (op == 8 && versions.size() < 16) {
+			versions.push_back(m);
+			refs.push_back(ref);
+		} else if (op == 9 && step % 200 == 0) {
+			std::size_t w = static_cast<std::size_t>(rnd.next_int(static_cast<int>(versions.size())));
+			versions[w] = versions[v];
+			refs[w] = refs[v];
+		}
+		if (step % 97 == 0) {
+			for (std::size_t i = 0; i < versions.size(); ++i) {
+				CHECK(versions[i].verify() && test::same(versions[i], refs[i]));
+			}
+		}
+	}
+	for (std::size_t i = 0; i < versions.size(); ++i) {
+		CHECK(versions[i].verify() && test::same(versions[i], refs[i]));
+	}
+	versions[0].clear();
+	refs[0].clear();
+	for (std::size_t i = 0; i < versions.size(); ++i) {
+		CHECK(versions[i].verify() && test::same(versions[i], refs[i]));
+	}
+}
+
+//↓↓↓ снимок до серии записей не меняется: ни значения, ни состав, ни порядок
+static void test_snapshot() {
+	persistent_map m;
+	for (int i = 0; i < 1000; ++i) {
+		m[i] = text(i);
+	}
+	const persistent_map snapshot(m);
+	reference_map before;
+	for (persistent_map::const_iterator i = snapshot.begin(); i != snapshot.end(); ++i) {
+		before[i->first] = i->second;
+	}
+	for (int i = 0; i < 1000; i += 3) {
+		m[i] = "changed";
+	}
+	for (int i = 1; i < 1000; i += 3) {
+		m.erase(i);
+	}
+	for (int i = 1000; i < 1500; ++i) {
+		m.insert(ft::make_pair(i, text(i)));
+	}
+	persistent_map::const_iterator it = snapshot.find(999);
+	CHECK(it->second == text(999) && snapshot.find(1) != snapshot.end());
+	CHECK(snapshot.verify() && test::same(snapshot, before) && m.verify() && m.size() == 1000 - 333 + 500);
+	m.clear();
+	CHECK(snapshot.verify() && test::same(snapshot, before));
+}
+
+static void test_set() {
+	test::Random rnd(11);
+	persistent_set s;
+	std::set<int> ref;
+	for (int i = 0; i < 5000; ++i) {
+		int key = rnd.next_int(1000);
+		if (rnd.next_int(3) == 0) {
+			CHECK(s.erase(key) == ref.erase(key));
+		} else {
+			CHECK(s.insert(key).second == ref.insert(key).second);
+		}
+	}
+	persistent_set snapshot(s);
+	std::set<int> before(ref);
+	s.erase(s.begin(), s.lower_bound(500));
+	CHECK(snapshot.verify() && s.verify() && test::same(snapshot, before));
+	CHECK(s.empty() || *s.begin() >= 500);
+}
+
+int main() {
+	test_map();
+	test_snapshot();
+	test_set();
+	return test::report("persistent");
+}
@@ -0,0 +1,114 @@
+/*
+// ft::pool_allocator: копии и rebind делят один пул, равенство -- общий пул,
+// память одной копии освобождается другой; контейнеры с пулом копируются,
+// присваиваются и меняются местами без обращения к чужой или освобожденной памяти.
+*/
+
+#include <functional>
+#include <stdexcept>
+#include "map.hpp"
+#include "vector.hpp"
+#include "utils/pool_allocator.hpp"
+#include "test.hpp"
+
+typedef ft::pool_allocator<int>											int_pool;
+typedef ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > >	pool_map;
+typedef ft::vector<int, int_pool>										pool_vector;
+
+static void test_equality() {
+	int_pool a;
+	int_pool b;
+	CHECK(a != b);
+	int_pool c(a);
+	CHECK(a == c);
+	ft::pool_allocator<double> d(a);
+	CHECK(d == a);
+	b = a;
+	CHECK(b == a);
+	int_pool e;
+	b.swap(e);
+	CHECK(e == a && b != a);
+}
+
+static void test_shared_memory() {
+	int* p;
+	int_pool keep;
+	{
+		int_pool a;
+		p = a.allocate(1);
+		*p = 42;
+		keep = a;
+		CHECK(keep.live() == 1);
+	}
+	CHECK(*p == 42);
+	keep.deallocate(p, 1);
+	CHECK(keep.live() == 0);
+	keep.release();
+
+	int_pool a;
+	ft::pool_allocator<float> f(a);
+	int* q = a.allocate(1);
+	float* r = f.allocate(1);
+	CHECK(a.live() == 2 && f.live() == 2);
+	a.deallocate(reinterpret_cast<int*>(r), 1);
+	f.deallocate(reinterpret_cast<float*>(q), 1);
+	CHECK(a.live() == 0);
+}
+
+static void test_map() {
+	pool_map a;
+	for (int i = 0; i < 1000; ++i) {
+		a[i] = i;
+	}
+	pool_map b(a);
+	CHECK(b.get_allocator() == a.get_allocator());
+	for (int i = 1000; i < 2000; ++i) {
+		b[i] = i;
+	}
+	pool_map c;
+	c[-1] = -1;
+	c = a;
+	for (int i = 0; i < 500; ++i) {
+		c.erase(i);
+	}
+	for (int i = 5000; i < 6000; ++i) {
+		c[i] = i;
+	}
+	a.swap(c);
+	a.clear();
+	for (int i = 0; i < 100; ++i) {
+		a[i] = i;
+	}
+	CHECK(a.size() == 100 && b.size() == 2000 && c.size() == 1000);
+	int sum = 0;
+	for (pool_map::iterator it = b.begin(); it != b.end(); ++it) {
+		sum += it->second;
+	}
+	CHECK(sum == 1999 * 2000 / 2);
+	pool_map d;
+	d[1] = 1;
+	d.merge(b);
+	CHECK(d.size() == 2000 && b.size() == 1);
+}
+
+static void test_vector() {
+	pool_vector a;
+	a.push_back(1);
+	pool_vector b(a);
+	for (int i = 0; i < 100; ++i) {
+		b.push_back(i);
+	}
+	a = b;
+	a.resize(1);
+	a.swap(b);
+	b.push_back(7);
+	CHECK(a.size() == 101 && b.size() == 2 && b[1] == 7);
+}
+
+int main() {
+	test_equality();
+	test_shared_memory();
+	test_map();
+	test_vector();
+	return test::report("pool_allocator");
+}
@@ -0,0 +1,145 @@
+/*
+// Алгебра множеств ft::set и ft::map: split, join, set_union, set_intersection,
+// set_difference на случайных множествах сверяются с std::set_* из <algorithm>.
+// Проверяются все политики узлов (обычная, order statistic, прошитая) и балансировки
+// (у AVL и splay алгебра поэлементная); после каждой операции -- verify() обоих деревьев.
+*/
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
+#include <vector>
+#include "map.hpp"
+#include "set.hpp"
+#include "test.hpp"
+
+typedef std::set<int>	reference_set;
+
+//↓↓↓ nth и rank есть только у order statistic: для остальных политик проверки нет
+template<typename Set>
+static bool ranks(const Set&, const reference_set&, ft::false_type) {
+	return true;
+}
+
+template<typename Set>
+static bool ranks(const Set& s, const reference_set& ref, ft::true_type) {
+	std::size_t k = 0;
+	for (reference_set::const_iterator i = ref.begin(); i != ref.end(); ++i, ++k) {
+		if (*s.nth(k) != *i || s.rank(*i) != k) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<typename Set>
+static void fill(test::Random& rnd, Set& s, reference_set& ref, int n, int range) {
+	for (int i = 0; i < n; ++i) {
+		int key = rnd.next_int(range);
+		s.insert(key);
+		ref.insert(key);
+	}
+}
+
+template<typename Set>
+static void test_random(unsigned long long seed) {
+	typedef typename Set::tree_type::order_statistic	order_statistic;
+	test::Random rnd(seed);
+	for (int round = 0; round < 300; ++round) {
+		Set a;
+		Set b;
+		reference_set ra;
+		reference_set rb;
+		int range = 1 + rnd.next_int(round % 3 == 0 ? 50 : 5000);
+		fill(rnd, a, ra, rnd.next_int(400), range);
+		fill(rnd, b, rb, rnd.next_int(400), range);
+		reference_set expected;
+		std::insert_iterator<reference_set> out(expected, expected.begin());
+		switch (rnd.next_int(5)) {
+			case 0: {
+				int key = rnd.next_int(range + 1);
+				a.split(key, b);
+				rb.clear();
+				rb.insert(ra.lower_bound(key), ra.end());
+				ra.erase(ra.lower_bound(key), ra.end());
+				CHECK(b.verify() && test::same(b, rb) && ranks(b, rb, order_statistic()));
+				expected = ra;
+				break;
+			}
+			case 1: {
+				//↓↓↓ join: все ключи b больше ключей a
+				int key = rnd.next_int(range + 1);
+				a.erase(a.lower_bound(key), a.end());
+				ra.erase(ra.lower_bound(key), ra.end());
+				b.erase(b.begin(), b.lower_bound(key));
+				rb.erase(rb.begin(), rb.lower_bound(key));
+				expected = ra;
+				expected.insert(rb.begin(), rb.end());
+				a.join(b);
+				CHECK(b.empty() && b.verify());
+				break;
+			}
+			case 2:
+				std::set_union(ra.begin(), ra.end(), rb.begin(), rb.end(), out);
+				a.set_union(b);
+				CHECK(b.empty() && b.verify());
+				break;
+			case 3:
+				std::set_intersection(ra.begin(), ra.end(), rb.begin(), rb.end(), out);
+				a.set_intersection(b);
+				CHECK(b.verify() && test::same(b, rb));
+				break;
+			default:
+				std::set_difference(ra.begin(), ra.end(), rb.begin(), rb.end(), out);
+				a.set_difference(b);
+				CHECK(b.verify() && test::same(b, rb));
+				break;
+		}
+		CHECK(a.verify() && test::same(a, expected) && ranks(a, expected, order_statistic()));
+		//↓↓↓ после операции дерево остается рабочим
+		for (int i = 0; i < 50; ++i) {
+			int key = rnd.next_int(range);
+			if (rnd.next_int(2)) {
+				a.insert(key);
+				expected.insert(key);
+			} else {
+				a.erase(key);
+				expected.erase(key);
+			}
+		}
+		CHECK(a.verify() && test::same(a, expected) && ranks(a, expected, order_statistic()));
+	}
+}
+
+//↓↓↓ при совпадении ключей у map остается значение *this, у аргумента -- только его элементы
+static void test_map_values() {
+	ft::map<int, int> a;
+	ft::map<int, int> b;
+	for (int i = 0; i < 100; ++i) {
+		a[i * 2] = 1;
+		b[i * 3] = 2;
+	}
+	ft::map<int, int> c(a);
+	a.set_union(b);
+	CHECK(a.verify() && a.size() == 100 + 100 - 34 && b.empty());
+	CHECK(a[6] == 1 && a[3] == 2 && a[4] == 1);
+	ft::map<int, int> d;
+	for (int i = 0; i < 300; i += 3) {
+		d[i] = 3;
+	}
+	c.set_intersection(d);
+	CHECK(c.verify() && c.size() == 34 && c[6] == 1);
+}
+
+int main() {
+	test_random<ft::set<int> >(1);
+	test_random<ft::set<int, std::less<int>, std::allocator<int>, ft::order_statistic_node_update> >(2);
+	test_random<ft::set<int, std::less<int>, std::allocator<int>, ft::threaded_node_update> >(3);
+	test_random<ft::set<int, std::less<int>, std::allocator<int>, ft::null_node_update, ft::avl_balance> >(4);
+	test_random<ft::set<int, std::less<int>, std::allocator<int>, ft::order_statistic_node_update, ft::avl_balance> >(5);
+	test_random<ft::set<int, std::less<int>, std::allocator<int>, ft::threaded_node_update, ft::splay_balance> >(6);
+	test_map_values();
+	return test::report("set_ops");
+}
@@ -0,0 +1,343 @@
+/*
+// Общие утилиты для тестов: проверка условия с местом ошибки, псевдослучайный
+// генератор и итог прогона; сверка контейнера с эталоном из std, случайные операции
+// над map-подобным контейнером и проверка копий с ft::pool_allocator.
+// Каждый тест -- отдельная программа, код возврата не ноль, если хотя бы одна
+// проверка не прошла.
+// Тесты собираются с ASan и UBSan и запускаются командой make test.
+*/
+
+#ifndef TEST_HPP
+# define TEST_HPP
+
+# include <cstdio>
+# include <map>
+# include "utils/pair.hpp"
+
+# define CHECK(cond) test::check((cond), #cond, __FILE__, __LINE__)
+
+namespace test {
+
+	inline int& failures() {
+		static int count = 0;
+		return count;
+	}
+
+	inline bool check(bool ok, const char* what, const char* file, int line) {
+		if (!ok) {
+			std::printf("%s:%d: CHECK(%s) failed\n", file, line, what);
+			std::fflush(stdout);
+			++failures();
+		}
+		return ok;
+	}
+
+	// xorshift, как в bench/bench.hpp: последовательность одна и та же на любой платформе
+	class Random {
+		private:
+			unsigned long long state_;
+
+		public:
+			explicit Random(unsigned long long seed = 88172645463325252ULL) : state_(seed ? seed : 1) {}
+
+			unsigned long long next() {
+				state_ ^= state_ << 13;
+				state_ ^= state_ >> 7;
+				state_ ^= state_ << 17;
+				return state_;
+			}
+
+			int next_int(int bound) { return static_cast<int>(next() % static_cast<unsigned long long>(bound)); }
+	};
+
+	//↓↓↓ значение, которое считает свои конструирования (по умолчанию и копированием)
+	// и присваивания: сколько раз контейнер строит и копирует mapped_type
+	struct counted {
+		int	value;
+
+		counted(): value(0) { ++constructed(); }
+		explicit counted(int v): value(v) { ++constructed(); }
+		counted(const counted& other): value(other.value) { ++constructed(); }
+
+		counted& operator=(const counted& other) {
+			value = other.value;
+			++assigned();
+			return *this;
+		}
+
+		static int& constructed() {
+			static int count = 0;
+			return count;
+		}
+
+		static int& assigned() {
+			static int count = 0;
+			return count;
+		}
+
+		static void reset() {
+			constructed() = 0;
+			assigned() = 0;
+		}
+	};
+
+	//↓↓↓ эталон для контейнеров <int, int>
+	typedef std::map<int, int>	reference_map;
+
+	//↓↓↓ элемент контейнера и элемент эталона: у map сравниваются ключ и значение, у set -- ключ
+	template<typename T, typename R>
+	bool same_element(const T& x, const R& r) { return x == r; }
+
+	template<typename K, typename V, typename RK, typename RV>
+	bool same_element(const ft::pair<K, V>& x, const std::pair<RK, RV>& r) {
+		return x.first == r.first && x.second == r.second;
+	}
+
+	template<typename K, typename V, typename RK, typename RV>
+	bool same_element(const ft::pair<K, V>& x, const ft::pair<RK, RV>& r) {
+		return x.first == r.first && x.second == r.second;
+	}
+
+	//↓↓↓ те же элементы в том же порядке в обе стороны; обход доходит ровно до end() и rend()
+	template<typename Container, typename Reference>
+	bool same(const Container& c, const Reference& ref) {
+		if (c.size() != ref.size() || c.empty() != ref.empty()) {
+			return false;
+		}
+		typename Container::const_iterator it = c.begin();
+		for (typename Reference::const_iterator r = ref.begin(); r != ref.end(); ++r, ++it) {
+			if (it == c.end() || !same_element(*it, *r)) {
+				return false;
+			}
+		}
+		if (it != c.end()) {
+			return false;
+		}
+		typename Container::const_reverse_iterator rit = c.rbegin();
+		for (typename Reference::const_reverse_iterator r = ref.rbegin(); r != ref.rend(); ++r, ++rit) {
+			if (rit == c.rend() || !same_element(*rit, *r)) {
+				return false;
+			}
+		}
+		return rit == c.rend();
+	}
+
+	//↓↓↓ итератор контейнера указывает на тот же ключ, что итератор эталона (или оба на end())
+	template<typename Map>
+	bool same_position(const Map& m, typename Map::const_iterator it, const reference_map& ref,
+			reference_map::const_iterator r) {
+		if (r == ref.end()) {
+			return it == m.end();
+		}
+		return it != m.end() && it->first == r->first;
+	}
+
+	//↓↓↓ шаги упорядоченного map: вставка с подсказкой (точной, begin(), end() или произвольной),
+	// удаление по итератору, lower/upper_bound и equal_range, изредка удаление диапазона.
+	// Удаление идет через Ops::erase_at и Ops::erase_range: они возвращают следующий итератор
+	template<typename Ops>
+	struct ordered_steps {
+		template<typename Map>
+		bool same(const Map& m, const reference_map& ref) const { return test::same(m, ref); }
+
+		template<typename Map>
+		bool valid(const Map&) const { return true; }
+
+		template<typename Map>
+		void step(Random& rnd, Map& m, reference_map& ref, int key, int range, int i) const {
+			switch (rnd.next_int(8)) {
+				case 0:
+				case 1:
+				case 2: {
+					typename Map::iterator hint = m.lower_bound(key);
+					int kind = rnd.next_int(4);
+					if (kind == 1) {
+						hint = m.begin();
+					} else if (kind == 2) {
+						hint = m.end();
+					} else if (kind == 3) {
+						hint = m.lower_bound(rnd.next_int(range));
+					}
+					typename Map::iterator r = m.insert(hint, ft::make_pair(key, i));
+					ref.insert(std::make_pair(key, i));
+					CHECK(r != m.end() && r->first == key && r->second == ref[key]);
+					break;
+				}
+				case 3:
+				case 4: {
+					typename Map::iterator it = m.find(key);
+					reference_map::iterator r = ref.find(key);
+					CHECK((it == m.end()) == (r == ref.end()));
+					if (r != ref.end() && it != m.end()) {
+						typename Map::iterator next = static_cast<const Ops&>(*this).erase_at(m, it);
+						ref.erase(r++);
+						CHECK(same_position(m, next, ref, r));
+					}
+					break;
+				}
+				case 5:
+				case 6: {
+					typename Map::iterator lb = m.lower_bound(key);
+					typename Map::iterator ub = m.upper_bound(key);
+					CHECK(same_position(m, lb, ref, ref.lower_bound(key)));
+					CHECK(same_position(m, ub, ref, ref.upper_bound(key)));
+					CHECK(m.equal_range(key).first == lb && m.equal_range(key).second == ub);
+					break;
+				}
+				default:
+					if (rnd.next_int(10) == 0) {
+						int low = rnd.next_int(range);
+						int high = low + rnd.next_int(range - low + 1);
+						typename Map::iterator r = static_cast<const Ops&>(*this).erase_range(m, m.lower_bound(low), m.lower_bound(high));
+						ref.erase(ref.lower_bound(low), ref.lower_bound(high));
+						CHECK(same_position(m, r, ref, ref.lower_bound(high)));
+					}
+					break;
+			}
+		}
+	};
+
+	//↓↓↓ btree и flat: erase возвращает следующий итератор. Тесты контейнеров наследуют
+	// ordered_ops и добавляют свои шаги
+	struct ordered_ops : ordered_steps<ordered_ops> {
+		template<typename Map>
+		typename Map::iterator erase_at(Map& m, typename Map::iterator it) const { return m.erase(it); }
+
+		template<typename Map>
+		typename Map::iterator erase_range(Map& m, typename Map::iterator first, typename Map::iterator last) const {
+			return m.erase(first, last);
+		}
+	};
+
+	//↓↓↓ ft::map и ft::set: erase, как в C++98, ничего не возвращает, остальные итераторы
+	// остаются валидными; после каждого шага -- инварианты дерева (verify)
+	struct tree_ops : ordered_steps<tree_ops> {
+		template<typename Map>
+		bool valid(const Map& m) const { return m.verify(); }
+
+		template<typename Map>
+		typename Map::iterator erase_at(Map& m, typename Map::iterator it) const {
+			typename Map::iterator next = it;
+			++next;
+			m.erase(it);
+			return next;
+		}
+
+		template<typename Map>
+		typename Map::iterator erase_range(Map& m, typename Map::iterator first, typename Map::iterator last) const {
+			m.erase(first, last);
+			return last;
+		}
+	};
+
+	//↓↓↓ count случайных операций с ключами из [0, range) сверяются с эталоном. Общие для всех
+	// map шаги -- insert, operator[], erase по ключу, find и count; остальные делает Ops::step.
+	// После каждого шага Ops::valid проверяет инварианты контейнера
+	template<typename Map, typename Ops>
+	void random_ops(Random& rnd, Map& m, reference_map& ref, int range, int count, const Ops& ops) {
+		for (int i = 0; i < count; ++i) {
+			int key = rnd.next_int(range);
+			switch (rnd.next_int(10)) {
+				case 0:
+				case 1:
+				case 2: {
+					ft::pair<typename Map::iterator, bool> r = m.insert(ft::make_pair(key, i));
+					CHECK(r.second == ref.insert(std::make_pair(key, i)).second);
+					CHECK(r.first->first == key && r.first->second == ref[key]);
+					break;
+				}
+				case 3:
+					m[key] = i;
+					ref[key] = i;
+					break;
+				case 4:
+				case 5:
+					CHECK(m.erase(key) == ref.erase(key));
+					break;
+				case 6: {
+					typename Map::iterator it = m.find(key);
+					reference_map::iterator r = ref.find(key);
+					CHECK((it == m.end()) == (r == ref.end()) && m.count(key) == ref.count(key));
+					CHECK(r == ref.end() || (it != m.end() && it->second == r->second));
+					break;
+				}
+				default:
+					ops.step(rnd, m, ref, key, range, i);
+					break;
+			}
+			CHECK(ops.valid(m));
+		}
+	}
+
+	//↓↓↓ копия, присваивание поверх непустого контейнера, clear и swap не теряют и не делят элементы
+	template<typename Map, typename Ops>
+	void check_copies(const Map& m, const reference_map& ref, const Ops& ops) {
+		Map copy(m);
+		Map assigned;
+		assigned[-1] = -1;
+		assigned = copy;
+		CHECK(ops.same(copy, ref) && ops.same(assigned, ref) && assigned == m);
+		CHECK(ops.valid(copy) && ops.valid(assigned));
+		copy.clear();
+		CHECK(copy.empty() && copy.begin() == copy.end() && ops.valid(copy));
+		copy[-1] = -1;
+		assigned.swap(copy);
+		CHECK(assigned.size() == 1 && assigned.begin()->first == -1 && ops.same(copy, ref));
+	}
+
+	//↓↓↓ rounds раундов: пустой Map, до max_ops случайных операций с ключами до max_range,
+	// затем сверка с эталоном и проверка копий
+	template<typename Map, typename Ops>
+	void random_rounds(unsigned long long seed, int rounds, int max_range, int max_ops, const Ops& ops) {
+		Random rnd(seed);
+		for (int round = 0; round < rounds; ++round) {
+			Map m;
+			reference_map ref;
+			random_ops(rnd, m, ref, 1 + rnd.next_int(max_range), rnd.next_int(max_ops), ops);
+			CHECK(ops.same(m, ref) && ops.valid(m));
+			check_copies(m, ref, ops);
+		}
+	}
+
+	//↓↓↓ Map с ft::pool_allocator: копия и присвоенный контейнер делят пул с источником, swap
+	// меняет аллокаторы местами -- каждый узел освобождается тем пулом, который его выделил
+	template<typename Map>
+	void pool_copies() {
+		Map a;
+		for (int i = 0; i < 1000; ++i) {
+			a.insert(a.end(), ft::make_pair(i, i));
+		}
+		Map b;
+		b[-1] = -1;
+		b = a;
+		for (int i = 0; i < 1000; ++i) {
+			b[i + 5000] = i;
+		}
+		Map c(b);
+		{
+			Map d;
+			d[7] = 7;
+			d.swap(c);
+			c[8] = 8;
+		}
+		c.insert(ft::make_pair(9, 9));
+		a.clear();
+		for (int i = 0; i < 100; ++i) {
+			a.insert(a.end(), ft::make_pair(i, i));
+		}
+		CHECK(a.size() == 100 && b.size() == 2000 && c.size() == 3 && b.get_allocator() == a.get_allocator());
+		int sum = 0;
+		for (typename Map::iterator it = b.begin(); it != b.end(); ++it) {
+			sum += it->second;
+		}
+		CHECK(sum == 2 * (999 * 1000 / 2));
+	}
+
+	inline int report(const char* name) {
+		std::printf("%-24s %s\n", name, failures() ? "FAIL" : "OK");
+		return failures() != 0;
+	}
+
+} // namespace test
+
+#endif
@@ -0,0 +1,217 @@
+/*
+// ft::unordered_map и ft::unordered_set: вставка (с подсказкой и без), operator[],
+// удаление по ключу, итератору и диапазону сверяются с std::map; обход посещает каждый
+// элемент ровно один раз; удаление во время обхода; rehash, reserve и рост таблицы не
+// теряют элементы; плохой хеш (много совпадений); копирование и swap с ft::pool_allocator.
+// operator[] и try_emplace конструируют значение один раз прямо в ячейке, значение другого
+// элемента переживает рост таблицы.
+*/
+
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include "unordered_map.hpp"
+#include "unordered_set.hpp"
+#include "utils/pool_allocator.hpp"
+#include "test.hpp"
+
+typedef ft::unordered_map<int, int, ft::hash<int>, std::equal_to<int>, ft::pool_allocator<ft::pair<const int, int> > >	pool_map;
+
+//↓↓↓ три значения хеша на все ключи: длинные цепочки проб и переполненные группы
+struct bad_hash {
+	std::size_t operator()(int x) const { return static_cast<std::size_t>(x % 3); }
+};
+
+//↓↓↓ порядка нет: каждый элемент эталона находится, обход посещает каждый элемент ровно один раз
+template<typename Map, typename Reference>
+static bool same_unordered(const Map& m, const Reference& ref) {
+	if (m.size() != ref.size() || m.empty() != ref.empty()) {
+		return false;
+	}
+	std::size_t n = 0;
+	std::set<int> seen;
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it, ++n) {
+		typename Reference::const_iterator r = ref.find(it->first);
+		if (r == ref.end() || r->second != it->second || !seen.insert(it->first).second) {
+			return false;
+		}
+	}
+	for (typename Reference::const_iterator r = ref.begin(); r != ref.end(); ++r) {
+		typename Map::const_iterator it = m.find(r->first);
+		if (it == m.end() || it->second != r->second || m.count(r->first) != 1) {
+			return false;
+		}
+	}
+	return n == ref.size();
+}
+
+//↓↓↓ к общим шагам map: вставка с подсказкой (подсказка не используется), удаление по итератору,
+// equal_range и изредка rehash; после каждого шага загрузка не выше max_load_factor()
+struct unordered_ops {
+	template<typename Map>
+	bool same(const Map& m, const test::reference_map& ref) const { return same_unordered(m, ref); }
+
+	template<typename Map>
+	bool valid(const Map& m) const { return m.bucket_count() == 0 || m.load_factor() <= m.max_load_factor(); }
+
+	template<typename Map>
+	void step(test::Random& rnd, Map& m, test::reference_map& ref, int key, int, int i) const {
+		int op = rnd.next_int(4);
+		if (op == 0) {
+			typename Map::iterator r = m.insert(m.begin(), ft::make_pair(key, i));
+			ref.insert(std::make_pair(key, i));
+			CHECK(r->first == key && r->second == ref[key]);
+		} else if (op == 1) {
+			typename Map::iterator it = m.find(key);
+			CHECK((it == m.end()) == (ref.count(key) == 0));
+			if (it != m.end()) {
+				m.erase(it);
+				ref.erase(key);
+			}
+		} else if (op == 2) {
+			ft::pair<typename Map::iterator, typename Map::iterator> r = m.equal_range(key);
+			CHECK(ref.count(key) ? (r.first->first == key && ++r.first == r.second) : r.first == m.end());
+		} else if (rnd.next_int(15) == 0) {
+			m.rehash(rnd.next_int(4) * m.bucket_count());
+		}
+	}
+};
+
+//↓↓↓ erase(it) возвращает следующий элемент: удаление каждого второго и всех нечетных
+// за один проход, остальные итераторы не портятся
+static void test_erase_while_iterating() {
+	ft::unordered_map<int, int> m;
+	test::reference_map ref;
+	for (int i = 0; i < 5000; ++i) {
+		m[i * 7] = i;
+		ref[i * 7] = i;
+	}
+	for (ft::unordered_map<int, int>::iterator it = m.begin(); it != m.end(); ) {
+		if (it->second % 2) {
+			ref.erase(it->first);
+			it = m.erase(it);
+		} else {
+			++it;
+		}
+	}
+	CHECK(same_unordered(m, ref) && m.size() == 2500);
+	ft::unordered_map<int, int>::iterator first = m.begin();
+	for (int i = 0; i < 100; ++i) {
+		++first;
+	}
+	ft::unordered_map<int, int>::iterator kept = first;
+	int kept_key = kept->first;
+	for (ft::unordered_map<int, int>::iterator it = m.begin(); it != first; ) {
+		ref.erase(it->first);
+		it = m.erase(it);
+	}
+	CHECK(kept->first == kept_key && same_unordered(m, ref));
+	m.erase(m.begin(), m.end());
+	CHECK(m.empty() && m.begin() == m.end());
+}
+
+static void test_rehash() {
+	ft::unordered_map<int, int> m;
+	test::reference_map ref;
+	for (int i = 0; i < 10000; ++i) {
+		m[i * 31] = i;
+		ref[i * 31] = i;
+		if (i % 1000 == 0) {
+			CHECK(m.load_factor() <= m.max_load_factor());
+		}
+	}
+	std::size_t buckets = m.bucket_count();
+	m.rehash(buckets * 4);
+	CHECK(m.bucket_count() >= buckets * 4 && same_unordered(m, ref));
+	m.rehash(0);
+	CHECK(m.bucket_count() < buckets * 4 && same_unordered(m, ref));
+	m.reserve(50000);
+	buckets = m.bucket_count();
+	for (int i = 10000; i < 50000; ++i) {
+		m[i * 31] = i;
+		ref[i * 31] = i;
+	}
+	CHECK(m.bucket_count() == buckets && same_unordered(m, ref));
+	m.clear();
+	m.rehash(0);
+	CHECK(m.bucket_count() == 0 && m.empty() && m.find(31) == m.end());
+	m[31] = 1;
+	CHECK(m.size() == 1 && m[31] == 1);
+}
+
+//↓↓↓ при промахе mapped_type конструируется один раз; рост таблицы копирует старые элементы
+static void test_emplace() {
+	ft::unordered_map<int, test::counted> m;
+	test::counted seven(7);
+	for (int key = 0; key < 3000; ++key) {
+		std::size_t buckets = m.bucket_count();
+		int moved = static_cast<int>(m.size());
+		test::counted::reset();
+		if (key % 2 == 0) {
+			CHECK(m[key].value == 0);
+		} else {
+			CHECK(m.try_emplace(key, seven).first->second.value == 7);
+		}
+		CHECK(test::counted::constructed() == (m.bucket_count() == buckets ? 1 : 1 + moved));
+		CHECK(test::counted::assigned() == 0);
+	}
+	test::counted::reset();
+	for (int key = 0; key < 3000; ++key) {
+		m[key].value += 1;
+		CHECK(!m.try_emplace(key, seven).second && !m.try_emplace(key).second);
+	}
+	CHECK(test::counted::constructed() == 0 && test::counted::assigned() == 0);
+	CHECK(m[10].value == 1 && m[11].value == 8);
+}
+
+//↓↓↓ try_emplace(k, m[other]): other лежит в той же таблице, вставка k ее перестраивает
+static void test_emplace_aliasing() {
+	ft::unordered_map<int, std::string> m;
+	std::map<int, std::string> ref;
+	test::Random rnd(24);
+	m[0] = "value of the first element, long enough for the heap";
+	ref[0] = m[0];
+	for (int key = 1; key < 5000; ++key) {
+		int other = rnd.next_int(key);
+		CHECK(m.try_emplace(key, m[other]).second);
+		ref[key] = ref[other];
+	}
+	CHECK(same_unordered(m, ref));
+}
+
+static void test_set() {
+	test::Random rnd(9);
+	ft::unordered_set<std::string> s;
+	std::set<std::string> ref;
+	char key[32];
+	for (int i = 0; i < 20000; ++i) {
+		std::sprintf(key, "key_%d_long_enough_for_heap", rnd.next_int(3000));
+		if (rnd.next_int(3)) {
+			CHECK(s.insert(key).second == ref.insert(key).second);
+		} else {
+			CHECK(s.erase(key) == ref.erase(key));
+		}
+	}
+	CHECK(s.size() == ref.size());
+	std::size_t n = 0;
+	for (ft::unordered_set<std::string>::iterator it = s.begin(); it != s.end(); ++it, ++n) {
+		CHECK(ref.count(*it) == 1);
+	}
+	CHECK(n == ref.size());
+}
+
+int main() {
+	test::random_rounds<ft::unordered_map<int, int> >(1, 30, 5000, 6000, unordered_ops());
+	test::random_rounds<ft::unordered_map<int, int> >(2, 30, 50, 6000, unordered_ops());
+	test::random_rounds<ft::unordered_map<int, int, bad_hash> >(3, 30, 500, 6000, unordered_ops());
+	test::random_rounds<pool_map>(4, 30, 3000, 6000, unordered_ops());
+	test_erase_while_iterating();
+	test_rehash();
+	test_emplace();
+	test_emplace_aliasing();
+	test_set();
+	test::pool_copies<pool_map>();
+	return test::report("unordered");
+}